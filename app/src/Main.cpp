@@ -47,6 +47,8 @@ int main(int argc, char* argv[])
 #ifndef SQP_NO_PLUGINS
     Q_IMPORT_PLUGIN(PythonProviders)
     Q_INIT_RESOURCE(python_providers);
+    Q_IMPORT_PLUGIN(AmdaPlugin)
+    Q_INIT_RESOURCE(amdaresources);
 #endif
 #endif
     Q_INIT_RESOURCE(sqpguiresources);
@@ -1,8 +1,16 @@
 #ifndef SCIQLOP_VISUALIZATIONDEF_H
 #define SCIQLOP_VISUALIZATIONDEF_H
 
+#include <QString>
+
 /// Minimum height for graph added in zones (in pixels)
 extern const int GRAPH_MINIMUM_HEIGHT;
 
+/// Names of the layers of the plots on which interactive items are drawn. These layers are
+/// buffered: they can be repainted without replotting the plottables
+extern const QString SELECTION_ZONES_LAYER;
+extern const QString TRACER_LAYER;
+extern const QString CURSORS_LAYER;
+
 
 #endif // SCIQLOP_VISUALIZATIONDEF_H
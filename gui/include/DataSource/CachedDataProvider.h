@@ -0,0 +1,54 @@
+#ifndef SCIQLOP_CACHEDDATAPROVIDER_H
+#define SCIQLOP_CACHEDDATAPROVIDER_H
+
+#include <Data/DateTimeRange.h>
+#include <Data/IDataProvider.h>
+
+#include <QLoggingCategory>
+#include <QVariantHash>
+
+#include <memory>
+#include <vector>
+
+Q_DECLARE_LOGGING_CATEGORY(LOG_CachedDataProvider)
+
+/**
+ * @brief The CachedDataProvider class is a data provider that serves data from the application
+ * caches, in memory then on disk, and asks the provider it wraps only for the parts of the range
+ * that are in none of them. If the provider fails on some of these parts, the data of the others
+ * is still returned.
+ *
+ * Plugins wrap their provider in a CachedDataProvider when registering it. The id identifies the
+ * provider in the cache: it must be the same for all the clones of the provider and differ between
+ * providers.
+ *
+ * @sa TimeSeriesCache
+ * @sa TimeSeriesDiskCache
+ */
+class CachedDataProvider : public IDataProvider
+{
+public:
+    explicit CachedDataProvider(const QString& providerId, std::shared_ptr<IDataProvider> provider);
+
+    /**
+     * Fetches the data of products over ranges into the caches, in the background and after the
+     * requests of the variables, so that it is served from the caches when it is displayed.
+     * Products are fetched by the provider that served them: nothing is fetched for a product that
+     * hasn't been served yet. The prefetches of the previous call that haven't started are
+     * dropped
+     * @param products the metadata of the products
+     * @param ranges the ranges to fetch, in the order they are fetched
+     */
+    static void prefetch(
+        const std::vector<QVariantHash>& products, const std::vector<DateTimeRange>& ranges);
+
+    std::shared_ptr<IDataProvider> clone() const override;
+
+    TimeSeries::ITimeSerie* getData(const DataProviderParameters& parameters) override;
+
+private:
+    QString m_ProviderId;
+    std::shared_ptr<IDataProvider> m_Provider;
+};
+
+#endif // SCIQLOP_CACHEDDATAPROVIDER_H
@@ -0,0 +1,49 @@
+#ifndef SCIQLOP_DATAGAPS_H
+#define SCIQLOP_DATAGAPS_H
+
+#include <limits>
+#include <vector>
+
+/**
+ * @brief The DataGaps struct represents the intervals without data of a serie, as a sorted list of
+ * segments, instead of lines of fill values inserted in the serie.
+ *
+ * A gap is the interval between two successive times of the serie that are farther apart than the
+ * resolution of the serie, or between a bound of the range of the serie and its closest time.
+ * Gaps are found in a single pass over the times, and their number only depends on how often the
+ * data stops, not on their duration.
+ *
+ * @sa SpectrogramRasterizer
+ */
+struct DataGaps
+{
+    /// Interval without data, in seconds since epoch. The bounds are the times of the data around
+    /// the gap, or a bound of the range of the serie
+    struct Gap
+    {
+        double m_TStart;
+        double m_TEnd;
+    };
+
+    /**
+     * Finds the gaps of a serie
+     * @param xAxis the times of the serie, sorted
+     * @param resolution the max interval between two successive times that isn't a gap
+     * @param minBound the start of the range of the serie, NaN to ignore the gap before the first
+     * time
+     * @param maxBound the end of the range of the serie, NaN to ignore the gap after the last time
+     * @return the gaps found. There is none if the resolution is undefined
+     */
+    static DataGaps find(const std::vector<double>& xAxis, double resolution,
+        double minBound = std::numeric_limits<double>::quiet_NaN(),
+        double maxBound = std::numeric_limits<double>::quiet_NaN());
+
+    /// @return true if a time is strictly inside a gap
+    bool contains(double time) const noexcept;
+
+    bool empty() const noexcept { return m_Gaps.empty(); }
+
+    std::vector<Gap> m_Gaps {};
+};
+
+#endif // SCIQLOP_DATAGAPS_H
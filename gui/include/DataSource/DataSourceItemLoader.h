@@ -0,0 +1,62 @@
+#ifndef SCIQLOP_DATASOURCEITEMLOADER_H
+#define SCIQLOP_DATASOURCEITEMLOADER_H
+
+#include <QString>
+#include <QVariant>
+
+#include <functional>
+#include <memory>
+
+class DataSourceItem;
+
+/**
+ * @brief The DataSourceItemLoader class creates on demand the items of a data source tree, so that
+ * large trees don't have to be created up front.
+ *
+ * A loader gives to the items it creates the name under which it is registered and the identifier
+ * of their node. The children of an item are created when it is expanded in the data source
+ * widget, and the items matching the filter of the widget are created when it changes. Items
+ * created by a loader can be merged and cloned as any other item, as the loader only relies on
+ * their data to find their node.
+ *
+ * @sa DataSourceWidget
+ */
+class DataSourceItemLoader
+{
+public:
+    /// Function telling if a value of the data of an item validates a filter
+    using FilterFunction = std::function<bool(const QVariant& value)>;
+
+    /// Key of the data holding the name of the loader of an item
+    static const QString LOADER_DATA_KEY;
+    /// Key of the data holding the identifier of the node of an item, for its loader
+    static const QString NODE_DATA_KEY;
+
+    virtual ~DataSourceItemLoader() noexcept = default;
+
+    /// @return true if some children of the item haven't been created yet
+    virtual bool canLoadChildren(const DataSourceItem& item) const = 0;
+
+    /// Creates the children of the item that haven't been created yet
+    virtual void loadChildren(DataSourceItem& item) = 0;
+
+    /**
+     * Creates the descendants of an item that have a value of data validating a filter, and the
+     * items between them and the item. Items already created are kept
+     * @param maxCount the maximum number of matching descendants to create, so that a filter
+     * matching a large part of the tree doesn't create it all
+     */
+    virtual void loadMatchingItems(DataSourceItem& item, const FilterFunction& filter,
+        int maxCount) = 0;
+
+    /// Registers a loader under a name. A loader registered under the same name is replaced
+    static void registerLoader(const QString& name, std::shared_ptr<DataSourceItemLoader> loader);
+
+    /// @return the loader of an item, nullptr if the item wasn't created by a registered loader
+    static std::shared_ptr<DataSourceItemLoader> loader(const DataSourceItem& item);
+
+    /// @return true if a key of the data of an item is used by loaders and isn't product metadata
+    static bool isLoaderDataKey(const QString& key) noexcept;
+};
+
+#endif // SCIQLOP_DATASOURCEITEMLOADER_H
@@ -10,6 +10,8 @@ class DataSourceWidget;
 } // Ui
 
 class DataSourceItem;
+class QTimer;
+class QTreeWidgetItem;
 
 /**
  * @brief The DataSourceWidget handles the graphical representation (as a tree) of the data sources
@@ -33,13 +35,22 @@ public slots:
 private:
     void updateTreeWidget() noexcept;
 
+    /// Hides the items of the tree that don't validate the filtering text
+    void applyFilter() noexcept;
+
     Ui::DataSourceWidget *ui;
     std::unique_ptr<DataSourceItem> m_Root;
+    /// Timer delaying the filtering of the tree while the filtering text is typed
+    QTimer *m_FilterTimer;
 
 private slots:
-    /// Slot called when the filtering text has changed
+    /// Slot called when the filtering text has stopped changing
     void filterChanged(const QString &text) noexcept;
 
+    /// Slot called when an item of the tree is expanded, to create its children if they are
+    /// created on demand
+    void onItemExpanded(QTreeWidgetItem *item) noexcept;
+
     /// Slot called when right clicking on an item in the tree (displays a menu)
     void onTreeMenuRequested(const QPoint &pos) noexcept;
 };
@@ -0,0 +1,98 @@
+#ifndef SCIQLOP_TIMESERIESCACHE_H
+#define SCIQLOP_TIMESERIESCACHE_H
+
+#include <Common/spimpl.h>
+
+#include <Data/DateTimeRange.h>
+
+#include <QLoggingCategory>
+#include <QVariantHash>
+
+#include <memory>
+#include <vector>
+
+namespace TimeSeries
+{
+class ITimeSerie;
+}
+
+Q_DECLARE_LOGGING_CATEGORY(LOG_TimeSeriesCache)
+
+/**
+ * @brief The TimeSeriesCache class keeps the data fetched from the providers, so that a product
+ * displayed by several variables, or loaded again, is not fetched and parsed again.
+ *
+ * Data is stored per product, identified by the provider and the metadata of the product, as
+ * slices covering a range. Slices are stored as they are fetched, without being merged: the ranges
+ * of the slices of a product don't overlap, and any range covered by contiguous slices can be
+ * served without calling the provider.
+ *
+ * The memory used by the slices is bounded by a budget: when it is exceeded, the least recently
+ * used slices are evicted. A slice larger than the budget isn't stored. A null budget disables the
+ * cache.
+ *
+ * Scalar, vector and spectrogram series are stored. The cache is thread safe, as providers are
+ * called from worker threads.
+ *
+ * @note The cache is accessible from the sqpApp singleton and has the same life as the whole
+ * application
+ * @sa CachedDataProvider
+ * @see SqpApplication
+ */
+class TimeSeriesCache
+{
+public:
+    /// Data of a product over a range
+    struct Slice
+    {
+        DateTimeRange m_Range;
+        std::shared_ptr<TimeSeries::ITimeSerie> m_Data;
+    };
+
+    /// Result of a lookup: the slices intersecting the range looked up, and the parts of the range
+    /// they don't cover
+    struct Lookup
+    {
+        std::vector<Slice> m_Slices;
+        std::vector<DateTimeRange> m_MissingRanges;
+    };
+
+    TimeSeriesCache();
+
+    /// Returns the key identifying a product in the cache
+    static QString key(const QString& providerId, const QVariantHash& metaData);
+
+    /// Returns true if the data of a serie can be stored in the cache
+    static bool isCacheable(const TimeSeries::ITimeSerie& serie) noexcept;
+
+    /**
+     * Merges slices of a product in a new serie, restricted to a range
+     * @param slices the slices to merge. They must be of the same type and cover the range
+     * @return the merged serie, owned by the caller, or nullptr if the slices can't be merged
+     */
+    static TimeSeries::ITimeSerie* merge(std::vector<Slice> slices, const DateTimeRange& range);
+
+    /// Returns true if the cache stores data, i.e. if its budget isn't null
+    bool isEnabled() const noexcept;
+
+    /// Looks up the data of a product over a range
+    Lookup lookup(const QString& key, const DateTimeRange& range);
+
+    /// Stores a slice of a product. The slice replaces the slices of the product that it covers,
+    /// and only covers what the slices it overlaps partially don't. Its data isn't copied
+    void insert(const QString& key, const Slice& slice);
+
+    /// Returns the memory budget of the cache, in bytes
+    std::size_t memoryBudget() const noexcept;
+    /// Sets the memory budget of the cache, in bytes. Slices are evicted if it is exceeded
+    void setMemoryBudget(std::size_t memoryBudget);
+
+    /// Removes all the data stored
+    void clear();
+
+private:
+    class TimeSeriesCachePrivate;
+    spimpl::unique_impl_ptr<TimeSeriesCachePrivate> impl;
+};
+
+#endif // SCIQLOP_TIMESERIESCACHE_H
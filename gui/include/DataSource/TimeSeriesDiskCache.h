@@ -0,0 +1,69 @@
+#ifndef SCIQLOP_TIMESERIESDISKCACHE_H
+#define SCIQLOP_TIMESERIESDISKCACHE_H
+
+#include "DataSource/TimeSeriesCache.h"
+
+#include <Common/spimpl.h>
+
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(LOG_TimeSeriesDiskCache)
+
+/**
+ * @brief The TimeSeriesDiskCache class keeps the data fetched from the providers on disk, so that
+ * it is available from one session to another, without network access.
+ *
+ * Each slice of a product is written in its own file, in a columnar layout that is read by
+ * mapping the file in memory:
+ * - a header (magic, type of serie, values per sample, number of samples, range of the slice)
+ * - the time axis, as doubles
+ * - the values, as doubles, sample after sample
+ * - for spectrograms, the y-axis, as doubles
+ *
+ * Slices are indexed by product (same key as TimeSeriesCache) and range in an index file stored
+ * in the cache directory. New slices are appended to a journal of the index, which is merged in
+ * the index file once it grows; last uses are only written with the index. Slice files missing
+ * from the index are removed when it is read. A new slice replaces the slices of its product that
+ * its range covers. When the size of the files exceeds the disk budget, the least recently used
+ * slices are removed. A null budget disables the cache.
+ *
+ * As TimeSeriesCache, scalar, vector and spectrogram series are stored, empty results aren't, and
+ * the cache is thread safe. Slice files are read and written without blocking the other threads.
+ *
+ * @note The cache is accessible from the sqpApp singleton and has the same life as the whole
+ * application
+ * @sa CachedDataProvider
+ * @see SqpApplication
+ */
+class TimeSeriesDiskCache
+{
+public:
+    /// Creates a cache storing its files in @p directory, created if needed
+    explicit TimeSeriesDiskCache(const QString& directory = defaultDirectory());
+
+    /// Returns the directory of the cache of the application
+    static QString defaultDirectory();
+
+    /// Returns true if the cache stores data, i.e. if its budget isn't null
+    bool isEnabled() const noexcept;
+
+    /// Reads the slices of a product intersecting a range. The slices are read from the disk
+    TimeSeriesCache::Lookup lookup(const QString& key, const DateTimeRange& range);
+
+    /// Writes a slice of a product to the disk
+    void insert(const QString& key, const TimeSeriesCache::Slice& slice);
+
+    /// Returns the disk budget of the cache, in bytes
+    std::size_t diskBudget() const noexcept;
+    /// Sets the disk budget of the cache, in bytes. Slices are removed if it is exceeded
+    void setDiskBudget(std::size_t diskBudget);
+
+    /// Removes all the files of the cache
+    void clear();
+
+private:
+    class TimeSeriesDiskCachePrivate;
+    spimpl::unique_impl_ptr<TimeSeriesDiskCachePrivate> impl;
+};
+
+#endif // SCIQLOP_TIMESERIESDISKCACHE_H
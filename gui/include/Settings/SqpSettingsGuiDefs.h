@@ -0,0 +1,29 @@
+#ifndef SCIQLOP_SQPSETTINGSGUIDEFS_H
+#define SCIQLOP_SQPSETTINGSGUIDEFS_H
+
+#include <QString>
+
+// ////////////////////// //
+// Visualization settings //
+// ////////////////////// //
+
+/// Time budget of a replot frame, in ms
+/// @sa ReplotScheduler
+extern const QString VISUALIZATION_FRAME_BUDGET_KEY;
+extern const int VISUALIZATION_FRAME_BUDGET_DEFAULT_VALUE;
+
+// /////////////////// //
+// Data cache settings //
+// /////////////////// //
+
+/// Memory budget of the data cache, in MB
+/// @sa TimeSeriesCache
+extern const QString DATA_CACHE_MEMORY_BUDGET_KEY;
+extern const int DATA_CACHE_MEMORY_BUDGET_DEFAULT_VALUE;
+
+/// Disk budget of the data cache, in MB
+/// @sa TimeSeriesDiskCache
+extern const QString DATA_CACHE_DISK_BUDGET_KEY;
+extern const int DATA_CACHE_DISK_BUDGET_DEFAULT_VALUE;
+
+#endif // SCIQLOP_SQPSETTINGSGUIDEFS_H
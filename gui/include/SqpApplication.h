@@ -29,6 +29,10 @@ class VariableController2;
 class VariableModel2;
 class DragDropGuiController;
 class ActionsGuiController;
+class RangeChangeBroadcaster;
+class ReplotScheduler;
+class TimeSeriesCache;
+class TimeSeriesDiskCache;
 class CatalogueController;
 
 /* stolen from here https://forum.qt.io/topic/90403/show-tooltip-immediatly/6 */
@@ -81,6 +85,10 @@ public:
     /// doesn't live in a thread and access gui
     DragDropGuiController& dragDropGuiController() noexcept;
     ActionsGuiController& actionsGuiController() noexcept;
+    ReplotScheduler& replotScheduler() noexcept;
+    RangeChangeBroadcaster& rangeChangeBroadcaster() noexcept;
+    TimeSeriesCache& timeSeriesCache() noexcept;
+    TimeSeriesDiskCache& timeSeriesDiskCache() noexcept;
 
     enum class PlotsInteractionMode
     {
@@ -0,0 +1,93 @@
+#ifndef SCIQLOP_GRAPHDATAPYRAMID_H
+#define SCIQLOP_GRAPHDATAPYRAMID_H
+
+#include "Visualization/TimeSeriesGraph.h"
+
+#include <vector>
+
+/**
+ * @brief The GraphDataPyramid class holds the levels of detail of a graph component, so that
+ * drawing a zoomed out view costs in proportion to the width of the screen rather than to the
+ * size of the data.
+ *
+ * Each level reduces the previous one (the raw samples for the first level) by LEVEL_FACTOR:
+ * samples are gathered in buckets, of which only the min and max samples are kept, in time order.
+ * A bucket that only contains NaN values keeps a single NaN sample so that data holes remain
+ * visible.
+ *
+ * Levels only hold complete buckets: the most recent samples, that don't fill a bucket yet, are
+ * only in the raw data. This allows a pyramid to be extended when samples are appended to its data
+ * (streaming), by reducing only the new samples.
+ *
+ * A pyramid is immutable: it is built from the data of a variable and is replaced when this data
+ * changes.
+ */
+class GraphDataPyramid
+{
+public:
+    /// Number of buckets of a level gathered in a bucket of the next level
+    static const std::size_t LEVEL_FACTOR = 8;
+
+    /// Returns true if data of @p size samples are big enough to need levels of detail
+    static bool isNeeded(std::size_t size) noexcept;
+
+    explicit GraphDataPyramid(TimeSeriesGraphData data);
+
+    /**
+     * Builds the pyramid of new data of the component, if these data only differ from the data of
+     * the pyramid by samples appended at their end and by samples removed at their beginning.
+     * Only the appended samples are reduced: the buffers of the levels are shared with this pyramid
+     * and extended in place when possible.
+     *
+     * Samples before @p windowStart are dropped from the data and the levels, so that the cost of
+     * the pyramid stays bounded for a live feed. The result is the same as the pyramid built from
+     * scratch on the data sliced the same way.
+     *
+     * @return the new pyramid, or nullptr if @p data isn't an extension of the data of the pyramid:
+     * the data of @p data in the window must not start before the data of the pyramid, and must
+     * contain the last sample of the pyramid (samples already in the pyramid are assumed unchanged
+     * if their last key and value match)
+     */
+    std::shared_ptr<const GraphDataPyramid> append(
+        const TimeSeriesGraphData& data, double windowStart) const;
+
+    /// Returns the raw data from which the pyramid is built
+    const TimeSeriesGraphData& data() const noexcept;
+
+    /// Returns true if the pyramid has been built from @p data (i.e. it reads the same buffers)
+    bool isBuiltFrom(const TimeSeriesGraphData& data) const noexcept;
+
+    /**
+     * Returns the coarsest level that still gives at least one bucket per pixel column, over a key
+     * range displayed on @p pixels columns. Returns the raw data if no level is fine enough
+     */
+    TimeSeriesGraphData level(const QCPRange& keyRange, int pixels) const noexcept;
+
+    /// Returns the number of levels, raw data excluded
+    std::size_t levelCount() const noexcept;
+
+private:
+    struct LevelBuffers;
+
+    struct Level
+    {
+        /// Buffers, that can be shared between the pyramids of successive data of a component
+        std::shared_ptr<LevelBuffers> m_Buffers;
+        /// Samples of the level in the buffers
+        TimeSeriesGraphData m_Data;
+        /// Key of the last sample of the source (previous level or raw data) that has been reduced
+        double m_LastReducedKey;
+    };
+
+    /// Reduces the samples of @p source that aren't in @p level yet
+    static void extend(Level& level, const TimeSeriesGraphData& source, std::size_t bucketSize);
+
+    /// Extends the levels with the raw data, and adds the levels that are now needed
+    void update();
+
+    TimeSeriesGraphData m_Data;
+    /// Levels, from the finest to the coarsest
+    std::vector<Level> m_Levels;
+};
+
+#endif // SCIQLOP_GRAPHDATAPYRAMID_H
@@ -0,0 +1,134 @@
+#ifndef SCIQLOP_GRAPHDECIMATION_H
+#define SCIQLOP_GRAPHDECIMATION_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+/**
+ * Decimation of line graphs.
+ *
+ * A line drawn on screen can't show more than a few distinct points per pixel column: whatever
+ * the number of samples falling in a column, the rendered polyline only depends on the first and
+ * last samples of the column (which connect it to its neighbours) and on its min and max (which
+ * give the vertical extent of the column). Reducing a signal to these four samples per column
+ * therefore gives the same visual result as drawing all the samples.
+ */
+namespace GraphDecimation
+{
+
+/// Number of samples per pixel column under which decimation isn't worth it (a column emits up to
+/// four samples)
+const auto MIN_SAMPLES_PER_PIXEL = 4;
+
+/// Returns true if a signal of @p size samples should be decimated to be displayed on @p pixels
+/// columns
+inline bool isDecimationNeeded(std::size_t size, int pixels) noexcept
+{
+    return pixels > 0 && size > static_cast<std::size_t>(MIN_SAMPLES_PER_PIXEL) * pixels;
+}
+
+/**
+ * Reduces a signal to per pixel column envelopes: samples are grouped in columns of @p columnWidth
+ * (in key unit) starting from @p origin, and for each column the first, min, max and last samples
+ * are emitted in time order (duplicates being emitted once).
+ *
+ * NaN values are ignored when computing envelopes, but a column that only contains NaN values
+ * emits a single NaN sample so that data holes remain visible.
+ *
+ * @tparam Iterator forward iterator on the samples, sorted by keys
+ * @param first iterator to the first sample
+ * @param last iterator past the last sample
+ * @param key function returning the key of a sample
+ * @param value function returning the value of a sample
+ * @param origin key of the left border of the first column
+ * @param columnWidth width of a column, in key unit. Must be strictly positive
+ * @param emit function called with (key, value) for each sample kept
+ */
+template <typename Iterator, typename KeyFun, typename ValueFun, typename EmitFun>
+void envelope(Iterator first, Iterator last, KeyFun key, ValueFun value, double origin,
+    double columnWidth, EmitFun emit)
+{
+    struct Sample
+    {
+        double key;
+        double value;
+        std::size_t order; // position of the sample in its column, used to emit in time order
+    };
+
+    auto column = std::numeric_limits<double>::lowest();
+    auto count = std::size_t { 0 };
+    auto firstNaNKey = std::numeric_limits<double>::quiet_NaN();
+    Sample firstSample {}, minSample {}, maxSample {}, lastSample {};
+
+    auto flush = [&]() {
+        if (count == 0)
+        {
+            // Column of NaN values only
+            if (!std::isnan(firstNaNKey))
+            {
+                emit(firstNaNKey, std::numeric_limits<double>::quiet_NaN());
+            }
+            return;
+        }
+
+        std::array<Sample, 4> samples { firstSample, minSample, maxSample, lastSample };
+        std::sort(samples.begin(), samples.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.order < rhs.order; });
+        auto end = std::unique(samples.begin(), samples.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.order == rhs.order; });
+        std::for_each(
+            samples.begin(), end, [&emit](const auto& sample) { emit(sample.key, sample.value); });
+    };
+
+    for (auto it = first; it != last; ++it)
+    {
+        const auto& sample = *it;
+        auto sampleKey = key(sample);
+        auto sampleValue = value(sample);
+
+        auto sampleColumn = std::floor((sampleKey - origin) / columnWidth);
+        if (sampleColumn != column)
+        {
+            flush();
+            column = sampleColumn;
+            count = 0;
+            firstNaNKey = std::numeric_limits<double>::quiet_NaN();
+        }
+
+        if (std::isnan(sampleValue))
+        {
+            if (std::isnan(firstNaNKey))
+            {
+                firstNaNKey = sampleKey;
+            }
+            continue;
+        }
+
+        auto current = Sample { sampleKey, sampleValue, count };
+        if (count == 0)
+        {
+            firstSample = minSample = maxSample = current;
+        }
+        else if (sampleValue < minSample.value)
+        {
+            minSample = current;
+        }
+        else if (sampleValue > maxSample.value)
+        {
+            maxSample = current;
+        }
+        lastSample = current;
+        ++count;
+    }
+
+    if (first != last)
+    {
+        flush();
+    }
+}
+
+} // namespace GraphDecimation
+
+#endif // SCIQLOP_GRAPHDECIMATION_H
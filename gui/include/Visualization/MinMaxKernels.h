@@ -0,0 +1,33 @@
+#ifndef SCIQLOP_MINMAXKERNELS_H
+#define SCIQLOP_MINMAXKERNELS_H
+
+#include "Visualization/qcustomplot.h"
+
+#include <optional>
+
+/**
+ * Min/max reductions of plotted values, used to compute the ranges of axes and color scales.
+ *
+ * Reductions are done in one pass and ignore NaN values (data holes). Contiguous values are
+ * reduced with SIMD instructions when the target supports them (AVX or SSE2), with a scalar
+ * fallback otherwise.
+ */
+namespace MinMaxKernels
+{
+
+/**
+ * Computes the min and max of @p size contiguous values
+ * @return the range [min, max], or nothing if there are no values or if they are all NaN
+ */
+std::optional<QCPRange> minMax(const double* values, std::size_t size) noexcept;
+
+/**
+ * Computes the min and max of @p size values read every @p stride values (e.g. a component of a
+ * vector serie)
+ * @return the range [min, max], or nothing if there are no values or if they are all NaN
+ */
+std::optional<QCPRange> minMax(const double* values, std::size_t size, std::size_t stride) noexcept;
+
+} // namespace MinMaxKernels
+
+#endif // SCIQLOP_MINMAXKERNELS_H
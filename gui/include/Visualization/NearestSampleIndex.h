@@ -0,0 +1,73 @@
+#ifndef SCIQLOP_NEARESTSAMPLEINDEX_H
+#define SCIQLOP_NEARESTSAMPLEINDEX_H
+
+#include "Visualization/qcustomplot.h"
+
+#include <list>
+#include <optional>
+#include <vector>
+
+class TimeSeriesGraph;
+
+/**
+ * @brief The NearestSampleIndex class finds the sample of the graphs of a plot that is displayed
+ * the closest to a position, without hit-testing the samples one by one.
+ *
+ * Samples are located by binary search on their keys. When the pixel column under the position
+ * holds many samples (dense data), the samples of the column are sorted by value once and cached,
+ * so that moving the mouse along the column only costs a binary search on values. Only the
+ * columns last hovered are kept, so that the cache doesn't grow as the mouse sweeps the plot.
+ *
+ * The cache is cleared when the x-axis range or the geometry of the plot changes, and must be
+ * invalidated when the data of the graphs change.
+ */
+class NearestSampleIndex
+{
+public:
+    /// Sample found for a position
+    struct Sample
+    {
+        TimeSeriesGraph* m_Graph;
+        /// Index of the sample in the data of the graph
+        std::size_t m_Index;
+        /// Distance of the displayed sample to the position, in pixels
+        double m_Distance;
+    };
+
+    /**
+     * Returns the sample of the visible graphs of @p plot that is displayed the closest to @p pos,
+     * if it's within @p maxDistance pixels. NaN values are ignored
+     */
+    std::optional<Sample> nearest(QCustomPlot& plot, const QPoint& pos, double maxDistance);
+
+    /// Clears the cache. To be called when the data of the graphs change
+    void invalidate() noexcept;
+
+private:
+    /// Samples of a graph in a pixel column, as (value, index) pairs sorted by value
+    struct ColumnSamples
+    {
+        const TimeSeriesGraph* m_Graph;
+        const double* m_Keys;
+        std::size_t m_Size;
+        std::size_t m_Begin;
+        std::size_t m_End;
+        std::vector<std::pair<double, std::size_t>> m_Values;
+    };
+
+    /// Samples of the graphs in a pixel column
+    struct Column
+    {
+        int m_Column;
+        std::vector<ColumnSamples> m_Entries;
+    };
+
+    const ColumnSamples& columnSamples(const TimeSeriesGraph& graph, int column);
+
+    QCPRange m_KeyRange {};
+    QRect m_AxisRect {};
+    /// Cached columns, the most recently used first
+    std::list<Column> m_Columns {};
+};
+
+#endif // SCIQLOP_NEARESTSAMPLEINDEX_H
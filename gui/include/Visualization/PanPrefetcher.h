@@ -0,0 +1,49 @@
+#ifndef SCIQLOP_PANPREFETCHER_H
+#define SCIQLOP_PANPREFETCHER_H
+
+#include <Data/DateTimeRange.h>
+
+#include <QElapsedTimer>
+
+#include <optional>
+#include <vector>
+
+/**
+ * @brief The PanPrefetcher class decides the windows whose data is fetched ahead of a pan, around
+ * the range displayed by a graph.
+ *
+ * The velocity and direction of the pan are estimated from the successive ranges of the graph.
+ * While panning, the windows prefetched are the previous window and the windows that will be
+ * displayed in the next moments at the current velocity. Following ranges of the pan that fall in
+ * what has been prefetched don't prefetch anything: windows are only prefetched again when the pan
+ * gets out of them.
+ *
+ * The range displayed is always requested as is for the variables: the prefetched windows are
+ * fetched separately, so that they don't delay it. Any other change of range (zoom, jump to a
+ * date) stops the prefetch.
+ *
+ * @sa CachedDataProvider::prefetch()
+ */
+class PanPrefetcher
+{
+public:
+    PanPrefetcher();
+
+    /// Returns the windows to prefetch when the range of the graph becomes @p range: the windows
+    /// before and after it, or nothing if it isn't a pan or if they have already been prefetched
+    std::vector<DateTimeRange> rangesToPrefetch(const DateTimeRange& range);
+
+    /// Forgets what has been prefetched, so that the windows of the next pan are prefetched again
+    /// (e.g. when a variable is added to the graph)
+    void reset() noexcept;
+
+private:
+    QElapsedTimer m_Clock;
+    std::optional<DateTimeRange> m_LastRange;
+    qint64 m_LastTime;
+    /// Velocity of the pan, in time units of the range per ms
+    double m_Velocity;
+    std::optional<DateTimeRange> m_PrefetchedRange;
+};
+
+#endif // SCIQLOP_PANPREFETCHER_H
@@ -0,0 +1,54 @@
+#ifndef SCIQLOP_RANGECHANGEBROADCASTER_H
+#define SCIQLOP_RANGECHANGEBROADCASTER_H
+
+#include <Common/spimpl.h>
+
+#include <Data/DateTimeRange.h>
+
+#include <QLoggingCategory>
+#include <QObject>
+#include <QUuid>
+
+#include <memory>
+
+class Variable2;
+
+Q_DECLARE_LOGGING_CATEGORY(LOG_RangeChangeBroadcaster)
+
+/**
+ * @brief The RangeChangeBroadcaster class merges the range changes requested for the variables of
+ * synchronized graphs.
+ *
+ * When a graph of a zone is moved, every graph synchronized with it changes its range and asks a
+ * new range for each of its variables. Instead of being sent to the variable controller right away,
+ * requests are gathered in a transaction per synchronization group until the end of the current
+ * event loop iteration. The transactions are then issued with one request per variable, the last
+ * range asked for a variable superseding the previous ones, even if it is displayed by several
+ * graphs.
+ *
+ * @note The broadcaster is accessible from the sqpApp singleton and has the same life as the whole
+ * application
+ * @see SqpApplication
+ */
+class RangeChangeBroadcaster : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RangeChangeBroadcaster(QObject* parent = nullptr);
+
+    /**
+     * Asks a new range for a variable. The request is issued at the end of the current event loop
+     * iteration, with the requests of the same synchronization group
+     * @param groupId the synchronization group of the graph that displays the variable (null if
+     * the graph isn't synchronized)
+     */
+    void changeRange(
+        const QUuid& groupId, std::shared_ptr<Variable2> variable, const DateTimeRange& range);
+
+private:
+    class RangeChangeBroadcasterPrivate;
+    spimpl::unique_impl_ptr<RangeChangeBroadcasterPrivate> impl;
+};
+
+#endif // SCIQLOP_RANGECHANGEBROADCASTER_H
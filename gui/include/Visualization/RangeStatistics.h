@@ -0,0 +1,37 @@
+#ifndef SCIQLOP_RANGESTATISTICS_H
+#define SCIQLOP_RANGESTATISTICS_H
+
+#include "Visualization/TimeSeriesGraph.h"
+
+#include <optional>
+#include <utility>
+
+/**
+ * Statistics of plotted data over a time range.
+ *
+ * Keys of plotted data being sorted, the samples of a time range are located by binary search, so
+ * that only the samples of the range are read: statistics of what is on screen don't depend on the
+ * amount of data loaded around it.
+ *
+ * Samples can hold several components (e.g. a vector serie): statistics are then computed over the
+ * values of all the components. NaN values (data holes) are ignored.
+ */
+namespace RangeStatistics
+{
+
+/// Returns the indexes [first, last) of the samples of @p data whose keys are in [@p tStart,
+/// @p tEnd]
+std::pair<std::size_t, std::size_t> indexRange(
+    const TimeSeriesGraphData& data, double tStart, double tEnd) noexcept;
+
+/**
+ * Returns the range [min, max] of the values of @p data over [@p tStart, @p tEnd]
+ * @param componentCount the number of components of a sample read from the values of @p data.
+ * When the components fill the stride of the data, the values are reduced in one vectorized pass
+ */
+std::optional<QCPRange> valueRange(const TimeSeriesGraphData& data, double tStart, double tEnd,
+    std::size_t componentCount = 1) noexcept;
+
+} // namespace RangeStatistics
+
+#endif // SCIQLOP_RANGESTATISTICS_H
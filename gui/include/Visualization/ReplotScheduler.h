@@ -0,0 +1,57 @@
+#ifndef SCIQLOP_REPLOTSCHEDULER_H
+#define SCIQLOP_REPLOTSCHEDULER_H
+
+#include <Common/spimpl.h>
+
+#include <QLoggingCategory>
+#include <QObject>
+
+class QCPLayer;
+class QCustomPlot;
+
+Q_DECLARE_LOGGING_CATEGORY(LOG_ReplotScheduler)
+
+/**
+ * @brief The ReplotScheduler class coalesces the replots of all the plots of the application into
+ * frames.
+ *
+ * Instead of replotting themselves, graphs mark their plot as dirty. Once per frame interval, the
+ * scheduler replots each dirty plot once, however many times it has been marked during the
+ * interval (range changes of synchronized graphs, variables updated at different times, etc.).
+ *
+ * A frame stops replotting plots once its time budget is exceeded: remaining plots are replotted
+ * first at the next frame, so that the GUI stays responsive when many graphs are displayed.
+ *
+ * @note The scheduler is accessible from the sqpApp singleton and has the same life as the whole
+ * application
+ * @see SqpApplication
+ */
+class ReplotScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Interval between two frames, in ms
+    static const int FRAME_INTERVAL;
+
+    explicit ReplotScheduler(QObject* parent = nullptr);
+
+    /// Marks a plot as to be replotted at the next frame. The plot may be destroyed meanwhile
+    void scheduleReplot(QCustomPlot& plot);
+
+    /// Repaints a buffered layer right away, without replotting the other layers of its plot. If
+    /// the layer can't be repainted alone (logical layer, or paint buffers of the plot invalidated
+    /// by items added or removed), its plot is marked as to be replotted instead
+    void replotLayer(QCPLayer& layer);
+
+    /// Returns the time budget of a frame, in ms
+    int frameBudget() const noexcept;
+    /// Sets the time budget of a frame, in ms. The first plot of a frame is always replotted
+    void setFrameBudget(int frameBudget) noexcept;
+
+private:
+    class ReplotSchedulerPrivate;
+    spimpl::unique_impl_ptr<ReplotSchedulerPrivate> impl;
+};
+
+#endif // SCIQLOP_REPLOTSCHEDULER_H
@@ -0,0 +1,50 @@
+#ifndef SCIQLOP_SPECTROGRAMRASTERIZER_H
+#define SCIQLOP_SPECTROGRAMRASTERIZER_H
+
+#include "Visualization/qcustomplot.h"
+
+#include <Data/SpectrogramTimeSerie.h>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+/**
+ * @brief The SpectrogramRasterizer struct converts a spectrogram serie into colormap data.
+ *
+ * The raster is computed column by column: each column averages the lines of the serie whose time
+ * falls in it, and columns without any line hold the closest line, unless they are in a gap of the
+ * serie (@sa DataGaps). Gaps are kept as segments, so no line of fill values is needed in the
+ * serie to display them. Columns are independent, so they are computed in parallel by blocks, and
+ * each block is written row by row into a contiguous buffer.
+ *
+ * Rows are evenly spaced along the y-axis in its display scale (in log scale for a logarithmic
+ * axis), and each row takes the value of the channel whose bounds contain the row center, the
+ * bounds of a channel being midway (in display scale) between its center and the ones of its
+ * neighbours. Channels hence keep their exact extent whatever their spacing.
+ */
+struct SpectrogramRasterizer
+{
+    /// Result of a rasterization
+    struct Raster
+    {
+        std::unique_ptr<QCPColorMapData> m_Data;
+        /// Range of the values of the raster, NaN values excluded (QCPColorMapData computes data
+        /// bounds without excluding them)
+        std::optional<QCPRange> m_DataRange;
+    };
+
+    /**
+     * Rasterizes a spectrogram
+     * @param serie the spectrogram to rasterize
+     * @param yScaleType the scale type of the y-axis on which the colormap is displayed. A
+     * logarithmic scale is ignored if some channels aren't strictly positive
+     * @param canceled flag checked during rasterization to abort it
+     * @return the raster. Its data are null if the serie hasn't enough data or if the
+     * rasterization has been canceled
+     */
+    static Raster rasterize(SpectrogramTimeSerie& serie, QCPAxis::ScaleType yScaleType,
+        const std::atomic_bool& canceled);
+};
+
+#endif // SCIQLOP_SPECTROGRAMRASTERIZER_H
@@ -0,0 +1,116 @@
+#ifndef SCIQLOP_TIMESERIESGRAPH_H
+#define SCIQLOP_TIMESERIESGRAPH_H
+
+#include "Visualization/qcustomplot.h"
+
+#include <algorithm>
+#include <memory>
+
+class GraphDataPyramid;
+
+/**
+ * @brief The TimeSeriesGraphData struct is a view on one component of a time serie, that reads
+ * the keys and values in place from the buffers of the serie.
+ *
+ * Keys are read from the time axis of the serie. Values of the samples are stored contiguously,
+ * each sample holding @c m_Stride values (e.g. 3 for a vector serie), so the values of the
+ * component are read with a stride.
+ */
+struct TimeSeriesGraphData
+{
+    /// Returns the key of the sample at @p index
+    double key(std::size_t index) const noexcept { return m_Keys[index]; }
+
+    /// Returns the value of the sample at @p index
+    double value(std::size_t index) const noexcept { return m_Values[index * m_Stride]; }
+
+    std::size_t size() const noexcept { return m_Size; }
+
+    /// Returns the index of the first sample whose key is not less than @p key
+    std::size_t lowerBound(double key) const noexcept
+    {
+        return std::lower_bound(m_Keys, m_Keys + m_Size, key) - m_Keys;
+    }
+
+    /// Returns the index of the first sample whose key is greater than @p key
+    std::size_t upperBound(double key) const noexcept
+    {
+        return std::upper_bound(m_Keys, m_Keys + m_Size, key) - m_Keys;
+    }
+
+    /// Returns the index of the sample whose key is the closest to @p key. The view must not be
+    /// empty
+    std::size_t nearest(double key) const noexcept
+    {
+        auto index = lowerBound(key);
+        if (index == m_Size || (index > 0 && key - m_Keys[index - 1] < m_Keys[index] - key))
+        {
+            --index;
+        }
+        return index;
+    }
+
+    /// Returns a view on the samples from @p begin (included) to @p end (excluded)
+    TimeSeriesGraphData slice(std::size_t begin, std::size_t end) const noexcept
+    {
+        auto result = *this;
+        result.m_Keys = m_Keys + begin;
+        result.m_Values = m_Values + begin * m_Stride;
+        result.m_Size = end - begin;
+        return result;
+    }
+
+    /// Keeps the buffers of the serie alive as long as the view is used
+    std::shared_ptr<void> m_Owner {};
+    const double* m_Keys { nullptr };
+    const double* m_Values { nullptr };
+    std::size_t m_Stride { 1 };
+    std::size_t m_Size { 0 };
+};
+
+/**
+ * @brief The TimeSeriesGraph class is a line plottable that displays a component of a time serie
+ * without copying its data.
+ *
+ * Unlike QCPGraph, which needs its own data container, the graph reads samples through a
+ * TimeSeriesGraphData view, so updating the graph is a matter of swapping views. Only the visible
+ * samples are walked at drawing, and they are reduced to per pixel column envelopes when they
+ * outnumber the pixel columns.
+ *
+ * When the graph has levels of detail, the coarsest level that still gives one sample per pixel
+ * column over the visible range is drawn instead of the raw samples.
+ *
+ * @sa GraphDataPyramid
+ * @sa GraphDecimation
+ */
+class TimeSeriesGraph : public QCPAbstractPlottable
+{
+    Q_OBJECT
+
+public:
+    explicit TimeSeriesGraph(QCPAxis* keyAxis, QCPAxis* valueAxis);
+
+    const TimeSeriesGraphData& data() const noexcept;
+    void setData(TimeSeriesGraphData data) noexcept;
+
+    std::shared_ptr<const GraphDataPyramid> pyramid() const noexcept;
+    /// Sets levels of detail of the data of the graph. The pyramid must have been built from the
+    /// data set in the graph
+    void setPyramid(std::shared_ptr<const GraphDataPyramid> pyramid) noexcept;
+
+    // QCPAbstractPlottable interface
+    double selectTest(const QPointF& pos, bool onlySelectable, QVariant* details = 0) const override;
+    QCPRange getKeyRange(bool& foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth) const override;
+    QCPRange getValueRange(bool& foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth,
+        const QCPRange& inKeyRange = QCPRange()) const override;
+
+protected:
+    void draw(QCPPainter* painter) override;
+    void drawLegendIcon(QCPPainter* painter, const QRectF& rect) const override;
+
+private:
+    TimeSeriesGraphData m_Data;
+    std::shared_ptr<const GraphDataPyramid> m_Pyramid;
+};
+
+#endif // SCIQLOP_TIMESERIESGRAPH_H
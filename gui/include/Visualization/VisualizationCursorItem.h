@@ -18,6 +18,9 @@ public:
     void setOrientation(Qt::Orientation orientation);
     void setLabelText(const QString &text);
 
+    /// Repaints the layer of the cursors, without replotting the plottables of the plot
+    void refresh();
+
 private:
     class VisualizationCursorItemPrivate;
     spimpl::unique_impl_ptr<VisualizationCursorItemPrivate> impl;
@@ -3,11 +3,15 @@
 
 #include "Visualization/VisualizationDefs.h"
 
+#include <Data/DataSeriesType.h>
 #include <Data/DateTimeRange.h>
 
 #include <QLoggingCategory>
 #include <QVector>
 
+#include <TimeSeries.h>
+
+#include <atomic>
 #include <memory>
 
 Q_DECLARE_LOGGING_CATEGORY(LOG_VisualizationGraphHelper)
@@ -17,6 +21,19 @@ class QCPAbstractPlottable;
 class QCustomPlot;
 class Variable2;
 
+/**
+ * Data of the plottables of a variable, prepared by VisualizationGraphHelper::prepareData(). Once
+ * prepared, data are not modified anymore and only have to be set in the plottables
+ */
+struct IPreparedPlottables
+{
+    virtual ~IPreparedPlottables() noexcept = default;
+
+    /// Sets the prepared data in the plottables. Data are given to the plottables, so this method
+    /// must be called only once
+    virtual void apply(PlottablesMap& plottables, bool rescaleAxes) = 0;
+};
+
 /**
  * @brief The VisualizationGraphHelper class aims to create the QCustomPlot components relative to a
  * variable, depending on the data series of this variable
@@ -33,10 +50,41 @@ struct VisualizationGraphHelper
      */
     static PlottablesMap create(std::shared_ptr<Variable2> variable, QCustomPlot& plot) noexcept;
 
-    static void updateData(PlottablesMap& plottables, std::shared_ptr<Variable2> variable,
-        const DateTimeRange& dateTime);
+    /**
+     * Prepares the data of the plottables of a variable, which is the expensive part of their
+     * update: line graphs get views on the series with their levels of detail, colormaps get
+     * their cells filled. The method doesn't access any plottable and can be run out of the GUI
+     * thread.
+     *
+     * When the new series only appends samples to the series of the previous data (live feed),
+     * line graphs only reduce the new samples, and drop the samples before @p windowStart.
+     *
+     * @param type the type of the data series
+     * @param data the data series from which to prepare the data
+     * @param previous the data previously prepared for the variable, if any. They are only read
+     * @param windowStart key before which samples of line graphs are dropped for a live feed
+     * @param canceled flag checked during the preparation, that allows to stop it when it is
+     * superseded
+     * @return the prepared data, or nullptr if the preparation has been canceled or failed
+     * @sa GraphDataPyramid
+     */
+    static std::shared_ptr<IPreparedPlottables> prepareData(DataSeriesType type,
+        std::shared_ptr<TimeSeries::ITimeSerie> data, const IPreparedPlottables* previous,
+        double windowStart, const std::atomic_bool& canceled);
+
+    /// Sets prepared data in the plottables. Must be called in the GUI thread
+    static void applyData(PlottablesMap& plottables, IPreparedPlottables& preparedData);
 
+    /// Sets the y-axis range of a plot to the values of a variable over the x-axis range of the
+    /// plot
     static void setYAxisRange(std::shared_ptr<Variable2> variable, QCustomPlot& plot) noexcept;
+
+    /**
+     * Rescales the y-axis of a plot to the values of its plottables over its x-axis range, rather
+     * than over all the data loaded
+     * @sa RangeStatistics
+     */
+    static void rescaleYAxis(QCustomPlot& plot) noexcept;
 };
 
 #endif // SCIQLOP_VISUALIZATIONGRAPHHELPER_H
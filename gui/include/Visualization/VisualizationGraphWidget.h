@@ -76,6 +76,10 @@ public:
     DateTimeRange graphRange() const noexcept;
     void setGraphRange(const DateTimeRange& range, bool updateVar = false, bool forward = false);
     void setAutoRangeOnVariableInitialization(bool value);
+    /// Sets the synchronization group of the graph, whose range changes are merged. The group is
+    /// set by the zone of the graph, and reset when the graph is closed
+    /// @sa RangeChangeBroadcaster
+    void setSynchronisationGroupId(const QUuid& groupId);
 
     // Zones
     /// Returns the ranges of all the selection zones on the graph
@@ -1,3 +1,7 @@
 #include "Common/VisualizationDef.h"
 
 const int GRAPH_MINIMUM_HEIGHT = 300;
+
+const QString SELECTION_ZONES_LAYER = QStringLiteral("selectionZones");
+const QString TRACER_LAYER = QStringLiteral("tracer");
+const QString CURSORS_LAYER = QStringLiteral("cursors");
@@ -0,0 +1,225 @@
+#include "DataSource/CachedDataProvider.h"
+#include "DataSource/TimeSeriesCache.h"
+#include "DataSource/TimeSeriesDiskCache.h"
+
+#include <Data/DataProviderParameters.h>
+#include <SqpApplication.h>
+
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+#include <map>
+#include <mutex>
+#include <optional>
+
+Q_LOGGING_CATEGORY(LOG_CachedDataProvider, "CachedDataProvider")
+
+namespace
+{
+
+/// Data fetched for a range: the slices covering it, or the data of the whole range if it can't be
+/// cached
+struct FetchResult
+{
+    std::vector<TimeSeriesCache::Slice> m_Slices;
+    std::unique_ptr<TimeSeries::ITimeSerie> m_UncachedData;
+};
+
+/**
+ * Looks up the data of a product in the caches, and fetches the parts of the range that are in none
+ * of them. The parts fetched are stored in the caches. The parts that couldn't be fetched are
+ * missing from the result, the data of the other parts being kept
+ * @return the data of the range, nothing if no part of it could be read or fetched
+ */
+std::optional<FetchResult> fetch(
+    IDataProvider& provider, const QString& key, const DataProviderParameters& parameters)
+{
+    auto& cache = sqpApp->timeSeriesCache();
+    auto& diskCache = sqpApp->timeSeriesDiskCache();
+
+    // Data is looked up in memory, then on disk, and only the remaining ranges are fetched
+    auto [slices, missingRanges] = cache.lookup(key, parameters.m_Range);
+    auto result = FetchResult { std::move(slices), nullptr };
+    auto failedCount = 0;
+
+    for (const auto& missingRange : missingRanges)
+    {
+        auto diskLookup = diskCache.isEnabled()
+            ? diskCache.lookup(key, missingRange)
+            : TimeSeriesCache::Lookup { {}, { missingRange } };
+        for (auto& slice : diskLookup.m_Slices)
+        {
+            cache.insert(key, slice);
+            result.m_Slices.push_back(std::move(slice));
+        }
+
+        for (const auto& fetchedRange : diskLookup.m_MissingRanges)
+        {
+            auto fetchedParameters = parameters;
+            fetchedParameters.m_Range = fetchedRange;
+            auto data
+                = std::unique_ptr<TimeSeries::ITimeSerie> { provider.getData(fetchedParameters) };
+            if (!data)
+            {
+                qCWarning(LOG_CachedDataProvider())
+                    << QObject::tr("Can't fetch %1 from %2 to %3, its data will be missing")
+                           .arg(key)
+                           .arg(fetchedRange.m_TStart)
+                           .arg(fetchedRange.m_TEnd);
+                ++failedCount;
+                continue;
+            }
+
+            // Nothing is stored for products whose data can't be cached, so the provider has
+            // been asked for the whole range
+            if (!TimeSeriesCache::isCacheable(*data))
+            {
+                return FetchResult { {}, std::move(data) };
+            }
+
+            // The data returned cover the whole range asked: providers return no data rather
+            // than data with a hole, which would be served from the caches
+            auto slice = TimeSeriesCache::Slice { fetchedRange, std::move(data) };
+            cache.insert(key, slice);
+            diskCache.insert(key, slice);
+            result.m_Slices.push_back(std::move(slice));
+        }
+    }
+
+    if (result.m_Slices.empty() && failedCount > 0)
+    {
+        return std::nullopt;
+    }
+    return result;
+}
+
+/// Returns the key of a product whatever its provider, under which is registered the provider that
+/// served it
+QString productKey(const QVariantHash& metaData)
+{
+    return TimeSeriesCache::key(QString {}, metaData);
+}
+
+/// Providers that served the products, by product key. They are used to prefetch the products
+struct ProductProviders
+{
+    std::mutex m_Mutex;
+    std::map<QString, std::shared_ptr<CachedDataProvider>> m_Providers;
+};
+
+ProductProviders& productProviders()
+{
+    static auto providers = ProductProviders {};
+    return providers;
+}
+
+/// Pool running the prefetches. It has one thread, so that prefetches take as few resources as
+/// possible from the requests of the variables
+QThreadPool& prefetchThreadPool()
+{
+    static auto pool = []() {
+        auto pool = std::make_unique<QThreadPool>();
+        pool->setMaxThreadCount(1);
+        return pool;
+    }();
+    return *pool;
+}
+
+/// Prefetch of a product over a range. Its data is only stored in the caches
+class PrefetchTask : public QRunnable
+{
+public:
+    explicit PrefetchTask(std::shared_ptr<CachedDataProvider> provider, QVariantHash metaData,
+        const DateTimeRange& range)
+            : m_Provider { std::move(provider) }
+            , m_MetaData { std::move(metaData) }
+            , m_Range { range }
+    {
+    }
+
+    void run() override
+    {
+        QThread::currentThread()->setPriority(QThread::LowestPriority);
+
+        // Only the caches keep the data: the serie returned is dropped
+        delete m_Provider->getData(DataProviderParameters { m_Range, m_MetaData });
+    }
+
+private:
+    std::shared_ptr<CachedDataProvider> m_Provider;
+    QVariantHash m_MetaData;
+    DateTimeRange m_Range;
+};
+
+} // namespace
+
+CachedDataProvider::CachedDataProvider(
+    const QString& providerId, std::shared_ptr<IDataProvider> provider)
+        : m_ProviderId { providerId }, m_Provider { std::move(provider) }
+{
+}
+
+void CachedDataProvider::prefetch(
+    const std::vector<QVariantHash>& products, const std::vector<DateTimeRange>& ranges)
+{
+    auto& pool = prefetchThreadPool();
+    pool.clear();
+
+    // Prefetched data would be fetched again when displayed if it couldn't be stored
+    if (!sqpApp->timeSeriesCache().isEnabled() && !sqpApp->timeSeriesDiskCache().isEnabled())
+    {
+        return;
+    }
+
+    auto& providers = productProviders();
+    std::lock_guard<std::mutex> lock { providers.m_Mutex };
+    for (const auto& range : ranges)
+    {
+        for (const auto& metaData : products)
+        {
+            auto it = providers.m_Providers.find(productKey(metaData));
+            if (it != providers.m_Providers.cend())
+            {
+                pool.start(new PrefetchTask { it->second, metaData, range });
+            }
+        }
+    }
+}
+
+std::shared_ptr<IDataProvider> CachedDataProvider::clone() const
+{
+    return std::make_shared<CachedDataProvider>(m_ProviderId, m_Provider->clone());
+}
+
+TimeSeries::ITimeSerie* CachedDataProvider::getData(const DataProviderParameters& parameters)
+{
+    {
+        // The provider is registered with a clone of its own, as its life is the one of the
+        // request
+        auto& providers = productProviders();
+        std::lock_guard<std::mutex> lock { providers.m_Mutex };
+        auto& provider = providers.m_Providers[productKey(parameters.m_Data)];
+        if (!provider)
+        {
+            provider = std::make_shared<CachedDataProvider>(m_ProviderId, m_Provider->clone());
+        }
+    }
+
+    if (!sqpApp->timeSeriesCache().isEnabled() && !sqpApp->timeSeriesDiskCache().isEnabled())
+    {
+        return m_Provider->getData(parameters);
+    }
+
+    auto key = TimeSeriesCache::key(m_ProviderId, parameters.m_Data);
+    auto result = fetch(*m_Provider, key, parameters);
+    if (!result)
+    {
+        return nullptr;
+    }
+    if (result->m_UncachedData)
+    {
+        return result->m_UncachedData.release();
+    }
+    return TimeSeriesCache::merge(std::move(result->m_Slices), parameters.m_Range);
+}
@@ -0,0 +1,41 @@
+#include "DataSource/DataGaps.h"
+
+#include <algorithm>
+#include <cmath>
+
+DataGaps DataGaps::find(
+    const std::vector<double>& xAxis, double resolution, double minBound, double maxBound)
+{
+    auto result = DataGaps {};
+    if (!(resolution > 0.) || xAxis.empty())
+    {
+        return result;
+    }
+
+    if (!std::isnan(minBound) && xAxis.front() - minBound > resolution)
+    {
+        result.m_Gaps.push_back({ minBound, xAxis.front() });
+    }
+
+    auto isGap = [resolution](double t1, double t2) { return t2 - t1 > resolution; };
+    for (auto it = std::adjacent_find(xAxis.cbegin(), xAxis.cend(), isGap); it != xAxis.cend();
+         it = std::adjacent_find(it + 1, xAxis.cend(), isGap))
+    {
+        result.m_Gaps.push_back({ *it, *(it + 1) });
+    }
+
+    if (!std::isnan(maxBound) && maxBound - xAxis.back() > resolution)
+    {
+        result.m_Gaps.push_back({ xAxis.back(), maxBound });
+    }
+
+    return result;
+}
+
+bool DataGaps::contains(double time) const noexcept
+{
+    // First gap ending after the time
+    auto it = std::upper_bound(m_Gaps.cbegin(), m_Gaps.cend(), time,
+        [](double time, const Gap& gap) { return time < gap.m_TEnd; });
+    return it != m_Gaps.cend() && it->m_TStart < time;
+}
@@ -0,0 +1,54 @@
+#include "DataSource/DataSourceItemLoader.h"
+
+#include <DataSource/DataSourceItem.h>
+
+#include <map>
+#include <mutex>
+
+const QString DataSourceItemLoader::LOADER_DATA_KEY = QStringLiteral("loader");
+const QString DataSourceItemLoader::NODE_DATA_KEY = QStringLiteral("loaderNode");
+
+namespace
+{
+
+/// Loaders registered, by name
+struct LoaderRegistry
+{
+    std::mutex m_Mutex;
+    std::map<QString, std::shared_ptr<DataSourceItemLoader>> m_Loaders;
+};
+
+LoaderRegistry& registry()
+{
+    static LoaderRegistry registry {};
+    return registry;
+}
+
+} // namespace
+
+void DataSourceItemLoader::registerLoader(
+    const QString& name, std::shared_ptr<DataSourceItemLoader> loader)
+{
+    auto& loaderRegistry = registry();
+    std::lock_guard<std::mutex> lock { loaderRegistry.m_Mutex };
+    loaderRegistry.m_Loaders[name] = std::move(loader);
+}
+
+std::shared_ptr<DataSourceItemLoader> DataSourceItemLoader::loader(const DataSourceItem& item)
+{
+    auto name = item.data(LOADER_DATA_KEY);
+    if (!name.isValid())
+    {
+        return nullptr;
+    }
+
+    auto& loaderRegistry = registry();
+    std::lock_guard<std::mutex> lock { loaderRegistry.m_Mutex };
+    auto it = loaderRegistry.m_Loaders.find(name.toString());
+    return it != loaderRegistry.m_Loaders.cend() ? it->second : nullptr;
+}
+
+bool DataSourceItemLoader::isLoaderDataKey(const QString& key) noexcept
+{
+    return key == LOADER_DATA_KEY || key == NODE_DATA_KEY;
+}
@@ -2,6 +2,7 @@
 #include "Common/MimeTypesDef.h"
 #include "DataSource/DataSourceController.h"
 #include "DataSource/DataSourceItem.h"
+#include "DataSource/DataSourceItemLoader.h"
 #include "DataSource/DataSourceTreeWidgetItem.h"
 
 #include "DragAndDrop/DragDropGuiController.h"
@@ -28,7 +29,10 @@ QMimeData *DataSourceTreeWidget::mimeData(const QList<QTreeWidgetItem *> items)
 
         if (dataSource->type() == DataSourceItemType::COMPONENT
             || dataSource->type() == DataSourceItemType::PRODUCT) {
+            // Data used to create the item on demand isn't part of the product metadata
             auto metaData = dataSource->data();
+            metaData.remove(DataSourceItemLoader::LOADER_DATA_KEY);
+            metaData.remove(DataSourceItemLoader::NODE_DATA_KEY);
             productData << metaData;
         }
     }
@@ -1,5 +1,6 @@
 #include <DataSource/DataSourceItem.h>
 #include <DataSource/DataSourceItemAction.h>
+#include <DataSource/DataSourceItemLoader.h>
 #include <DataSource/DataSourceTreeWidgetItem.h>
 
 #include <QAction>
@@ -111,7 +112,10 @@ QString itemTooltip(const DataSourceItem *dataSource) noexcept
 
         const auto &data = dataSource->data();
         for (auto it = data.cbegin(), end = data.cend(); it != end; ++it) {
-            result.append(QString{"<b>%1:</b> %2<br/>"}.arg(it.key(), tooltipValue(it.value())));
+            if (!DataSourceItemLoader::isLoaderDataKey(it.key())) {
+                result.append(
+                    QString{"<b>%1:</b> %2<br/>"}.arg(it.key(), tooltipValue(it.value())));
+            }
         }
 
         return result;
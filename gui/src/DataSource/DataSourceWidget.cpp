@@ -3,10 +3,14 @@
 #include <ui_DataSourceWidget.h>
 
 #include <DataSource/DataSourceItem.h>
+#include <DataSource/DataSourceItemLoader.h>
 #include <DataSource/DataSourceTreeWidgetHelper.h>
 #include <DataSource/DataSourceTreeWidgetItem.h>
 
 #include <QMenu>
+#include <QTimer>
+
+#include <unordered_set>
 
 namespace {
 
@@ -16,6 +20,17 @@ const auto TREE_NB_COLUMNS = 1;
 /// Header labels for the tree
 const auto TREE_HEADER_LABELS = QStringList{QObject::tr("Name")};
 
+/// Delay after the last change of the filtering text before the tree is filtered, in ms
+const auto FILTER_DELAY = 300;
+
+/// Minimum length of the filtering text for which items created on demand are searched. Shorter
+/// texts only filter the items already created
+const auto MIN_LOADING_FILTER_LENGTH = 3;
+
+/// Maximum number of items created on demand that match the filtering text, for each tree created
+/// by a loader
+const auto MAX_LOADED_MATCHES = 500;
+
 /**
  * Creates the item associated to a data source
  * @param dataSource the data source for which to create the item
@@ -31,16 +46,64 @@ DataSourceTreeWidgetItem *createTreeWidgetItem(DataSourceItem *dataSource)
         item->addChild(createTreeWidgetItem(dataSource->child(i)));
     }
 
+    // Children not created yet are signaled, so that the item can be expanded to create them
+    auto loader = DataSourceItemLoader::loader(*dataSource);
+    if (loader && loader->canLoadChildren(*dataSource)) {
+        item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+    }
+
     return item;
 }
 
+/// Creates under an item the items of the data sources that don't have one yet. They are the
+/// data sources created by a loader since the item was created
+void completeTreeWidgetItem(DataSourceTreeWidgetItem &item)
+{
+    auto dataSource = item.data();
+    auto loader = DataSourceItemLoader::loader(*dataSource);
+    if (!loader || !loader->canLoadChildren(*dataSource)) {
+        item.setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
+    }
+
+    // Children of the item may have been sorted, so they are matched by their data source
+    auto displayedChildren = std::unordered_set<const DataSourceItem *>{};
+    for (auto i = 0, count = item.childCount(); i < count; ++i) {
+        if (auto childItem = dynamic_cast<DataSourceTreeWidgetItem *>(item.child(i))) {
+            displayedChildren.insert(childItem->data());
+            completeTreeWidgetItem(*childItem);
+        }
+    }
+
+    for (auto i = 0, count = dataSource->childCount(); i < count; ++i) {
+        auto child = dataSource->child(i);
+        if (displayedChildren.find(child) == displayedChildren.cend()) {
+            item.addChild(createTreeWidgetItem(child));
+        }
+    }
+}
+
+/// Creates the items of the data sources that validate a filter, for the trees created by loaders
+void loadMatchingItems(DataSourceItem &dataSource,
+                       const DataSourceItemLoader::FilterFunction &filter)
+{
+    if (auto loader = DataSourceItemLoader::loader(dataSource)) {
+        loader->loadMatchingItems(dataSource, filter, MAX_LOADED_MATCHES);
+    }
+    else {
+        for (auto i = 0, count = dataSource.childCount(); i < count; ++i) {
+            loadMatchingItems(*dataSource.child(i), filter);
+        }
+    }
+}
+
 } // namespace
 
 DataSourceWidget::DataSourceWidget(QWidget *parent)
         : QWidget{parent},
           ui{new Ui::DataSourceWidget},
-          m_Root{
-              std::make_unique<DataSourceItem>(DataSourceItemType::NODE, QStringLiteral("Sources"))}
+          m_Root{std::make_unique<DataSourceItem>(DataSourceItemType::NODE,
+                                                  QStringLiteral("Sources"))},
+          m_FilterTimer{new QTimer{this}}
 {
     ui->setupUi(this);
 
@@ -53,8 +116,16 @@ DataSourceWidget::DataSourceWidget(QWidget *parent)
     connect(ui->treeWidget, &QTreeWidget::customContextMenuRequested, this,
             &DataSourceWidget::onTreeMenuRequested);
 
-    // Connection to filter tree
-    connect(ui->filterLineEdit, &QLineEdit::textChanged, this, &DataSourceWidget::filterChanged);
+    // Connection to filter tree, once the text stops changing
+    m_FilterTimer->setSingleShot(true);
+    m_FilterTimer->setInterval(FILTER_DELAY);
+    connect(ui->filterLineEdit, &QLineEdit::textChanged, m_FilterTimer,
+            static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(m_FilterTimer, &QTimer::timeout, this,
+            [this]() { filterChanged(ui->filterLineEdit->text()); });
+
+    // Connection to create children of items on demand
+    connect(ui->treeWidget, &QTreeWidget::itemExpanded, this, &DataSourceWidget::onItemExpanded);
 
     // First init
     updateTreeWidget();
@@ -90,25 +161,65 @@ void DataSourceWidget::updateTreeWidget() noexcept
     ui->treeWidget->sortByColumn(0, Qt::AscendingOrder);
 }
 
-void DataSourceWidget::filterChanged(const QString &text) noexcept
+void DataSourceWidget::applyFilter() noexcept
 {
-    auto validateItem = [&text](const DataSourceTreeWidgetItem &item) {
-        auto regExp = QRegExp{text, Qt::CaseInsensitive, QRegExp::Wildcard};
-
+    auto regExp = QRegExp{ui->filterLineEdit->text(), Qt::CaseInsensitive, QRegExp::Wildcard};
+    auto validateItem = [&regExp](const DataSourceTreeWidgetItem &item) {
         // An item is valid if any of its metadata validates the text filter
         auto itemMetadata = item.data()->data();
-        auto itemMetadataEnd = itemMetadata.cend();
-        auto acceptFilter
-            = [&regExp](const auto &variant) { return variant.toString().contains(regExp); };
-
-        return std::find_if(itemMetadata.cbegin(), itemMetadataEnd, acceptFilter)
-               != itemMetadataEnd;
+        for (auto it = itemMetadata.cbegin(), end = itemMetadata.cend(); it != end; ++it) {
+            if (!DataSourceItemLoader::isLoaderDataKey(it.key())
+                && it.value().toString().contains(regExp)) {
+                return true;
+            }
+        }
+        return false;
     };
 
     // Applies filter on tree widget
     DataSourceTreeWidgetHelper::filter(*ui->treeWidget, validateItem);
 }
 
+void DataSourceWidget::filterChanged(const QString &text) noexcept
+{
+    // Items created on demand that validate the filter are created before filtering the tree, so
+    // that they can be displayed
+    if (text.size() >= MIN_LOADING_FILTER_LENGTH) {
+        auto regExp = QRegExp{text, Qt::CaseInsensitive, QRegExp::Wildcard};
+        loadMatchingItems(*m_Root, [&regExp](const QVariant &value) {
+            return value.toString().contains(regExp);
+        });
+
+        for (auto i = 0, count = ui->treeWidget->topLevelItemCount(); i < count; ++i) {
+            if (auto item
+                = dynamic_cast<DataSourceTreeWidgetItem *>(ui->treeWidget->topLevelItem(i))) {
+                completeTreeWidgetItem(*item);
+            }
+        }
+    }
+
+    applyFilter();
+}
+
+void DataSourceWidget::onItemExpanded(QTreeWidgetItem *item) noexcept
+{
+    auto treeItem = dynamic_cast<DataSourceTreeWidgetItem *>(item);
+    if (!treeItem) {
+        return;
+    }
+
+    // The data sources of the tree are owned by the widget, so they can be modified
+    auto dataSource = const_cast<DataSourceItem *>(treeItem->data());
+    auto loader = DataSourceItemLoader::loader(*dataSource);
+    if (loader && loader->canLoadChildren(*dataSource)) {
+        loader->loadChildren(*dataSource);
+        completeTreeWidgetItem(*treeItem);
+
+        // The new children are filtered as the rest of the tree
+        applyFilter();
+    }
+}
+
 void DataSourceWidget::onTreeMenuRequested(const QPoint &pos) noexcept
 {
     // Retrieves the selected item in the tree, and build the menu from its actions
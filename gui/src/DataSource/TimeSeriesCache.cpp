@@ -0,0 +1,361 @@
+#include "DataSource/TimeSeriesCache.h"
+
+#include <Data/ScalarTimeSerie.h>
+#include <Data/SpectrogramTimeSerie.h>
+#include <Data/VectorTimeSerie.h>
+#include <Settings/SqpSettingsGuiDefs.h>
+
+#include <QSettings>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <optional>
+
+Q_LOGGING_CATEGORY(LOG_TimeSeriesCache, "TimeSeriesCache")
+
+namespace
+{
+
+/// Bytes in a MB, the unit of the budget in the settings
+const auto BYTES_PER_MB = std::size_t { 1024 * 1024 };
+
+/// Copies the samples of slices that are in a range into a new serie. Samples of a slice that
+/// precede the last sample copied are skipped, as slices may overlap
+template <typename T>
+std::unique_ptr<T> mergeSeries(
+    const std::vector<TimeSeriesCache::Slice>& slices, const DateTimeRange& range)
+{
+    auto result = std::make_unique<T>();
+    auto lastTime = std::optional<double> {};
+    for (const auto& slice : slices)
+    {
+        auto& serie = static_cast<T&>(*slice.m_Data);
+        auto begin = std::lower_bound(std::begin(serie), std::end(serie), range.m_TStart,
+            [](const auto& sample, double time) { return sample.t() < time; });
+        if (lastTime)
+        {
+            begin = std::upper_bound(begin, std::end(serie), *lastTime,
+                [](double time, const auto& sample) { return time < sample.t(); });
+        }
+        auto end = std::upper_bound(begin, std::end(serie), range.m_TEnd,
+            [](double time, const auto& sample) { return time < sample.t(); });
+
+        if (begin != end)
+        {
+            std::copy(begin, end, std::back_inserter(*result));
+            lastTime = (end - 1)->t();
+        }
+    }
+    return result;
+}
+
+/// Copies the lines of spectrogram slices that are in a range into a new spectrogram, as
+/// mergeSeries() does for the samples of the other series. The bands and the samplings are the ones
+/// of the first slice: slices having other bands are skipped
+std::unique_ptr<SpectrogramTimeSerie> mergeSpectrograms(
+    const std::vector<TimeSeriesCache::Slice>& slices, const DateTimeRange& range)
+{
+    auto& firstSerie = static_cast<SpectrogramTimeSerie&>(*slices.front().m_Data);
+    auto yAxis = firstSerie.axis(1);
+    auto times = std::vector<double> {};
+    auto values = std::vector<double> {};
+    auto lastTime = std::optional<double> {};
+    for (const auto& slice : slices)
+    {
+        auto& serie = static_cast<SpectrogramTimeSerie&>(*slice.m_Data);
+        if (serie.size(0) == 0 || serie.axis(1) != yAxis)
+        {
+            continue;
+        }
+
+        auto serieTimes = serie.axis(0);
+        auto begin = std::lower_bound(serieTimes.cbegin(), serieTimes.cend(), range.m_TStart);
+        if (lastTime)
+        {
+            begin = std::upper_bound(begin, serieTimes.cend(), *lastTime);
+        }
+        auto end = std::upper_bound(begin, serieTimes.cend(), range.m_TEnd);
+
+        auto line = std::begin(serie) + (begin - serieTimes.cbegin());
+        for (auto time = begin; time != end; ++time, ++line)
+        {
+            times.push_back(*time);
+            auto&& lineValues = *line;
+            for (const auto& item : lineValues)
+            {
+                values.push_back(item.v());
+            }
+        }
+        if (begin != end)
+        {
+            lastTime = *(end - 1);
+        }
+    }
+
+    auto shape = std::vector<std::size_t> { times.size(), yAxis.size() };
+    return std::make_unique<SpectrogramTimeSerie>(std::move(times), std::move(yAxis),
+        std::move(values), shape, firstSerie.min_sampling, firstSerie.max_sampling,
+        firstSerie.y_is_log);
+}
+
+/// Memory used by a serie, in bytes: its times and values
+std::size_t sliceMemorySize(const TimeSeries::ITimeSerie& serie) noexcept
+{
+    if (auto spectrogram = dynamic_cast<const SpectrogramTimeSerie*>(&serie))
+    {
+        return spectrogram->size(0) * (1 + spectrogram->size(1)) * sizeof(double);
+    }
+    auto valuesPerSample = dynamic_cast<const VectorTimeSerie*>(&serie) ? 3 : 1;
+    return serie.size() * (1 + valuesPerSample) * sizeof(double);
+}
+
+bool intersectsOrTouches(const DateTimeRange& range, const DateTimeRange& other) noexcept
+{
+    return range.m_TStart <= other.m_TEnd && other.m_TStart <= range.m_TEnd;
+}
+
+} // namespace
+
+class TimeSeriesCache::TimeSeriesCachePrivate
+{
+public:
+    struct Entry
+    {
+        TimeSeriesCache::Slice m_Slice;
+        std::size_t m_MemorySize;
+        /// Value of the use counter when the entry was last looked up or inserted
+        std::uint64_t m_LastUse;
+    };
+
+    /// Entries of a product, by start of their range. Entries don't overlap
+    using Entries = std::map<double, Entry>;
+
+    explicit TimeSeriesCachePrivate()
+            : m_MemoryBudget { QSettings {}
+                                   .value(DATA_CACHE_MEMORY_BUDGET_KEY,
+                                       DATA_CACHE_MEMORY_BUDGET_DEFAULT_VALUE)
+                                   .toULongLong()
+                  * BYTES_PER_MB }
+    {
+    }
+
+    /// Evicts the least recently used entries until the memory used fits the budget. Must be
+    /// called with the mutex locked
+    void evict()
+    {
+        while (m_MemoryUsed > m_MemoryBudget)
+        {
+            auto lruProduct = std::end(m_Products);
+            auto lruEntry = Entries::iterator {};
+            for (auto productIt = std::begin(m_Products); productIt != std::end(m_Products);
+                 ++productIt)
+            {
+                for (auto entryIt = std::begin(productIt->second);
+                     entryIt != std::end(productIt->second); ++entryIt)
+                {
+                    if (lruProduct == std::end(m_Products)
+                        || entryIt->second.m_LastUse < lruEntry->second.m_LastUse)
+                    {
+                        lruProduct = productIt;
+                        lruEntry = entryIt;
+                    }
+                }
+            }
+
+            if (lruProduct == std::end(m_Products))
+            {
+                break;
+            }
+
+            m_MemoryUsed -= lruEntry->second.m_MemorySize;
+            lruProduct->second.erase(lruEntry);
+            if (lruProduct->second.empty())
+            {
+                m_Products.erase(lruProduct);
+            }
+        }
+    }
+
+    mutable std::mutex m_Mutex;
+    std::map<QString, Entries> m_Products;
+    std::size_t m_MemoryBudget;
+    std::size_t m_MemoryUsed { 0 };
+    std::uint64_t m_UseCounter { 0 };
+};
+
+TimeSeriesCache::TimeSeriesCache() : impl { spimpl::make_unique_impl<TimeSeriesCachePrivate>() }
+{
+}
+
+QString TimeSeriesCache::key(const QString& providerId, const QVariantHash& metaData)
+{
+    // Keys of a hash are unordered: they are sorted so that the same metadata gives the same key
+    auto metaDataKeys = metaData.keys();
+    std::sort(std::begin(metaDataKeys), std::end(metaDataKeys));
+
+    auto result = QStringList { providerId };
+    for (const auto& metaDataKey : metaDataKeys)
+    {
+        result.append(metaDataKey + QLatin1Char { '=' } + metaData.value(metaDataKey).toString());
+    }
+    return result.join(QLatin1Char { '\n' });
+}
+
+bool TimeSeriesCache::isCacheable(const TimeSeries::ITimeSerie& serie) noexcept
+{
+    return dynamic_cast<const ScalarTimeSerie*>(&serie)
+        || dynamic_cast<const VectorTimeSerie*>(&serie)
+        || dynamic_cast<const SpectrogramTimeSerie*>(&serie);
+}
+
+TimeSeries::ITimeSerie* TimeSeriesCache::merge(
+    std::vector<Slice> slices, const DateTimeRange& range)
+{
+    if (slices.empty())
+    {
+        return nullptr;
+    }
+
+    std::sort(std::begin(slices), std::end(slices), [](const auto& slice, const auto& other) {
+        return slice.m_Range.m_TStart < other.m_Range.m_TStart;
+    });
+
+    const auto& serie = *slices.front().m_Data;
+    if (dynamic_cast<const ScalarTimeSerie*>(&serie))
+    {
+        return mergeSeries<ScalarTimeSerie>(slices, range).release();
+    }
+    if (dynamic_cast<const VectorTimeSerie*>(&serie))
+    {
+        return mergeSeries<VectorTimeSerie>(slices, range).release();
+    }
+    if (dynamic_cast<const SpectrogramTimeSerie*>(&serie))
+    {
+        return mergeSpectrograms(slices, range).release();
+    }
+
+    qCWarning(LOG_TimeSeriesCache()) << QObject::tr("Can't merge slices: unsupported serie type");
+    return nullptr;
+}
+
+bool TimeSeriesCache::isEnabled() const noexcept
+{
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+    return impl->m_MemoryBudget > 0;
+}
+
+TimeSeriesCache::Lookup TimeSeriesCache::lookup(const QString& key, const DateTimeRange& range)
+{
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+
+    auto result = Lookup {};
+    auto missingStart = range.m_TStart;
+    auto productIt = impl->m_Products.find(key);
+    if (productIt != std::end(impl->m_Products))
+    {
+        for (auto& [start, entry] : productIt->second)
+        {
+            const auto& entryRange = entry.m_Slice.m_Range;
+            if (start > range.m_TEnd)
+            {
+                break;
+            }
+            if (!intersectsOrTouches(entryRange, range))
+            {
+                continue;
+            }
+
+            entry.m_LastUse = ++impl->m_UseCounter;
+            result.m_Slices.push_back(entry.m_Slice);
+            if (entryRange.m_TStart > missingStart)
+            {
+                result.m_MissingRanges.push_back({ missingStart, entryRange.m_TStart });
+            }
+            missingStart = std::max(missingStart, entryRange.m_TEnd);
+        }
+    }
+
+    if (missingStart < range.m_TEnd || result.m_Slices.empty())
+    {
+        result.m_MissingRanges.push_back({ missingStart, range.m_TEnd });
+    }
+    return result;
+}
+
+void TimeSeriesCache::insert(const QString& key, const Slice& slice)
+{
+    if (!slice.m_Data || !isCacheable(*slice.m_Data))
+    {
+        return;
+    }
+    auto memorySize = sliceMemorySize(*slice.m_Data);
+
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+
+    // A slice that doesn't fit in the budget isn't stored, instead of evicting all the others
+    if (impl->m_MemoryBudget == 0 || memorySize > impl->m_MemoryBudget)
+    {
+        return;
+    }
+
+    // The slice replaces the entries it covers. The entries it overlaps partially are kept as they
+    // are, the range of the slice being reduced to what they don't cover, so that no data is copied
+    auto& entries = impl->m_Products[key];
+    auto range = slice.m_Range;
+    for (auto it = std::begin(entries); it != std::end(entries);)
+    {
+        const auto& entryRange = it->second.m_Slice.m_Range;
+        if (slice.m_Range.m_TStart <= entryRange.m_TStart
+            && entryRange.m_TEnd <= slice.m_Range.m_TEnd)
+        {
+            impl->m_MemoryUsed -= it->second.m_MemorySize;
+            it = entries.erase(it);
+            continue;
+        }
+
+        if (entryRange.m_TStart < range.m_TStart && range.m_TStart < entryRange.m_TEnd)
+        {
+            range.m_TStart = entryRange.m_TEnd;
+        }
+        if (entryRange.m_TStart < range.m_TEnd && range.m_TEnd < entryRange.m_TEnd)
+        {
+            range.m_TEnd = entryRange.m_TStart;
+        }
+        ++it;
+    }
+
+    // The slice brings nothing if its range is covered by the entries
+    if (range.m_TStart < range.m_TEnd)
+    {
+        entries[range.m_TStart] = Entry { Slice { range, slice.m_Data }, memorySize,
+            ++impl->m_UseCounter };
+        impl->m_MemoryUsed += memorySize;
+    }
+    if (entries.empty())
+    {
+        impl->m_Products.erase(key);
+    }
+
+    impl->evict();
+}
+
+std::size_t TimeSeriesCache::memoryBudget() const noexcept
+{
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+    return impl->m_MemoryBudget;
+}
+
+void TimeSeriesCache::setMemoryBudget(std::size_t memoryBudget)
+{
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+    impl->m_MemoryBudget = memoryBudget;
+    impl->evict();
+}
+
+void TimeSeriesCache::clear()
+{
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+    impl->m_Products.clear();
+    impl->m_MemoryUsed = 0;
+}
@@ -0,0 +1,727 @@
+#include "DataSource/TimeSeriesDiskCache.h"
+
+#include <Data/ScalarTimeSerie.h>
+#include <Data/SpectrogramTimeSerie.h>
+#include <Data/VectorTimeSerie.h>
+#include <Settings/SqpSettingsGuiDefs.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QUuid>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <type_traits>
+
+Q_LOGGING_CATEGORY(LOG_TimeSeriesDiskCache, "TimeSeriesDiskCache")
+
+namespace
+{
+
+/// Bytes in a MB, the unit of the budget in the settings
+const auto BYTES_PER_MB = std::size_t { 1024 * 1024 };
+
+/// Name of the directory of the cache, in the cache location of the application
+const auto CACHE_DIRECTORY_NAME = QStringLiteral("timeseries");
+
+/// Name of the index file, in the directory of the cache
+const auto INDEX_FILE_NAME = QStringLiteral("index.json");
+
+/// Name of the journal of the index, in the directory of the cache. Slices written since the index
+/// file was last written are appended to it, one JSON object per line
+const auto JOURNAL_FILE_NAME = QStringLiteral("index.journal");
+
+/// Number of slices in the journal above which the index file is written again
+const auto MAX_JOURNAL_SLICES = 256;
+
+/// Extension of the slice files
+const auto SLICE_FILE_EXTENSION = QStringLiteral(".ts");
+
+/// Version of the layout of the files. Files of another version are ignored
+const auto FORMAT_VERSION = 2;
+
+/// Keys of the index file
+const auto VERSION_KEY = QStringLiteral("version");
+const auto PRODUCTS_KEY = QStringLiteral("products");
+const auto PRODUCT_KEY_KEY = QStringLiteral("key");
+const auto SLICES_KEY = QStringLiteral("slices");
+const auto FILE_KEY = QStringLiteral("file");
+const auto START_KEY = QStringLiteral("start");
+const auto END_KEY = QStringLiteral("end");
+const auto SIZE_KEY = QStringLiteral("size");
+const auto LAST_USE_KEY = QStringLiteral("lastUse");
+
+/// Magic at the beginning of a slice file
+const char SLICE_FILE_MAGIC[8] = { 'S', 'Q', 'P', 'T', 'S', 'E', 'R', '1' };
+
+/// Type of the serie stored in a slice file
+enum class SerieType : quint32
+{
+    Scalar = 0,
+    Vector = 1,
+    Spectrogram = 2
+};
+
+/// Header of a slice file, followed by the time axis then the values. The values of spectrograms
+/// are followed by their y-axis, one value per band
+struct SliceFileHeader
+{
+    char m_Magic[8];
+    SerieType m_Type;
+    quint32 m_ValuesPerSample;
+    quint64 m_Count;
+    double m_TStart;
+    double m_TEnd;
+    /// Samplings and scale of the y-axis of spectrograms
+    double m_MinSampling;
+    double m_MaxSampling;
+    quint32 m_YIsLog;
+    quint32 m_Reserved;
+};
+static_assert(std::is_trivially_copyable_v<SliceFileHeader>);
+
+/// Slice of a product stored on disk
+struct SliceFile
+{
+    QString m_FileName;
+    DateTimeRange m_Range;
+    qint64 m_Size;
+    /// Last time the slice was written or read, in ms since epoch
+    qint64 m_LastUse;
+};
+
+bool intersectsOrTouches(const DateTimeRange& range, const DateTimeRange& other) noexcept
+{
+    return range.m_TStart <= other.m_TEnd && other.m_TStart <= range.m_TEnd;
+}
+
+/// Creates the header of a slice file
+SliceFileHeader sliceFileHeader(
+    SerieType type, quint32 valuesPerSample, std::size_t count, const DateTimeRange& range)
+{
+    auto header = SliceFileHeader {};
+    std::memcpy(header.m_Magic, SLICE_FILE_MAGIC, sizeof(SLICE_FILE_MAGIC));
+    header.m_Type = type;
+    header.m_ValuesPerSample = valuesPerSample;
+    header.m_Count = count;
+    header.m_TStart = range.m_TStart;
+    header.m_TEnd = range.m_TEnd;
+    header.m_MinSampling = std::numeric_limits<double>::quiet_NaN();
+    header.m_MaxSampling = std::numeric_limits<double>::quiet_NaN();
+    return header;
+}
+
+/// Writes a slice file: its header, then its columns
+bool writeColumns(QIODevice& device, const SliceFileHeader& header, const double* times,
+    const double* values, const std::vector<double>& yAxis = {})
+{
+    auto write = [&device](const void* data, std::size_t size) {
+        return size == 0
+            || device.write(reinterpret_cast<const char*>(data), static_cast<qint64>(size))
+            == static_cast<qint64>(size);
+    };
+
+    return write(&header, sizeof(header)) && write(times, header.m_Count * sizeof(double))
+        && write(values, header.m_Count * header.m_ValuesPerSample * sizeof(double))
+        && write(yAxis.data(), yAxis.size() * sizeof(double));
+}
+
+/// Converts a slice file to the JSON object that stores it in the index
+QJsonObject toJson(const SliceFile& sliceFile)
+{
+    return QJsonObject { { FILE_KEY, sliceFile.m_FileName },
+        { START_KEY, sliceFile.m_Range.m_TStart }, { END_KEY, sliceFile.m_Range.m_TEnd },
+        { SIZE_KEY, static_cast<double>(sliceFile.m_Size) },
+        { LAST_USE_KEY, static_cast<double>(sliceFile.m_LastUse) } };
+}
+
+SliceFile sliceFileFromJson(const QJsonObject& slice)
+{
+    return SliceFile { slice.value(FILE_KEY).toString(),
+        { slice.value(START_KEY).toDouble(), slice.value(END_KEY).toDouble() },
+        static_cast<qint64>(slice.value(SIZE_KEY).toDouble()),
+        static_cast<qint64>(slice.value(LAST_USE_KEY).toDouble()) };
+}
+
+/// Creates a serie from the columns of a mapped slice file
+template <typename T, typename MakeSampleFun>
+std::shared_ptr<T> readColumns(
+    const double* times, const double* values, std::size_t count, MakeSampleFun makeSample)
+{
+    auto serie = std::make_shared<T>(count);
+    std::generate(std::begin(*serie), std::end(*serie),
+        [times, values, makeSample, i = std::size_t { 0 }]() mutable {
+            auto sample = makeSample(times[i], values, i);
+            ++i;
+            return sample;
+        });
+    return serie;
+}
+
+} // namespace
+
+class TimeSeriesDiskCache::TimeSeriesDiskCachePrivate
+{
+public:
+    explicit TimeSeriesDiskCachePrivate(const QString& directory)
+            : m_Directory { directory }
+            , m_DiskBudget { QSettings {}
+                                 .value(DATA_CACHE_DISK_BUDGET_KEY,
+                                     DATA_CACHE_DISK_BUDGET_DEFAULT_VALUE)
+                                 .toULongLong()
+                  * BYTES_PER_MB }
+    {
+    }
+
+    ~TimeSeriesDiskCachePrivate()
+    {
+        // Last uses and removals of slices are only written with the index
+        if (m_IsIndexDirty)
+        {
+            saveIndex();
+        }
+    }
+
+    QString filePath(const QString& fileName) const
+    {
+        return m_Directory.absoluteFilePath(fileName);
+    }
+
+    /// Removes the slice files that aren't in the index, left by a session that couldn't update it
+    void removeOrphanFiles() const
+    {
+        auto indexedFiles = std::set<QString> {};
+        for (const auto& [key, sliceFiles] : m_Products)
+        {
+            for (const auto& sliceFile : sliceFiles)
+            {
+                indexedFiles.insert(sliceFile.m_FileName);
+            }
+        }
+
+        for (const auto& fileName :
+            m_Directory.entryList({ QLatin1Char { '*' } + SLICE_FILE_EXTENSION }, QDir::Files))
+        {
+            if (indexedFiles.find(fileName) == indexedFiles.cend())
+            {
+                QFile::remove(filePath(fileName));
+            }
+        }
+    }
+
+    /// Adds a slice read from the index or its journal, if its file exists
+    void addSliceFile(const QString& key, const SliceFile& sliceFile)
+    {
+        if (QFile::exists(filePath(sliceFile.m_FileName)))
+        {
+            m_DiskUsed += sliceFile.m_Size;
+            m_Products[key].push_back(sliceFile);
+        }
+    }
+
+    /// Reads the index file and its journal the first time the cache is used. Must be called with
+    /// the mutex locked
+    void ensureIndexLoaded()
+    {
+        if (m_IsIndexLoaded)
+        {
+            return;
+        }
+        m_IsIndexLoaded = true;
+
+        if (!m_Directory.mkpath(QStringLiteral(".")))
+        {
+            qCWarning(LOG_TimeSeriesDiskCache())
+                << QObject::tr("Can't create cache directory %1").arg(m_Directory.path());
+            return;
+        }
+
+        QFile indexFile { filePath(INDEX_FILE_NAME) };
+        if (indexFile.open(QFile::ReadOnly))
+        {
+            auto index = QJsonDocument::fromJson(indexFile.readAll()).object();
+            if (index.value(VERSION_KEY).toInt() != FORMAT_VERSION)
+            {
+                qCInfo(LOG_TimeSeriesDiskCache())
+                    << QObject::tr("Cache index of another version, the cache is reset");
+                QFile::remove(filePath(JOURNAL_FILE_NAME));
+                removeOrphanFiles();
+                return;
+            }
+
+            for (const auto& productValue : index.value(PRODUCTS_KEY).toArray())
+            {
+                auto product = productValue.toObject();
+                auto key = product.value(PRODUCT_KEY_KEY).toString();
+                for (const auto& sliceValue : product.value(SLICES_KEY).toArray())
+                {
+                    addSliceFile(key, sliceFileFromJson(sliceValue.toObject()));
+                }
+            }
+        }
+
+        // Slices of the journal are then moved to the index file
+        QFile journalFile { filePath(JOURNAL_FILE_NAME) };
+        auto hasJournal = journalFile.open(QFile::ReadOnly);
+        while (hasJournal && !journalFile.atEnd())
+        {
+            auto slice = QJsonDocument::fromJson(journalFile.readLine()).object();
+            if (!slice.isEmpty())
+            {
+                addSliceFile(slice.value(PRODUCT_KEY_KEY).toString(), sliceFileFromJson(slice));
+            }
+        }
+
+        removeOrphanFiles();
+        if (hasJournal)
+        {
+            journalFile.close();
+            saveIndex();
+        }
+    }
+
+    /// Writes the index file, and empties its journal. Must be called with the mutex locked
+    void saveIndex()
+    {
+        auto products = QJsonArray {};
+        for (const auto& [key, sliceFiles] : m_Products)
+        {
+            auto slices = QJsonArray {};
+            for (const auto& sliceFile : sliceFiles)
+            {
+                slices.append(toJson(sliceFile));
+            }
+            products.append(QJsonObject { { PRODUCT_KEY_KEY, key }, { SLICES_KEY, slices } });
+        }
+
+        QSaveFile indexFile { filePath(INDEX_FILE_NAME) };
+        if (!indexFile.open(QFile::WriteOnly)
+            || indexFile.write(QJsonDocument { QJsonObject {
+                                   { VERSION_KEY, FORMAT_VERSION }, { PRODUCTS_KEY, products } } }
+                                   .toJson(QJsonDocument::Compact))
+                < 0
+            || !indexFile.commit())
+        {
+            qCWarning(LOG_TimeSeriesDiskCache())
+                << QObject::tr("Can't write cache index: %1").arg(indexFile.errorString());
+            return;
+        }
+
+        QFile::remove(filePath(JOURNAL_FILE_NAME));
+        m_JournalSlices = 0;
+        m_IsIndexDirty = false;
+    }
+
+    /// Appends a slice to the journal of the index, instead of writing the whole index. Must be
+    /// called with the mutex locked
+    void appendToJournal(const QString& key, const SliceFile& sliceFile)
+    {
+        if (m_JournalSlices >= MAX_JOURNAL_SLICES)
+        {
+            saveIndex();
+            return;
+        }
+
+        auto slice = toJson(sliceFile);
+        slice.insert(PRODUCT_KEY_KEY, key);
+        QFile journalFile { filePath(JOURNAL_FILE_NAME) };
+        if (!journalFile.open(QFile::WriteOnly | QFile::Append)
+            || journalFile.write(QJsonDocument { slice }.toJson(QJsonDocument::Compact) + '\n')
+                < 0)
+        {
+            qCWarning(LOG_TimeSeriesDiskCache())
+                << QObject::tr("Can't write cache journal: %1").arg(journalFile.errorString());
+            saveIndex();
+            return;
+        }
+        ++m_JournalSlices;
+    }
+
+    /// Removes the least recently used slices until the size of the files fits the budget. Must be
+    /// called with the mutex locked
+    void evict()
+    {
+        while (m_DiskUsed > m_DiskBudget)
+        {
+            auto lruProduct = std::end(m_Products);
+            auto lruSlice = std::vector<SliceFile>::iterator {};
+            for (auto productIt = std::begin(m_Products); productIt != std::end(m_Products);
+                 ++productIt)
+            {
+                for (auto sliceIt = std::begin(productIt->second);
+                     sliceIt != std::end(productIt->second); ++sliceIt)
+                {
+                    if (lruProduct == std::end(m_Products)
+                        || sliceIt->m_LastUse < lruSlice->m_LastUse)
+                    {
+                        lruProduct = productIt;
+                        lruSlice = sliceIt;
+                    }
+                }
+            }
+
+            if (lruProduct == std::end(m_Products))
+            {
+                break;
+            }
+
+            // The index keeps the slice until it is written: slices whose file doesn't exist are
+            // ignored when it is read
+            QFile::remove(filePath(lruSlice->m_FileName));
+            m_DiskUsed -= lruSlice->m_Size;
+            m_IsIndexDirty = true;
+            lruProduct->second.erase(lruSlice);
+            if (lruProduct->second.empty())
+            {
+                m_Products.erase(lruProduct);
+            }
+        }
+    }
+
+    /// Selects the slices of a product to read for a range, in the order of their start, and
+    /// updates their last use. Must be called with the mutex locked
+    std::vector<SliceFile> slicesToRead(const QString& key, const DateTimeRange& range)
+    {
+        auto result = std::vector<SliceFile> {};
+        auto productIt = m_Products.find(key);
+        if (productIt == std::end(m_Products))
+        {
+            return result;
+        }
+
+        // Slices of a product may overlap: they are read in the order of their start, skipping
+        // the ones that bring nothing new
+        auto& sliceFiles = productIt->second;
+        std::sort(std::begin(sliceFiles), std::end(sliceFiles),
+            [](const auto& sliceFile, const auto& other) {
+                return sliceFile.m_Range.m_TStart < other.m_Range.m_TStart;
+            });
+
+        auto missingStart = range.m_TStart;
+        auto now = QDateTime::currentMSecsSinceEpoch();
+        for (auto& sliceFile : sliceFiles)
+        {
+            if (!intersectsOrTouches(sliceFile.m_Range, range)
+                || (sliceFile.m_Range.m_TEnd <= missingStart && !result.empty()))
+            {
+                continue;
+            }
+
+            // Last uses are written with the index, not on each lookup
+            sliceFile.m_LastUse = now;
+            m_IsIndexDirty = true;
+            result.push_back(sliceFile);
+            missingStart = std::max(missingStart, sliceFile.m_Range.m_TEnd);
+        }
+        return result;
+    }
+
+    /// Removes the slices of a product whose range is covered by @p range, as they are replaced by
+    /// the slice of this range. Must be called with the mutex locked
+    void removeCoveredSlices(const QString& key, const DateTimeRange& range)
+    {
+        auto productIt = m_Products.find(key);
+        if (productIt == std::end(m_Products))
+        {
+            return;
+        }
+
+        auto& sliceFiles = productIt->second;
+        for (auto sliceIt = std::begin(sliceFiles); sliceIt != std::end(sliceFiles);)
+        {
+            if (range.m_TStart <= sliceIt->m_Range.m_TStart
+                && sliceIt->m_Range.m_TEnd <= range.m_TEnd)
+            {
+                // As for evicted slices, the index keeps the slice until it is written
+                QFile::remove(filePath(sliceIt->m_FileName));
+                m_DiskUsed -= sliceIt->m_Size;
+                m_IsIndexDirty = true;
+                sliceIt = sliceFiles.erase(sliceIt);
+            }
+            else
+            {
+                ++sliceIt;
+            }
+        }
+    }
+
+    /// Reads a slice file by mapping it in memory
+    std::shared_ptr<TimeSeries::ITimeSerie> readSlice(const SliceFile& sliceFile) const
+    {
+        QFile file { filePath(sliceFile.m_FileName) };
+        if (!file.open(QFile::ReadOnly))
+        {
+            qCWarning(LOG_TimeSeriesDiskCache())
+                << QObject::tr("Can't open cache file %1").arg(file.fileName());
+            return nullptr;
+        }
+
+        auto size = static_cast<std::size_t>(file.size());
+        auto data = file.map(0, file.size());
+        if (!data || size < sizeof(SliceFileHeader))
+        {
+            qCWarning(LOG_TimeSeriesDiskCache())
+                << QObject::tr("Can't map cache file %1").arg(file.fileName());
+            return nullptr;
+        }
+
+        auto header = SliceFileHeader {};
+        std::memcpy(&header, data, sizeof(header));
+        auto yAxisSize = header.m_Type == SerieType::Spectrogram ? header.m_ValuesPerSample : 0;
+        auto expectedSize = sizeof(header)
+            + (header.m_Count * (1 + header.m_ValuesPerSample) + yAxisSize) * sizeof(double);
+        if (std::memcmp(header.m_Magic, SLICE_FILE_MAGIC, sizeof(SLICE_FILE_MAGIC)) != 0
+            || size != expectedSize)
+        {
+            qCWarning(LOG_TimeSeriesDiskCache())
+                << QObject::tr("Invalid cache file %1").arg(file.fileName());
+            return nullptr;
+        }
+
+        // Columns follow the header, which keeps them aligned on doubles
+        auto times = reinterpret_cast<const double*>(data + sizeof(header));
+        auto values = times + header.m_Count;
+
+        auto result = std::shared_ptr<TimeSeries::ITimeSerie> {};
+        switch (header.m_Type)
+        {
+            case SerieType::Scalar:
+                result = readColumns<ScalarTimeSerie>(times, values, header.m_Count,
+                    [](double time, const double* columns, std::size_t i) {
+                        return std::pair<double, double> { time, columns[i] };
+                    });
+                break;
+            case SerieType::Vector:
+                result = readColumns<VectorTimeSerie>(times, values, header.m_Count,
+                    [](double time, const double* columns, std::size_t i) {
+                        return std::pair<double, VectorTimeSerie::raw_value_type> { time,
+                            { columns[3 * i], columns[3 * i + 1], columns[3 * i + 2] } };
+                    });
+                break;
+            case SerieType::Spectrogram:
+            {
+                auto valueCount = header.m_Count * header.m_ValuesPerSample;
+                auto yAxis = values + valueCount;
+                auto shape = std::vector<std::size_t> { header.m_Count, header.m_ValuesPerSample };
+                result = std::make_shared<SpectrogramTimeSerie>(
+                    std::vector<double>(times, times + header.m_Count),
+                    std::vector<double>(yAxis, yAxis + header.m_ValuesPerSample),
+                    std::vector<double>(values, values + valueCount), shape,
+                    header.m_MinSampling, header.m_MaxSampling, header.m_YIsLog != 0);
+                break;
+            }
+            default:
+                qCWarning(LOG_TimeSeriesDiskCache())
+                    << QObject::tr("Unknown serie type in cache file %1").arg(file.fileName());
+                break;
+        }
+
+        file.unmap(data);
+        return result;
+    }
+
+    /// Writes a slice in a new file
+    bool writeSlice(const TimeSeriesCache::Slice& slice, const QString& fileName) const
+    {
+        QSaveFile file { filePath(fileName) };
+        if (!file.open(QFile::WriteOnly))
+        {
+            return false;
+        }
+
+        auto result = false;
+        if (auto scalarSerie = std::dynamic_pointer_cast<ScalarTimeSerie>(slice.m_Data))
+        {
+            auto& serie = *scalarSerie;
+            auto times = serie.axis(0);
+            result = writeColumns(file,
+                sliceFileHeader(SerieType::Scalar, 1, serie.size(), slice.m_Range), times.data(),
+                serie.size() > 0 ? &(*std::begin(serie)).v() : nullptr);
+        }
+        else if (auto vectorSerie = std::dynamic_pointer_cast<VectorTimeSerie>(slice.m_Data))
+        {
+            static_assert(sizeof(VectorTimeSerie::raw_value_type) == 3 * sizeof(double),
+                "Vector components must be contiguous");
+            auto& serie = *vectorSerie;
+            auto times = serie.axis(0);
+            result = writeColumns(file,
+                sliceFileHeader(SerieType::Vector, 3, serie.size(), slice.m_Range), times.data(),
+                serie.size() > 0 ? &(*std::begin(serie)).v().x : nullptr);
+        }
+        else if (auto spectrogram
+            = std::dynamic_pointer_cast<SpectrogramTimeSerie>(slice.m_Data))
+        {
+            // Values of the lines are gathered, as lines only give access to their values one by
+            // one
+            auto& serie = *spectrogram;
+            auto times = serie.axis(0);
+            auto yAxis = serie.axis(1);
+            auto values = std::vector<double> {};
+            values.reserve(times.size() * yAxis.size());
+            for (auto&& line : serie)
+            {
+                for (const auto& item : line)
+                {
+                    values.push_back(item.v());
+                }
+            }
+
+            auto header = sliceFileHeader(SerieType::Spectrogram,
+                static_cast<quint32>(yAxis.size()), times.size(), slice.m_Range);
+            header.m_MinSampling = serie.min_sampling;
+            header.m_MaxSampling = serie.max_sampling;
+            header.m_YIsLog = serie.y_is_log ? 1 : 0;
+            result = writeColumns(file, header, times.data(), values.data(), yAxis);
+        }
+
+        return result && file.commit();
+    }
+
+    QDir m_Directory;
+    mutable std::mutex m_Mutex;
+    bool m_IsIndexLoaded { false };
+    /// The index file misses changes that aren't in the journal (last uses, removed slices)
+    bool m_IsIndexDirty { false };
+    int m_JournalSlices { 0 };
+    std::map<QString, std::vector<SliceFile>> m_Products;
+    std::size_t m_DiskBudget;
+    std::size_t m_DiskUsed { 0 };
+};
+
+TimeSeriesDiskCache::TimeSeriesDiskCache(const QString& directory)
+        : impl { spimpl::make_unique_impl<TimeSeriesDiskCachePrivate>(directory) }
+{
+}
+
+QString TimeSeriesDiskCache::defaultDirectory()
+{
+    return QDir { QStandardPaths::writableLocation(QStandardPaths::CacheLocation) }
+        .absoluteFilePath(CACHE_DIRECTORY_NAME);
+}
+
+bool TimeSeriesDiskCache::isEnabled() const noexcept
+{
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+    return impl->m_DiskBudget > 0;
+}
+
+TimeSeriesCache::Lookup TimeSeriesDiskCache::lookup(const QString& key, const DateTimeRange& range)
+{
+    // Files are read without the mutex locked, so that the other threads don't wait for the disk
+    auto sliceFiles = std::vector<SliceFile> {};
+    {
+        std::lock_guard<std::mutex> lock { impl->m_Mutex };
+        impl->ensureIndexLoaded();
+        sliceFiles = impl->slicesToRead(key, range);
+    }
+
+    auto result = TimeSeriesCache::Lookup {};
+    auto missingStart = range.m_TStart;
+    for (const auto& sliceFile : sliceFiles)
+    {
+        // A slice replaced or evicted since it was selected can't be read: its range is missing
+        if (auto data = impl->readSlice(sliceFile))
+        {
+            result.m_Slices.push_back({ sliceFile.m_Range, std::move(data) });
+            if (sliceFile.m_Range.m_TStart > missingStart)
+            {
+                result.m_MissingRanges.push_back({ missingStart, sliceFile.m_Range.m_TStart });
+            }
+            missingStart = std::max(missingStart, sliceFile.m_Range.m_TEnd);
+        }
+    }
+
+    if (result.m_Slices.empty())
+    {
+        result.m_MissingRanges = { range };
+    }
+    else if (missingStart < range.m_TEnd)
+    {
+        result.m_MissingRanges.push_back({ missingStart, range.m_TEnd });
+    }
+    return result;
+}
+
+void TimeSeriesDiskCache::insert(const QString& key, const TimeSeriesCache::Slice& slice)
+{
+    // Empty results aren't stored: the range would be served empty from one session to another,
+    // even once data is available
+    if (!slice.m_Data || slice.m_Data->size() == 0 || !TimeSeriesCache::isCacheable(*slice.m_Data))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock { impl->m_Mutex };
+        if (impl->m_DiskBudget == 0)
+        {
+            return;
+        }
+        impl->ensureIndexLoaded();
+    }
+
+    // The file is written without the mutex locked: its name is unique, so no other thread
+    // accesses it before it is added to the index
+    auto fileName = QUuid::createUuid().toString(QUuid::WithoutBraces) + SLICE_FILE_EXTENSION;
+    if (!impl->writeSlice(slice, fileName))
+    {
+        qCWarning(LOG_TimeSeriesDiskCache())
+            << QObject::tr("Can't write cache file %1").arg(impl->filePath(fileName));
+        return;
+    }
+
+    auto size = QFileInfo { impl->filePath(fileName) }.size();
+    auto sliceFile
+        = SliceFile { fileName, slice.m_Range, size, QDateTime::currentMSecsSinceEpoch() };
+
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+    impl->removeCoveredSlices(key, slice.m_Range);
+    impl->m_Products[key].push_back(sliceFile);
+    impl->m_DiskUsed += size;
+
+    impl->evict();
+    impl->appendToJournal(key, sliceFile);
+}
+
+std::size_t TimeSeriesDiskCache::diskBudget() const noexcept
+{
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+    return impl->m_DiskBudget;
+}
+
+void TimeSeriesDiskCache::setDiskBudget(std::size_t diskBudget)
+{
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+    impl->m_DiskBudget = diskBudget;
+    impl->ensureIndexLoaded();
+    impl->evict();
+    impl->saveIndex();
+}
+
+void TimeSeriesDiskCache::clear()
+{
+    std::lock_guard<std::mutex> lock { impl->m_Mutex };
+    impl->ensureIndexLoaded();
+    for (const auto& [key, sliceFiles] : impl->m_Products)
+    {
+        for (const auto& sliceFile : sliceFiles)
+        {
+            QFile::remove(impl->filePath(sliceFile.m_FileName));
+        }
+    }
+    impl->m_Products.clear();
+    impl->m_DiskUsed = 0;
+    impl->saveIndex();
+}
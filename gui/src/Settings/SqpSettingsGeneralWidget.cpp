@@ -1,6 +1,11 @@
 #include "Settings/SqpSettingsGeneralWidget.h"
 
+#include "DataSource/TimeSeriesCache.h"
+#include "DataSource/TimeSeriesDiskCache.h"
 #include "Settings/SqpSettingsDefs.h"
+#include "Settings/SqpSettingsGuiDefs.h"
+#include "SqpApplication.h"
+#include "Visualization/ReplotScheduler.h"
 
 #include "ui_SqpSettingsGeneralWidget.h"
 
@@ -14,6 +19,12 @@ SqpSettingsGeneralWidget::SqpSettingsGeneralWidget(QWidget *parent)
     ui->toleranceInitSpinBox->setMaximum(std::numeric_limits<double>::max());
     ui->toleranceUpdateSpinBox->setMinimum(0.);
     ui->toleranceUpdateSpinBox->setMaximum(std::numeric_limits<double>::max());
+    ui->frameBudgetSpinBox->setMinimum(0);
+    ui->frameBudgetSpinBox->setMaximum(1000);
+    ui->cacheBudgetSpinBox->setMinimum(0);
+    ui->cacheBudgetSpinBox->setMaximum(1024 * 1024);
+    ui->diskCacheBudgetSpinBox->setMinimum(0);
+    ui->diskCacheBudgetSpinBox->setMaximum(std::numeric_limits<int>::max());
 }
 
 SqpSettingsGeneralWidget::~SqpSettingsGeneralWidget() noexcept
@@ -35,6 +46,15 @@ void SqpSettingsGeneralWidget::loadSettings()
         loadTolerance(GENERAL_TOLERANCE_AT_INIT_KEY, GENERAL_TOLERANCE_AT_INIT_DEFAULT_VALUE));
     ui->toleranceUpdateSpinBox->setValue(
         loadTolerance(GENERAL_TOLERANCE_AT_UPDATE_KEY, GENERAL_TOLERANCE_AT_UPDATE_DEFAULT_VALUE));
+    ui->frameBudgetSpinBox->setValue(
+        settings
+            .value(VISUALIZATION_FRAME_BUDGET_KEY, VISUALIZATION_FRAME_BUDGET_DEFAULT_VALUE)
+            .toInt());
+    ui->cacheBudgetSpinBox->setValue(
+        settings.value(DATA_CACHE_MEMORY_BUDGET_KEY, DATA_CACHE_MEMORY_BUDGET_DEFAULT_VALUE)
+            .toInt());
+    ui->diskCacheBudgetSpinBox->setValue(
+        settings.value(DATA_CACHE_DISK_BUDGET_KEY, DATA_CACHE_DISK_BUDGET_DEFAULT_VALUE).toInt());
 }
 
 void SqpSettingsGeneralWidget::saveSettings() const
@@ -48,4 +68,16 @@ void SqpSettingsGeneralWidget::saveSettings() const
 
     saveTolerance(GENERAL_TOLERANCE_AT_INIT_KEY, ui->toleranceInitSpinBox->value());
     saveTolerance(GENERAL_TOLERANCE_AT_UPDATE_KEY, ui->toleranceUpdateSpinBox->value());
+
+    // Frame budget is applied immediately to the plots
+    settings.setValue(VISUALIZATION_FRAME_BUDGET_KEY, ui->frameBudgetSpinBox->value());
+    sqpApp->replotScheduler().setFrameBudget(ui->frameBudgetSpinBox->value());
+
+    // Cache budgets are converted from MB and applied immediately, evicting data if necessary
+    settings.setValue(DATA_CACHE_MEMORY_BUDGET_KEY, ui->cacheBudgetSpinBox->value());
+    sqpApp->timeSeriesCache().setMemoryBudget(
+        static_cast<std::size_t>(ui->cacheBudgetSpinBox->value()) * 1024 * 1024);
+    settings.setValue(DATA_CACHE_DISK_BUDGET_KEY, ui->diskCacheBudgetSpinBox->value());
+    sqpApp->timeSeriesDiskCache().setDiskBudget(
+        static_cast<std::size_t>(ui->diskCacheBudgetSpinBox->value()) * 1024 * 1024);
 }
@@ -0,0 +1,18 @@
+#include "Settings/SqpSettingsGuiDefs.h"
+
+// ////////////////////// //
+// Visualization settings //
+// ////////////////////// //
+
+const QString VISUALIZATION_FRAME_BUDGET_KEY = QStringLiteral("Visualization/frameBudget");
+const int VISUALIZATION_FRAME_BUDGET_DEFAULT_VALUE = 12;
+
+// /////////////////// //
+// Data cache settings //
+// /////////////////// //
+
+const QString DATA_CACHE_MEMORY_BUDGET_KEY = QStringLiteral("DataCache/memoryBudget");
+const int DATA_CACHE_MEMORY_BUDGET_DEFAULT_VALUE = 512;
+
+const QString DATA_CACHE_DISK_BUDGET_KEY = QStringLiteral("DataCache/diskBudget");
+const int DATA_CACHE_DISK_BUDGET_DEFAULT_VALUE = 4096;
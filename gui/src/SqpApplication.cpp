@@ -4,12 +4,16 @@
 #include <Catalogue/CatalogueController.h>
 #include <Data/IDataProvider.h>
 #include <DataSource/DataSourceController.h>
+#include <DataSource/TimeSeriesCache.h>
+#include <DataSource/TimeSeriesDiskCache.h>
 #include <DragAndDrop/DragDropGuiController.h>
 #include <Network/NetworkController.h>
 #include <QThread>
 #include <Time/TimeController.h>
 #include <Variable/VariableController2.h>
 #include <Variable/VariableModel2.h>
+#include <Visualization/RangeChangeBroadcaster.h>
+#include <Visualization/ReplotScheduler.h>
 
 Q_LOGGING_CATEGORY(LOG_SqpApplication, "SqpApplication")
 
@@ -63,6 +67,10 @@ public:
 
     DragDropGuiController m_DragDropGuiController;
     ActionsGuiController m_ActionsGuiController;
+    ReplotScheduler m_ReplotScheduler;
+    RangeChangeBroadcaster m_RangeChangeBroadcaster;
+    TimeSeriesCache m_TimeSeriesCache;
+    TimeSeriesDiskCache m_TimeSeriesDiskCache;
 
     SqpApplication::PlotsInteractionMode m_PlotInterractionMode;
     SqpApplication::PlotsCursorMode m_PlotCursorMode;
@@ -135,6 +143,26 @@ ActionsGuiController& SqpApplication::actionsGuiController() noexcept
     return impl->m_ActionsGuiController;
 }
 
+ReplotScheduler& SqpApplication::replotScheduler() noexcept
+{
+    return impl->m_ReplotScheduler;
+}
+
+RangeChangeBroadcaster& SqpApplication::rangeChangeBroadcaster() noexcept
+{
+    return impl->m_RangeChangeBroadcaster;
+}
+
+TimeSeriesCache& SqpApplication::timeSeriesCache() noexcept
+{
+    return impl->m_TimeSeriesCache;
+}
+
+TimeSeriesDiskCache& SqpApplication::timeSeriesDiskCache() noexcept
+{
+    return impl->m_TimeSeriesDiskCache;
+}
+
 SqpApplication::PlotsInteractionMode SqpApplication::plotsInteractionMode() const
 {
     return impl->m_PlotInterractionMode;
@@ -0,0 +1,250 @@
+#include "Visualization/GraphDataPyramid.h"
+
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace
+{
+
+/// Number of samples under which a level isn't built: drawing such a level is already cheap
+const auto MIN_LEVEL_SIZE = std::size_t { 2048 };
+
+/// Returns true if two values are equal, NaN values being considered equal
+bool isSameValue(double lhs, double rhs) noexcept
+{
+    return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+}
+
+/**
+ * Reduces the samples of @p data from @p begin to @p end (excluded) by keeping their min and max
+ * samples, in time order. NaN values are ignored, a bucket that only has NaN values gives a single
+ * NaN sample
+ * @param emit function called with (key, value) for each sample kept
+ */
+template <typename EmitFun>
+void reduceBucket(const TimeSeriesGraphData& data, std::size_t begin, std::size_t end, EmitFun emit)
+{
+    // If the bucket only has NaN values, min and max stay at end
+    auto minIndex = end, maxIndex = end;
+    for (auto index = begin; index < end; ++index)
+    {
+        auto value = data.value(index);
+        if (std::isnan(value))
+        {
+            continue;
+        }
+        if (minIndex == end || value < data.value(minIndex))
+        {
+            minIndex = index;
+        }
+        if (maxIndex == end || value > data.value(maxIndex))
+        {
+            maxIndex = index;
+        }
+    }
+
+    if (minIndex == end)
+    {
+        emit(data.key(begin), std::numeric_limits<double>::quiet_NaN());
+    }
+    else
+    {
+        // Min and max samples are kept in time order
+        auto first = std::min(minIndex, maxIndex), last = std::max(minIndex, maxIndex);
+        emit(data.key(first), data.value(first));
+        if (last != first)
+        {
+            emit(data.key(last), data.value(last));
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * Buffers of a level. Their capacity is fixed at construction: samples are appended without moving
+ * the ones already written, so that a pyramid can extend the buffers while the pyramids sharing
+ * them still read their own samples
+ */
+struct GraphDataPyramid::LevelBuffers
+{
+    explicit LevelBuffers(std::size_t capacity) : m_Keys(capacity), m_Values(capacity) {}
+
+    std::vector<double> m_Keys;
+    std::vector<double> m_Values;
+    /// Guards the writing of samples
+    std::mutex m_Mutex;
+    /// Number of samples written
+    std::size_t m_Size { 0 };
+};
+
+bool GraphDataPyramid::isNeeded(std::size_t size) noexcept
+{
+    return size >= LEVEL_FACTOR * MIN_LEVEL_SIZE;
+}
+
+GraphDataPyramid::GraphDataPyramid(TimeSeriesGraphData data)
+        : m_Data { std::move(data) }, m_Levels {}
+{
+    update();
+}
+
+std::shared_ptr<const GraphDataPyramid> GraphDataPyramid::append(
+    const TimeSeriesGraphData& data, double windowStart) const
+{
+    auto windowData = data.slice(data.lowerBound(windowStart), data.size());
+    if (m_Data.size() == 0 || windowData.size() == 0)
+    {
+        return nullptr;
+    }
+
+    // New data must not start before the current data (zoom out, pan backward): the samples
+    // prepended wouldn't be in the levels
+    auto firstKey = windowData.key(0);
+    if (firstKey < m_Data.key(0))
+    {
+        return nullptr;
+    }
+
+    // The last sample of the current data must be found in the new data
+    auto lastKey = m_Data.key(m_Data.size() - 1);
+    auto lastIndex = windowData.lowerBound(lastKey);
+    if (lastIndex == windowData.size() || windowData.key(lastIndex) != lastKey
+        || !isSameValue(windowData.value(lastIndex), m_Data.value(m_Data.size() - 1)))
+    {
+        return nullptr;
+    }
+
+    // Drops the samples that are no longer in the data, then reduces the new ones
+    auto pyramid = std::make_shared<GraphDataPyramid>(*this);
+    pyramid->m_Data = std::move(windowData);
+    for (auto& level : pyramid->m_Levels)
+    {
+        auto& levelData = level.m_Data;
+        levelData = levelData.slice(levelData.lowerBound(firstKey), levelData.size());
+    }
+    pyramid->update();
+
+    return pyramid;
+}
+
+const TimeSeriesGraphData& GraphDataPyramid::data() const noexcept
+{
+    return m_Data;
+}
+
+bool GraphDataPyramid::isBuiltFrom(const TimeSeriesGraphData& data) const noexcept
+{
+    return m_Data.m_Keys == data.m_Keys && m_Data.m_Values == data.m_Values
+        && m_Data.m_Stride == data.m_Stride && m_Data.m_Size == data.m_Size;
+}
+
+TimeSeriesGraphData GraphDataPyramid::level(const QCPRange& keyRange, int pixels) const noexcept
+{
+    // A bucket is displayed by (up to) two samples
+    auto minSize = 2 * static_cast<std::size_t>(std::max(pixels, 0));
+
+    auto it = std::find_if(
+        m_Levels.crbegin(), m_Levels.crend(), [&keyRange, minSize](const auto& level) {
+            return level.m_Data.upperBound(keyRange.upper) - level.m_Data.lowerBound(keyRange.lower)
+                >= minSize;
+        });
+
+    return it != m_Levels.crend() ? it->m_Data : m_Data;
+}
+
+std::size_t GraphDataPyramid::levelCount() const noexcept
+{
+    return m_Levels.size();
+}
+
+void GraphDataPyramid::extend(
+    Level& level, const TimeSeriesGraphData& source, std::size_t bucketSize)
+{
+    auto first = source.upperBound(level.m_LastReducedKey);
+    auto bucketCount = (source.size() - first) / bucketSize;
+    if (bucketCount == 0)
+    {
+        return;
+    }
+
+    // Position of the level in its buffers
+    auto& data = level.m_Data;
+    auto buffers = level.m_Buffers;
+    auto begin = buffers ? static_cast<std::size_t>(data.m_Keys - buffers->m_Keys.data()) : 0;
+    auto end = begin + data.size();
+
+    // Buffers are extended in place if no other pyramid has extended them, if they are large
+    // enough, and if the samples dropped from the level don't outnumber the remaining ones.
+    // Otherwise, the level is copied in new buffers
+    std::unique_lock<std::mutex> lock {};
+    if (buffers)
+    {
+        lock = std::unique_lock<std::mutex> { buffers->m_Mutex };
+        if (buffers->m_Size != end || end + 2 * bucketCount > buffers->m_Keys.size()
+            || begin > data.size())
+        {
+            lock = std::unique_lock<std::mutex> {};
+            buffers = nullptr;
+        }
+    }
+    if (!buffers)
+    {
+        buffers = std::make_shared<LevelBuffers>(2 * (data.size() + 2 * bucketCount));
+        std::copy(data.m_Keys, data.m_Keys + data.size(), buffers->m_Keys.begin());
+        std::copy(data.m_Values, data.m_Values + data.size(), buffers->m_Values.begin());
+        begin = 0;
+        end = data.size();
+    }
+
+    auto emit = [&buffers, &end](double key, double value) {
+        buffers->m_Keys[end] = key;
+        buffers->m_Values[end] = value;
+        ++end;
+    };
+    for (auto bucket = std::size_t { 0 }; bucket < bucketCount; ++bucket)
+    {
+        auto bucketBegin = first + bucket * bucketSize;
+        reduceBucket(source, bucketBegin, bucketBegin + bucketSize, emit);
+    }
+    buffers->m_Size = end;
+
+    data.m_Owner = buffers;
+    data.m_Keys = buffers->m_Keys.data() + begin;
+    data.m_Values = buffers->m_Values.data() + begin;
+    data.m_Stride = 1;
+    data.m_Size = end - begin;
+    level.m_Buffers = std::move(buffers);
+    level.m_LastReducedKey = source.key(first + bucketCount * bucketSize - 1);
+}
+
+void GraphDataPyramid::update()
+{
+    // First level is built from raw samples, next ones from the samples of the previous level of
+    // which each bucket holds up to two samples
+    auto source = m_Data;
+    auto bucketSize = LEVEL_FACTOR;
+    for (auto& level : m_Levels)
+    {
+        extend(level, source, bucketSize);
+        source = level.m_Data;
+        bucketSize = 2 * LEVEL_FACTOR;
+    }
+
+    // Adds levels while the coarsest one can be reduced to a level big enough
+    while (source.size() >= bucketSize * MIN_LEVEL_SIZE / 2)
+    {
+        auto level = Level { nullptr, TimeSeriesGraphData {},
+            std::numeric_limits<double>::lowest() };
+        extend(level, source, bucketSize);
+        if (level.m_Data.size() < MIN_LEVEL_SIZE)
+        {
+            break;
+        }
+
+        m_Levels.push_back(level);
+        source = level.m_Data;
+        bucketSize = 2 * LEVEL_FACTOR;
+    }
+}
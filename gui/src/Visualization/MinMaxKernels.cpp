@@ -0,0 +1,127 @@
+#include "Visualization/MinMaxKernels.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+/// Reduces values with scalar instructions. As comparisons with NaN are false, NaN values are
+/// ignored
+void scalarMinMax(const double* values, std::size_t size, std::size_t stride, double& min,
+    double& max) noexcept
+{
+    for (auto index = std::size_t { 0 }; index < size; ++index)
+    {
+        auto value = values[index * stride];
+        if (value < min)
+        {
+            min = value;
+        }
+        if (value > max)
+        {
+            max = value;
+        }
+    }
+}
+
+/**
+ * Reduces contiguous values with SIMD instructions, and returns the number of values reduced (a
+ * multiple of the width of the vectors, the remaining values being left to the scalar reduction).
+ *
+ * min/max instructions return their second operand when one of them is NaN: the accumulator being
+ * passed as second operand, NaN values are ignored. Two accumulators are used to break the
+ * dependency chain between iterations
+ */
+std::size_t simdMinMax(const double* values, std::size_t size, double& min, double& max) noexcept
+{
+#if defined(__AVX__)
+    const auto width = std::size_t { 4 };
+    auto min0 = _mm256_set1_pd(min), min1 = min0;
+    auto max0 = _mm256_set1_pd(max), max1 = max0;
+
+    auto index = std::size_t { 0 };
+    for (; index + 2 * width <= size; index += 2 * width)
+    {
+        auto values0 = _mm256_loadu_pd(values + index);
+        auto values1 = _mm256_loadu_pd(values + index + width);
+        min0 = _mm256_min_pd(values0, min0);
+        min1 = _mm256_min_pd(values1, min1);
+        max0 = _mm256_max_pd(values0, max0);
+        max1 = _mm256_max_pd(values1, max1);
+    }
+
+    alignas(32) double mins[width], maxs[width];
+    _mm256_store_pd(mins, _mm256_min_pd(min0, min1));
+    _mm256_store_pd(maxs, _mm256_max_pd(max0, max1));
+#elif defined(__SSE2__) || defined(_M_X64)
+    const auto width = std::size_t { 2 };
+    auto min0 = _mm_set1_pd(min), min1 = min0;
+    auto max0 = _mm_set1_pd(max), max1 = max0;
+
+    auto index = std::size_t { 0 };
+    for (; index + 2 * width <= size; index += 2 * width)
+    {
+        auto values0 = _mm_loadu_pd(values + index);
+        auto values1 = _mm_loadu_pd(values + index + width);
+        min0 = _mm_min_pd(values0, min0);
+        min1 = _mm_min_pd(values1, min1);
+        max0 = _mm_max_pd(values0, max0);
+        max1 = _mm_max_pd(values1, max1);
+    }
+
+    alignas(16) double mins[width], maxs[width];
+    _mm_store_pd(mins, _mm_min_pd(min0, min1));
+    _mm_store_pd(maxs, _mm_max_pd(max0, max1));
+#else
+    const auto width = std::size_t { 1 };
+    auto index = std::size_t { 0 };
+    double mins[width] = { min }, maxs[width] = { max };
+#endif
+
+    min = *std::min_element(mins, mins + width);
+    max = *std::max_element(maxs, maxs + width);
+    return index;
+}
+
+std::optional<QCPRange> toRange(double min, double max) noexcept
+{
+    // min is greater than max if no value has been reduced
+    return min <= max ? std::make_optional(QCPRange { min, max }) : std::nullopt;
+}
+
+} // namespace
+
+namespace MinMaxKernels
+{
+
+std::optional<QCPRange> minMax(const double* values, std::size_t size) noexcept
+{
+    auto min = std::numeric_limits<double>::infinity();
+    auto max = -std::numeric_limits<double>::infinity();
+
+    auto reduced = simdMinMax(values, size, min, max);
+    scalarMinMax(values + reduced, size - reduced, 1, min, max);
+    return toRange(min, max);
+}
+
+std::optional<QCPRange> minMax(const double* values, std::size_t size, std::size_t stride) noexcept
+{
+    if (stride == 1)
+    {
+        return minMax(values, size);
+    }
+
+    auto min = std::numeric_limits<double>::infinity();
+    auto max = -std::numeric_limits<double>::infinity();
+    scalarMinMax(values, size, stride, min, max);
+    return toRange(min, max);
+}
+
+} // namespace MinMaxKernels
@@ -0,0 +1,149 @@
+#include "Visualization/NearestSampleIndex.h"
+#include "Visualization/TimeSeriesGraph.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+/// Number of pixel columns whose samples are cached. Columns beyond it are recomputed when
+/// hovered again
+const auto MAX_CACHED_COLUMNS = std::size_t { 8 };
+
+} // namespace
+
+std::optional<NearestSampleIndex::Sample> NearestSampleIndex::nearest(
+    QCustomPlot& plot, const QPoint& pos, double maxDistance)
+{
+    auto axisRect = plot.axisRect();
+    if (!axisRect || !axisRect->rect().contains(pos))
+    {
+        return std::nullopt;
+    }
+
+    // Columns no longer cover the same keys if the range or the geometry of the plot changed
+    if (plot.xAxis->range() != m_KeyRange || axisRect->rect() != m_AxisRect)
+    {
+        invalidate();
+        m_KeyRange = plot.xAxis->range();
+        m_AxisRect = axisRect->rect();
+    }
+
+    auto result = std::optional<Sample> {};
+    auto compareSample = [&result, &pos, maxDistance](TimeSeriesGraph* graph, std::size_t index) {
+        const auto& data = graph->data();
+        auto value = data.value(index);
+        if (std::isnan(value))
+        {
+            return;
+        }
+
+        auto distance = QLineF { graph->coordsToPixels(data.key(index), value), pos }.length();
+        if (distance <= maxDistance && (!result || distance < result->m_Distance))
+        {
+            result = Sample { graph, index, distance };
+        }
+    };
+
+    for (auto i = 0; i < plot.plottableCount(); ++i)
+    {
+        auto graph = qobject_cast<TimeSeriesGraph*>(plot.plottable(i));
+        if (!graph || !graph->visible() || graph->data().size() == 0)
+        {
+            continue;
+        }
+
+        // The closest samples before and after the column are compared for sparse data, where
+        // the column holds no sample
+        const auto& samples = columnSamples(*graph, pos.x());
+        if (samples.m_Begin > 0)
+        {
+            compareSample(graph, samples.m_Begin - 1);
+        }
+        if (samples.m_End < samples.m_Size)
+        {
+            compareSample(graph, samples.m_End);
+        }
+
+        // In the column, the values surrounding the value under the position are the closest ones
+        // on screen, as the value axis is monotonic
+        if (!samples.m_Values.empty())
+        {
+            auto value = graph->valueAxis()->pixelToCoord(pos.y());
+            auto it = std::lower_bound(std::cbegin(samples.m_Values), std::cend(samples.m_Values),
+                value, [](const auto& sample, double target) { return sample.first < target; });
+            if (it != std::cend(samples.m_Values))
+            {
+                compareSample(graph, it->second);
+            }
+            if (it != std::cbegin(samples.m_Values))
+            {
+                compareSample(graph, std::prev(it)->second);
+            }
+        }
+    }
+
+    return result;
+}
+
+void NearestSampleIndex::invalidate() noexcept
+{
+    m_Columns.clear();
+}
+
+const NearestSampleIndex::ColumnSamples& NearestSampleIndex::columnSamples(
+    const TimeSeriesGraph& graph, int column)
+{
+    const auto& data = graph.data();
+
+    // The column is moved first, the least recently used one being dropped beyond the limit
+    auto columnIt = std::find_if(std::begin(m_Columns), std::end(m_Columns),
+        [column](const auto& cachedColumn) { return cachedColumn.m_Column == column; });
+    if (columnIt != std::end(m_Columns))
+    {
+        m_Columns.splice(std::begin(m_Columns), m_Columns, columnIt);
+    }
+    else
+    {
+        m_Columns.push_front(Column { column, {} });
+        if (m_Columns.size() > MAX_CACHED_COLUMNS)
+        {
+            m_Columns.pop_back();
+        }
+    }
+
+    auto& columnEntries = m_Columns.front().m_Entries;
+    auto it = std::find_if(std::cbegin(columnEntries), std::cend(columnEntries),
+        [&graph, &data](const auto& entry) {
+            return entry.m_Graph == &graph && entry.m_Keys == data.m_Keys
+                && entry.m_Size == data.size();
+        });
+    if (it != std::cend(columnEntries))
+    {
+        return *it;
+    }
+
+    auto keyAxis = graph.keyAxis();
+    auto lower = keyAxis->pixelToCoord(column - 0.5);
+    auto upper = keyAxis->pixelToCoord(column + 0.5);
+    if (lower > upper)
+    {
+        std::swap(lower, upper);
+    }
+
+    auto samples = ColumnSamples { &graph, data.m_Keys, data.size(), data.lowerBound(lower),
+        data.lowerBound(upper), {} };
+    samples.m_Values.reserve(samples.m_End - samples.m_Begin);
+    for (auto index = samples.m_Begin; index < samples.m_End; ++index)
+    {
+        if (auto value = data.value(index); !std::isnan(value))
+        {
+            samples.m_Values.emplace_back(value, index);
+        }
+    }
+    std::sort(std::begin(samples.m_Values), std::end(samples.m_Values));
+
+    columnEntries.push_back(std::move(samples));
+    return columnEntries.back();
+}
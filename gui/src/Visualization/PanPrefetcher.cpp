@@ -0,0 +1,103 @@
+#include "Visualization/PanPrefetcher.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+/// Relative difference of width under which two successive ranges are considered as a pan
+const auto PAN_WIDTH_TOLERANCE = 1e-6;
+
+/// Weight of the last move in the estimation of the velocity of the pan
+const auto VELOCITY_SMOOTHING = 0.3;
+
+/// Duration of the pan to anticipate, in ms. It should be of the order of the time a provider
+/// takes to answer
+const auto LOOKAHEAD_DURATION = 2000.;
+
+/// Number of windows prefetched ahead of the pan, whatever its velocity
+const auto MIN_WINDOWS_AHEAD = 1.;
+
+/// Max number of windows prefetched ahead of the pan
+const auto MAX_WINDOWS_AHEAD = 4.;
+
+/// Number of windows prefetched behind the pan, for a change of direction
+const auto WINDOWS_BEHIND = 1.;
+
+double center(const DateTimeRange& range) noexcept
+{
+    return (range.m_TStart + range.m_TEnd) / 2.;
+}
+
+double width(const DateTimeRange& range) noexcept
+{
+    return range.m_TEnd - range.m_TStart;
+}
+
+bool contains(const DateTimeRange& range, const DateTimeRange& other) noexcept
+{
+    return range.m_TStart <= other.m_TStart && other.m_TEnd <= range.m_TEnd;
+}
+
+} // namespace
+
+PanPrefetcher::PanPrefetcher() : m_LastRange {}, m_LastTime { 0 }, m_Velocity { 0. }
+{
+    m_Clock.start();
+}
+
+std::vector<DateTimeRange> PanPrefetcher::rangesToPrefetch(const DateTimeRange& range)
+{
+    auto now = m_Clock.elapsed();
+    auto rangeWidth = width(range);
+    auto isPan = m_LastRange && rangeWidth > 0.
+        && std::abs(rangeWidth - width(*m_LastRange)) <= PAN_WIDTH_TOLERANCE * rangeWidth;
+
+    if (isPan)
+    {
+        // Velocity is smoothed over the moves, unless the pan changed direction
+        if (auto shift = center(range) - center(*m_LastRange); shift != 0.)
+        {
+            auto velocity = shift / static_cast<double>(std::max(qint64 { 1 }, now - m_LastTime));
+            m_Velocity = velocity * m_Velocity > 0.
+                ? VELOCITY_SMOOTHING * velocity + (1. - VELOCITY_SMOOTHING) * m_Velocity
+                : velocity;
+        }
+    }
+    else
+    {
+        m_Velocity = 0.;
+        m_PrefetchedRange.reset();
+    }
+    m_LastRange = range;
+    m_LastTime = now;
+
+    if (!isPan || m_Velocity == 0. || (m_PrefetchedRange && contains(*m_PrefetchedRange, range)))
+    {
+        return {};
+    }
+
+    auto windowsAhead = std::clamp(std::abs(m_Velocity) * LOOKAHEAD_DURATION / rangeWidth,
+        MIN_WINDOWS_AHEAD, MAX_WINDOWS_AHEAD);
+    auto before = m_Velocity > 0. ? WINDOWS_BEHIND : windowsAhead;
+    auto after = m_Velocity > 0. ? windowsAhead : WINDOWS_BEHIND;
+
+    auto prefetchedRange = range;
+    prefetchedRange.m_TStart -= before * rangeWidth;
+    prefetchedRange.m_TEnd += after * rangeWidth;
+    m_PrefetchedRange = prefetchedRange;
+
+    // Windows ahead of the pan come first, so that they are fetched first
+    auto windowsBefore = DateTimeRange { prefetchedRange.m_TStart, range.m_TStart };
+    auto windowsAfter = DateTimeRange { range.m_TEnd, prefetchedRange.m_TEnd };
+    return m_Velocity > 0. ? std::vector<DateTimeRange> { windowsAfter, windowsBefore }
+                           : std::vector<DateTimeRange> { windowsBefore, windowsAfter };
+}
+
+void PanPrefetcher::reset() noexcept
+{
+    m_LastRange.reset();
+    m_Velocity = 0.;
+    m_PrefetchedRange.reset();
+}
@@ -0,0 +1,88 @@
+#include "Visualization/RangeChangeBroadcaster.h"
+
+#include <SqpApplication.h>
+#include <Variable/Variable2.h>
+#include <Variable/VariableController2.h>
+
+#include <QTimer>
+
+#include <map>
+
+Q_LOGGING_CATEGORY(LOG_RangeChangeBroadcaster, "RangeChangeBroadcaster")
+
+class RangeChangeBroadcaster::RangeChangeBroadcasterPrivate
+{
+public:
+    /// Range asked for a variable, with the order of the request among the pending ones
+    struct Request
+    {
+        DateTimeRange m_Range;
+        int m_Order;
+    };
+
+    /// Ranges asked for the variables of a synchronization group, the last request of a variable
+    /// replacing the previous ones
+    using Transaction = std::map<std::shared_ptr<Variable2>, Request>;
+
+    /// Issues the pending transactions. A variable shared between groups is requested once, with
+    /// the last range asked whatever its group
+    void issueTransactions()
+    {
+        auto requests = Transaction {};
+        for (const auto& transaction : m_Transactions)
+        {
+            for (const auto& [variable, request] : transaction.second)
+            {
+                auto it = requests.find(variable);
+                if (it == requests.end() || it->second.m_Order < request.m_Order)
+                {
+                    requests[variable] = request;
+                }
+            }
+        }
+
+        for (const auto& [variable, request] : requests)
+        {
+            sqpApp->variableController().asyncChangeRange(variable, request.m_Range);
+        }
+
+        qCDebug(LOG_RangeChangeBroadcaster())
+            << QObject::tr("Range changes merged:") << m_RequestCount << QObject::tr("asked for")
+            << m_Transactions.size() << QObject::tr("groups,") << requests.size()
+            << QObject::tr("issued");
+
+        m_Transactions.clear();
+        m_RequestCount = 0;
+        m_IsIssueScheduled = false;
+    }
+
+    std::map<QUuid, Transaction> m_Transactions;
+    int m_RequestCount { 0 };
+    bool m_IsIssueScheduled { false };
+};
+
+RangeChangeBroadcaster::RangeChangeBroadcaster(QObject* parent)
+        : QObject { parent }, impl { spimpl::make_unique_impl<RangeChangeBroadcasterPrivate>() }
+{
+}
+
+void RangeChangeBroadcaster::changeRange(
+    const QUuid& groupId, std::shared_ptr<Variable2> variable, const DateTimeRange& range)
+{
+    if (!variable)
+    {
+        qCWarning(LOG_RangeChangeBroadcaster()) << tr("Can't change range: variable is null");
+        return;
+    }
+
+    impl->m_Transactions[groupId][variable] = { range, impl->m_RequestCount };
+    ++impl->m_RequestCount;
+
+    // Transactions are issued once the events of the current iteration (mouse move, synchronized
+    // graphs, etc.) have been processed
+    if (!impl->m_IsIssueScheduled)
+    {
+        impl->m_IsIssueScheduled = true;
+        QTimer::singleShot(0, this, [this]() { impl->issueTransactions(); });
+    }
+}
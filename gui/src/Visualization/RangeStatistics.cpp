@@ -0,0 +1,41 @@
+#include "Visualization/RangeStatistics.h"
+#include "Visualization/MinMaxKernels.h"
+
+#include <algorithm>
+
+namespace RangeStatistics
+{
+
+std::pair<std::size_t, std::size_t> indexRange(
+    const TimeSeriesGraphData& data, double tStart, double tEnd) noexcept
+{
+    auto first = data.lowerBound(tStart);
+    return { first, std::max(first, data.upperBound(tEnd)) };
+}
+
+std::optional<QCPRange> valueRange(const TimeSeriesGraphData& data, double tStart, double tEnd,
+    std::size_t componentCount) noexcept
+{
+    auto [first, last] = indexRange(data, tStart, tEnd);
+    auto values = data.m_Values + first * data.m_Stride;
+
+    // Components filling the stride are contiguous: they are reduced in one pass
+    if (componentCount == data.m_Stride)
+    {
+        return MinMaxKernels::minMax(values, (last - first) * componentCount);
+    }
+
+    auto result = std::optional<QCPRange> {};
+    for (auto component = std::size_t { 0 }; component < componentCount; ++component)
+    {
+        if (auto range = MinMaxKernels::minMax(values + component, last - first, data.m_Stride))
+        {
+            result = result ? QCPRange { std::min(result->lower, range->lower),
+                                  std::max(result->upper, range->upper) }
+                            : *range;
+        }
+    }
+    return result;
+}
+
+} // namespace RangeStatistics
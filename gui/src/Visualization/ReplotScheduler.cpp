@@ -0,0 +1,136 @@
+#include "Visualization/ReplotScheduler.h"
+#include "Visualization/qcustomplot.h"
+
+#include <Settings/SqpSettingsGuiDefs.h>
+
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QSettings>
+#include <QTimer>
+
+#include <algorithm>
+#include <deque>
+
+Q_LOGGING_CATEGORY(LOG_ReplotScheduler, "ReplotScheduler")
+
+namespace
+{
+
+/// Gives access to the state of the paint buffers of a plot, which QCustomPlot only checks for its
+/// own layers
+struct PaintBuffersAccess : public QCustomPlot
+{
+    using QCustomPlot::hasInvalidatedPaintBuffers;
+};
+
+} // namespace
+
+const int ReplotScheduler::FRAME_INTERVAL = 16;
+
+class ReplotScheduler::ReplotSchedulerPrivate
+{
+public:
+    explicit ReplotSchedulerPrivate()
+            : m_FrameBudget { QSettings {}
+                                  .value(VISUALIZATION_FRAME_BUDGET_KEY,
+                                      VISUALIZATION_FRAME_BUDGET_DEFAULT_VALUE)
+                                  .toInt() }
+    {
+        m_FrameTimer.setSingleShot(true);
+        m_LastFrame.start();
+    }
+
+    /// Replots the dirty plots, in the order they were marked, until the budget is exceeded
+    void replotFrame()
+    {
+        m_LastFrame.restart();
+
+        auto replotCount = 0;
+        auto isInBudget = [this, &replotCount]() {
+            return replotCount == 0 || m_LastFrame.elapsed() < m_FrameBudget;
+        };
+        while (!m_DirtyPlots.empty() && isInBudget())
+        {
+            auto plot = m_DirtyPlots.front();
+            m_DirtyPlots.pop_front();
+
+            // Plots destroyed since they were marked are null
+            if (plot)
+            {
+                plot->replot(QCustomPlot::rpQueuedRefresh);
+                ++replotCount;
+            }
+        }
+
+        if (!m_DirtyPlots.empty())
+        {
+            qCDebug(LOG_ReplotScheduler()) << QObject::tr("Frame budget exceeded:")
+                                           << m_DirtyPlots.size()
+                                           << QObject::tr("plots postponed to next frame");
+            startFrameTimer();
+        }
+    }
+
+    /// Starts the timer of the next frame, so that frames are at least FRAME_INTERVAL apart
+    void startFrameTimer()
+    {
+        if (!m_FrameTimer.isActive())
+        {
+            auto elapsed = static_cast<int>(m_LastFrame.elapsed());
+            m_FrameTimer.start(std::max(0, FRAME_INTERVAL - elapsed));
+        }
+    }
+
+    QTimer m_FrameTimer;
+    QElapsedTimer m_LastFrame;
+    std::deque<QPointer<QCustomPlot>> m_DirtyPlots;
+    int m_FrameBudget;
+};
+
+ReplotScheduler::ReplotScheduler(QObject* parent)
+        : QObject { parent }, impl { spimpl::make_unique_impl<ReplotSchedulerPrivate>() }
+{
+    connect(&impl->m_FrameTimer, &QTimer::timeout, this, [this]() { impl->replotFrame(); });
+}
+
+void ReplotScheduler::scheduleReplot(QCustomPlot& plot)
+{
+    // A plot already dirty keeps its place
+    auto& dirtyPlots = impl->m_DirtyPlots;
+    if (std::find(dirtyPlots.cbegin(), dirtyPlots.cend(), &plot) == dirtyPlots.cend())
+    {
+        dirtyPlots.emplace_back(&plot);
+    }
+
+    impl->startFrameTimer();
+}
+
+void ReplotScheduler::replotLayer(QCPLayer& layer)
+{
+    auto plot = layer.parentPlot();
+    if (!plot)
+    {
+        return;
+    }
+
+    // QCPLayer::replot() does nothing for a buffered layer whose buffers are invalidated
+    auto hasInvalidatedPaintBuffers = &PaintBuffersAccess::hasInvalidatedPaintBuffers;
+    if (layer.mode() == QCPLayer::lmBuffered && !(plot->*hasInvalidatedPaintBuffers)())
+    {
+        layer.replot();
+    }
+    else
+    {
+        scheduleReplot(*plot);
+    }
+}
+
+int ReplotScheduler::frameBudget() const noexcept
+{
+    return impl->m_FrameBudget;
+}
+
+void ReplotScheduler::setFrameBudget(int frameBudget) noexcept
+{
+    impl->m_FrameBudget = std::max(0, frameBudget);
+}
@@ -0,0 +1,258 @@
+#include "Visualization/SpectrogramRasterizer.h"
+#include "Visualization/MinMaxKernels.h"
+
+#include <Data/TimeSeriesUtils.h>
+#include <DataSource/DataGaps.h>
+
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+/// Max number of columns of a raster
+const auto MAX_COLUMNS = 32000;
+
+/// Max number of rows of a raster
+const auto MAX_ROWS = 1024;
+
+/// Number of rows per channel for the narrowest channel, so that channel bounds fall close to the
+/// bounds of the rows
+const auto ROWS_PER_CHANNEL = 2;
+
+/// Number of columns computed by a task
+const auto COLUMNS_PER_BLOCK = 64;
+
+/// Gives access to the cells of a QCPColorMapData, so that the raster is written in place instead of
+/// cell by cell
+struct ColorMapDataAccess : public QCPColorMapData
+{
+    using QCPColorMapData::mData;
+};
+
+/// Rows of a raster: the y-axis range they cover and the data channel displayed by each row
+struct RasterRows
+{
+    QCPRange m_Range;
+    std::vector<std::size_t> m_Channels;
+};
+
+/// Columns of a raster: the x-axis range they cover and the gaps of the serie, in which columns
+/// that don't contain any line have no value
+struct RasterColumns
+{
+    QCPRange m_Range;
+    int m_Count;
+    DataGaps m_Gaps;
+};
+
+RasterRows computeRows(const std::vector<double>& yAxis, QCPAxis::ScaleType yScaleType)
+{
+    // Channels are sorted by their center, undefined ones being discarded
+    std::vector<std::size_t> channels(yAxis.size());
+    std::iota(std::begin(channels), std::end(channels), std::size_t { 0 });
+    channels.erase(std::remove_if(std::begin(channels), std::end(channels),
+                       [&yAxis](auto channel) { return !std::isfinite(yAxis[channel]); }),
+        std::end(channels));
+    std::sort(std::begin(channels), std::end(channels),
+        [&yAxis](auto lhs, auto rhs) { return yAxis[lhs] < yAxis[rhs]; });
+    if (channels.empty())
+    {
+        return RasterRows {};
+    }
+
+    auto logScale = yScaleType == QCPAxis::stLogarithmic && yAxis[channels.front()] > 0.;
+    auto toScale = [logScale](double value) { return logScale ? std::log10(value) : value; };
+
+    // Computes channel centers and bounds in display scale. Bounds separate two successive
+    // channels, so the first channel is below the first bound and the last one above the last bound
+    std::vector<double> centers(channels.size());
+    std::transform(std::cbegin(channels), std::cend(channels), std::begin(centers),
+        [&yAxis, &toScale](auto channel) { return toScale(yAxis[channel]); });
+
+    std::vector<double> bounds {};
+    bounds.reserve(centers.size());
+    auto minWidth = std::numeric_limits<double>::max();
+    for (auto index = std::size_t { 1 }; index < centers.size(); ++index)
+    {
+        bounds.push_back((centers[index - 1] + centers[index]) / 2.);
+        if (auto width = centers[index] - centers[index - 1]; width > 0.)
+        {
+            minWidth = std::min(minWidth, width);
+        }
+    }
+
+    // Row centers are evenly spaced from the first to the last channel center, the narrowest
+    // channel spanning at least ROWS_PER_CHANNEL rows
+    auto span = centers.back() - centers.front();
+    auto rowCount = 1;
+    if (span > 0.)
+    {
+        rowCount = static_cast<int>(std::min(
+            std::ceil(ROWS_PER_CHANNEL * span / minWidth) + 1., static_cast<double>(MAX_ROWS)));
+    }
+
+    auto rows = RasterRows {};
+    rows.m_Range = QCPRange { yAxis[channels.front()], yAxis[channels.back()] };
+    rows.m_Channels.reserve(rowCount);
+    for (auto row = 0; row < rowCount; ++row)
+    {
+        auto rowCenter
+            = rowCount > 1 ? centers.front() + row * span / (rowCount - 1) : centers.front();
+        auto channelIndex
+            = std::upper_bound(std::cbegin(bounds), std::cend(bounds), rowCenter) - bounds.cbegin();
+        rows.m_Channels.push_back(channels[channelIndex]);
+    }
+    return rows;
+}
+
+RasterColumns computeColumns(SpectrogramTimeSerie& serie)
+{
+    auto xAxisProperties
+        = TimeSeriesUtils::axis_analysis<TimeSeriesUtils::IsLinear, TimeSeriesUtils::CheckMedian>(
+            serie.axis(0), serie.min_sampling);
+
+    auto columns = RasterColumns {};
+    columns.m_Range = QCPRange { xAxisProperties.min, xAxisProperties.max };
+    columns.m_Count = std::max(2,
+        static_cast<int>(std::min(xAxisProperties.range / xAxisProperties.max_resolution,
+            static_cast<double>(MAX_COLUMNS))));
+
+    // Lines farther apart than the max gap are separated by a gap
+    auto maxGap = std::fmin(2. * serie.max_sampling, xAxisProperties.max_resolution * 100.);
+    columns.m_Gaps = DataGaps::find(serie.axis(0), maxGap);
+    return columns;
+}
+
+/**
+ * Computes the values of a block of columns.
+ * @param block the values of the columns, channel by channel (the values of a channel for all the
+ * columns of the block are contiguous)
+ */
+void computeBlock(SpectrogramTimeSerie& serie, const RasterColumns& columns, int firstColumn,
+    int blockWidth, std::vector<double>& block)
+{
+    const auto& xAxis = serie.axis(0);
+    auto channelCount = block.size() / blockWidth;
+    auto columnWidth = columns.m_Range.size() / (columns.m_Count - 1);
+
+    std::vector<double> sums(channelCount);
+    std::vector<int> counts(channelCount);
+    auto addLine = [&serie, &sums, &counts](std::size_t lineIndex) {
+        auto channel = std::size_t { 0 };
+        for (const auto& item : *std::next(std::begin(serie), lineIndex))
+        {
+            if (auto value = item.v(); !std::isnan(value))
+            {
+                sums[channel] += value;
+                ++counts[channel];
+            }
+            ++channel;
+        }
+    };
+
+    for (auto column = 0; column < blockWidth; ++column)
+    {
+        std::fill(std::begin(sums), std::end(sums), 0.);
+        std::fill(std::begin(counts), std::end(counts), 0);
+
+        // Lines whose time falls in the column are averaged. If there is none, the closest line is
+        // held unless the column is in a gap
+        auto center = columns.m_Range.lower + (firstColumn + column) * columnWidth;
+        auto first = std::lower_bound(
+            std::cbegin(xAxis), std::cend(xAxis), center - columnWidth / 2.);
+        auto last = std::lower_bound(first, std::cend(xAxis), center + columnWidth / 2.);
+        if (first != last)
+        {
+            for (auto it = first; it != last; ++it)
+            {
+                addLine(std::distance(std::cbegin(xAxis), it));
+            }
+        }
+        else if (!columns.m_Gaps.contains(center))
+        {
+            auto closest = first;
+            if (closest == std::cend(xAxis)
+                || (closest != std::cbegin(xAxis) && center - *(closest - 1) < *closest - center))
+            {
+                --closest;
+            }
+            addLine(std::distance(std::cbegin(xAxis), closest));
+        }
+
+        for (auto channel = std::size_t { 0 }; channel < channelCount; ++channel)
+        {
+            block[channel * blockWidth + column] = counts[channel] > 0
+                ? sums[channel] / counts[channel]
+                : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+}
+
+} // namespace
+
+SpectrogramRasterizer::Raster SpectrogramRasterizer::rasterize(
+    SpectrogramTimeSerie& serie, QCPAxis::ScaleType yScaleType, const std::atomic_bool& canceled)
+{
+    if (serie.size(0) <= 2 || serie.size(1) == 0)
+    {
+        return Raster {};
+    }
+
+    auto rows = computeRows(serie.axis(1), yScaleType);
+    if (rows.m_Channels.empty())
+    {
+        return Raster {};
+    }
+    auto columns = computeColumns(serie);
+    auto rowCount = static_cast<int>(rows.m_Channels.size());
+    auto channelCount = serie.size(1);
+
+    // Raster is written in the cells of the colormap data, which are stored row by row
+    auto data = std::make_unique<QCPColorMapData>(
+        columns.m_Count, rowCount, columns.m_Range, rows.m_Range);
+    auto raster = (*data).*(&ColorMapDataAccess::mData);
+    if (!raster)
+    {
+        return Raster {};
+    }
+
+    std::vector<int> blocks {};
+    for (auto firstColumn = 0; firstColumn < columns.m_Count; firstColumn += COLUMNS_PER_BLOCK)
+    {
+        blocks.push_back(firstColumn);
+    }
+
+    QtConcurrent::blockingMap(blocks, [&](int firstColumn) {
+        if (canceled)
+        {
+            return;
+        }
+
+        auto blockWidth = std::min(COLUMNS_PER_BLOCK, columns.m_Count - firstColumn);
+        std::vector<double> block(channelCount * blockWidth);
+        computeBlock(serie, columns, firstColumn, blockWidth, block);
+
+        // Each row of the block is a contiguous span of the row of the raster
+        for (auto row = 0; row < rowCount; ++row)
+        {
+            auto source = std::cbegin(block) + rows.m_Channels[row] * blockWidth;
+            std::copy(source, source + blockWidth,
+                raster + static_cast<std::size_t>(row) * columns.m_Count + firstColumn);
+        }
+    });
+
+    if (canceled)
+    {
+        return Raster {};
+    }
+
+    auto cellCount = static_cast<std::size_t>(rowCount) * columns.m_Count;
+    auto dataRange = MinMaxKernels::minMax(raster, cellCount);
+    return Raster { std::move(data), dataRange };
+}
@@ -0,0 +1,245 @@
+#include "Visualization/TimeSeriesGraph.h"
+#include "Visualization/GraphDataPyramid.h"
+#include "Visualization/GraphDecimation.h"
+#include "Visualization/RangeStatistics.h"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+/// Iterator over the indexes of the samples of a TimeSeriesGraphData
+struct IndexIterator
+{
+    std::size_t operator*() const noexcept { return m_Index; }
+
+    IndexIterator& operator++() noexcept
+    {
+        ++m_Index;
+        return *this;
+    }
+
+    bool operator!=(const IndexIterator& other) const noexcept { return m_Index != other.m_Index; }
+
+    std::size_t m_Index;
+};
+
+/// Returns true if @p value belongs to the sign domain passed in parameter
+bool isInSignDomain(double value, QCP::SignDomain signDomain) noexcept
+{
+    switch (signDomain)
+    {
+        case QCP::sdNegative:
+            return value < 0.;
+        case QCP::sdPositive:
+            return value > 0.;
+        default:
+            return true;
+    }
+}
+
+/// Draws a polyline, which is interrupted where its points are undefined (data holes). As in
+/// QCPAbstractPlottable1D, infinite points are discarded too as they block QPainter::drawPolyline()
+void drawPolylines(QCPPainter& painter, const QVector<QPointF>& points)
+{
+    auto isDefined = [](const QPointF& point) {
+        return std::isfinite(point.x()) && std::isfinite(point.y());
+    };
+
+    auto end = points.cend();
+    auto it = std::find_if(points.cbegin(), end, isDefined);
+    while (it != end)
+    {
+        auto segmentEnd = std::find_if_not(it, end, isDefined);
+        auto count = static_cast<int>(std::distance(it, segmentEnd));
+        if (count > 1)
+        {
+            painter.drawPolyline(&*it, count);
+        }
+        it = std::find_if(segmentEnd, end, isDefined);
+    }
+}
+
+} // namespace
+
+TimeSeriesGraph::TimeSeriesGraph(QCPAxis* keyAxis, QCPAxis* valueAxis)
+        : QCPAbstractPlottable { keyAxis, valueAxis }, m_Data {}, m_Pyramid {}
+{
+    setPen(QPen { Qt::blue, 0 });
+    setBrush(Qt::NoBrush);
+}
+
+const TimeSeriesGraphData& TimeSeriesGraph::data() const noexcept
+{
+    return m_Data;
+}
+
+void TimeSeriesGraph::setData(TimeSeriesGraphData data) noexcept
+{
+    m_Data = std::move(data);
+}
+
+std::shared_ptr<const GraphDataPyramid> TimeSeriesGraph::pyramid() const noexcept
+{
+    return m_Pyramid;
+}
+
+void TimeSeriesGraph::setPyramid(std::shared_ptr<const GraphDataPyramid> pyramid) noexcept
+{
+    m_Pyramid = std::move(pyramid);
+}
+
+double TimeSeriesGraph::selectTest(const QPointF& pos, bool onlySelectable, QVariant* details) const
+{
+    if ((onlySelectable && mSelectable == QCP::stNone) || m_Data.size() == 0)
+    {
+        return -1;
+    }
+    if (!mKeyAxis || !mValueAxis || !mKeyAxis->axisRect()->rect().contains(pos.toPoint()))
+    {
+        return -1;
+    }
+
+    // Distance to the sample which is the closest to the position along the key axis
+    double key, value;
+    pixelsToCoords(pos, key, value);
+    auto index = m_Data.nearest(key);
+    if (std::isnan(m_Data.value(index)))
+    {
+        return -1;
+    }
+
+    if (details)
+    {
+        auto dataIndex = static_cast<int>(index);
+        details->setValue(QCPDataSelection { QCPDataRange { dataIndex, dataIndex + 1 } });
+    }
+    return QLineF { coordsToPixels(m_Data.key(index), m_Data.value(index)), pos }.length();
+}
+
+QCPRange TimeSeriesGraph::getKeyRange(bool& foundRange, QCP::SignDomain inSignDomain) const
+{
+    // Keys are sorted: the range goes from the first to the last key of the sign domain
+    auto begin = std::size_t { 0 }, end = m_Data.size();
+    if (inSignDomain == QCP::sdPositive)
+    {
+        begin = m_Data.upperBound(0.);
+    }
+    else if (inSignDomain == QCP::sdNegative)
+    {
+        end = m_Data.lowerBound(0.);
+    }
+
+    foundRange = begin < end;
+    return foundRange ? QCPRange { m_Data.key(begin), m_Data.key(end - 1) } : QCPRange {};
+}
+
+QCPRange TimeSeriesGraph::getValueRange(
+    bool& foundRange, QCP::SignDomain inSignDomain, const QCPRange& inKeyRange) const
+{
+    // As for QCPGraph, an empty key range means that all the samples are considered
+    auto tStart = std::numeric_limits<double>::lowest(), tEnd = std::numeric_limits<double>::max();
+    if (inKeyRange != QCPRange {})
+    {
+        tStart = inKeyRange.lower;
+        tEnd = inKeyRange.upper;
+    }
+
+    if (inSignDomain == QCP::sdBoth)
+    {
+        auto range = RangeStatistics::valueRange(m_Data, tStart, tEnd);
+        foundRange = range.has_value();
+        return range.value_or(QCPRange {});
+    }
+
+    auto [begin, end] = RangeStatistics::indexRange(m_Data, tStart, tEnd);
+    auto range = QCPRange { std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::lowest() };
+    foundRange = false;
+    for (auto index = begin; index < end; ++index)
+    {
+        auto value = m_Data.value(index);
+        if (!std::isnan(value) && isInSignDomain(value, inSignDomain))
+        {
+            range.lower = std::min(range.lower, value);
+            range.upper = std::max(range.upper, value);
+            foundRange = true;
+        }
+    }
+
+    return foundRange ? range : QCPRange {};
+}
+
+void TimeSeriesGraph::draw(QCPPainter* painter)
+{
+    auto keyAxis = mKeyAxis.data();
+    if (!keyAxis || !mValueAxis || m_Data.size() == 0 || mPen.style() == Qt::NoPen)
+    {
+        return;
+    }
+
+    auto keyRange = keyAxis->range();
+    auto pixels = static_cast<int>(
+        std::abs(keyAxis->coordToPixel(keyRange.upper) - keyAxis->coordToPixel(keyRange.lower)));
+
+    QVector<QPointF> points {};
+    auto append = [this, &points](double key, double value) {
+        points.append(coordsToPixels(key, value));
+    };
+
+    // Adds the visible samples of data, plus one sample on each side so that lines reach the plot
+    // borders
+    auto appendVisible = [&keyRange, pixels, &points, &append](const TimeSeriesGraphData& data) {
+        auto begin = data.lowerBound(keyRange.lower);
+        auto end = std::min(data.upperBound(keyRange.upper) + 1, data.size());
+        if (begin > 0)
+        {
+            --begin;
+        }
+
+        if (keyRange.size() > 0. && GraphDecimation::isDecimationNeeded(end - begin, pixels))
+        {
+            points.reserve(points.size() + 4 * (pixels + 2));
+            GraphDecimation::envelope(IndexIterator { begin }, IndexIterator { end },
+                [&data](auto index) { return data.key(index); },
+                [&data](auto index) { return data.value(index); }, keyRange.lower,
+                keyRange.size() / pixels, append);
+        }
+        else
+        {
+            points.reserve(points.size() + static_cast<int>(end - begin));
+            for (auto index = begin; index < end; ++index)
+            {
+                append(data.key(index), data.value(index));
+            }
+        }
+    };
+
+    // Gets the level of detail to draw. Levels don't hold the most recent samples, that don't fill
+    // a bucket yet: these samples are read from the raw data
+    auto data = m_Pyramid ? m_Pyramid->level(keyRange, pixels) : m_Data;
+    appendVisible(data);
+    if (data.m_Keys != m_Data.m_Keys && data.size() > 0)
+    {
+        auto lastKey = data.key(data.size() - 1);
+        if (lastKey < keyRange.upper)
+        {
+            appendVisible(m_Data.slice(m_Data.upperBound(lastKey), m_Data.size()));
+        }
+    }
+
+    applyDefaultAntialiasingHint(painter);
+    painter->setPen(selected() && mSelectionDecorator ? mSelectionDecorator->pen() : mPen);
+    painter->setBrush(Qt::NoBrush);
+    drawPolylines(*painter, points);
+}
+
+void TimeSeriesGraph::drawLegendIcon(QCPPainter* painter, const QRectF& rect) const
+{
+    // Draws a line vertically centered
+    applyDefaultAntialiasingHint(painter);
+    painter->setPen(mPen);
+    painter->drawLine(QLineF { rect.left(), rect.top() + rect.height() / 2., rect.right() + 5,
+        rect.top() + rect.height() / 2. });
+}
@@ -1,4 +1,7 @@
 #include <Common/DateUtils.h>
+#include <Common/VisualizationDef.h>
+#include <SqpApplication.h>
+#include <Visualization/ReplotScheduler.h>
 #include <Visualization/VisualizationCursorItem.h>
 #include <Visualization/qcustomplot.h>
 
@@ -91,10 +94,13 @@ void VisualizationCursorItem::setVisible(bool value)
 {
     if (value != isVisible()) {
 
-        if (value) {
-            Q_ASSERT(!impl->m_LineItem && !impl->m_LabelItem);
+        // Items are created the first time the cursor is shown, then only hidden: adding or
+        // removing items invalidates the buffer of their layer, which requires a full replot
+        if (value && !impl->m_LineItem) {
+            Q_ASSERT(!impl->m_LabelItem);
 
             impl->m_LineItem = new QCPItemStraightLine{impl->m_Plot};
+            impl->m_LineItem->setLayer(CURSORS_LAYER);
             auto pen = QPen{CURSOR_PEN_STYLE};
             pen.setColor(CURSOR_COLOR);
             pen.setWidth(CURSOR_WIDTH);
@@ -102,6 +108,7 @@ void VisualizationCursorItem::setVisible(bool value)
             impl->m_LineItem->setSelectable(false);
 
             impl->m_LabelItem = new QCPItemText{impl->m_Plot};
+            impl->m_LabelItem->setLayer(CURSORS_LAYER);
             impl->m_LabelItem->setColor(CURSOR_COLOR);
             impl->m_LabelItem->setSelectable(false);
             impl->m_LabelItem->position->setParentAnchor(impl->m_LineItem->point1);
@@ -117,21 +124,22 @@ void VisualizationCursorItem::setVisible(bool value)
             impl->updateLabelText();
             impl->updateCursorPosition();
         }
-        else {
-            Q_ASSERT(impl->m_LineItem && impl->m_LabelItem);
-
-            // Note: the items are destroyed by QCustomPlot in removeItem
-            impl->m_Plot->removeItem(impl->m_LineItem);
-            impl->m_LineItem = nullptr;
-            impl->m_Plot->removeItem(impl->m_LabelItem);
-            impl->m_LabelItem = nullptr;
-        }
+
+        impl->m_LineItem->setVisible(value);
+        impl->m_LabelItem->setVisible(value);
     }
 }
 
 bool VisualizationCursorItem::isVisible() const
 {
-    return impl->m_LineItem != nullptr;
+    return impl->m_LineItem != nullptr && impl->m_LineItem->visible();
+}
+
+void VisualizationCursorItem::refresh()
+{
+    if (auto layer = impl->m_Plot->layer(CURSORS_LAYER)) {
+        sqpApp->replotScheduler().replotLayer(*layer);
+    }
 }
 
 void VisualizationCursorItem::setPosition(double value)
@@ -1,27 +1,162 @@
 #include "Visualization/VisualizationGraphHelper.h"
+#include "Visualization/GraphDataPyramid.h"
+#include "Visualization/RangeStatistics.h"
+#include "Visualization/SpectrogramRasterizer.h"
+#include "Visualization/TimeSeriesGraph.h"
 #include "Visualization/qcustomplot.h"
 
 #include <Data/ScalarTimeSerie.h>
 #include <Data/SpectrogramTimeSerie.h>
-#include <Data/TimeSeriesUtils.h>
 #include <Data/VectorTimeSerie.h>
 
 #include <Common/cpp_utils.h>
 #include <Variable/Variable2.h>
 #include <algorithm>
 #include <cmath>
+#include <optional>
 
 Q_LOGGING_CATEGORY(LOG_VisualizationGraphHelper, "VisualizationGraphHelper")
 
 namespace
 {
 
-class SqpDataContainer : public QCPGraphDataContainer
+/**
+ * Creates a view on a component of a serie, that reads the buffers of the serie in place.
+ * @param serie the serie to read. The view shares its ownership
+ * @param stride the number of values held by each sample of the serie
+ * @param firstValue function returning, from the first sample of the serie, the address of the
+ * first value of the component
+ */
+template <typename Serie, typename FirstValueFun>
+TimeSeriesGraphData makeGraphData(
+    const std::shared_ptr<Serie>& serie, std::size_t stride, FirstValueFun firstValue)
+{
+    auto data = TimeSeriesGraphData {};
+    if (serie && serie->size() > 0)
+    {
+        data.m_Owner = serie;
+        data.m_Keys = serie->axis(0).data();
+        data.m_Values = firstValue(*std::begin(*serie));
+        data.m_Stride = stride;
+        data.m_Size = serie->size();
+    }
+    return data;
+}
+
+/**
+ * Sets the y-axis range of a plot to the min and max values of a serie over an x-axis range
+ * @param componentCount the number of values held by each sample of the serie
+ * @param firstValue function returning, from the first sample of the serie, the address of its
+ * first value
+ * @sa RangeStatistics
+ */
+template <typename Serie, typename FirstValueFun>
+void setPlotYAxisRangeFromValues(Serie& serie, std::size_t componentCount,
+    FirstValueFun firstValue, const DateTimeRange& xAxisRange, QCustomPlot& plot)
 {
-public:
-    void appendGraphData(const QCPGraphData& data) { mData.append(data); }
+    auto range = QCPRange { 0., 0. };
+    if (serie.size() > 0)
+    {
+        auto data = TimeSeriesGraphData {};
+        data.m_Keys = serie.axis(0).data();
+        data.m_Values = firstValue(*std::begin(serie));
+        data.m_Stride = componentCount;
+        data.m_Size = serie.size();
+        if (auto valueRange = RangeStatistics::valueRange(
+                data, xAxisRange.m_TStart, xAxisRange.m_TEnd, componentCount))
+        {
+            range = *valueRange;
+        }
+    }
+    plot.yAxis->setRange(range);
+}
+
+/**
+ * Prepared data of line graphs: a view on each component of the serie, with its levels of detail
+ */
+struct PreparedGraphs : public IPreparedPlottables
+{
+    struct Component
+    {
+        TimeSeriesGraphData m_Data;
+        std::shared_ptr<const GraphDataPyramid> m_Pyramid;
+    };
+
+    void apply(PlottablesMap& plottables, bool rescaleAxes) override
+    {
+        // For each plottable to update, swaps its data
+        for (const auto& plottable : plottables)
+        {
+            auto graph = dynamic_cast<TimeSeriesGraph*>(plottable.second);
+            auto componentIt = m_Components.find(plottable.first);
+            if (graph && componentIt != m_Components.cend())
+            {
+                graph->setData(componentIt->second.m_Data);
+                graph->setPyramid(componentIt->second.m_Pyramid);
+            }
+        }
+
+        if (!plottables.empty() && rescaleAxes)
+        {
+            auto plot = plottables.begin()->second->parentPlot();
+            plot->xAxis->rescale();
+            VisualizationGraphHelper::rescaleYAxis(*plot);
+        }
+    }
+
+    /// Components, indexed as the plottables
+    std::map<int, Component> m_Components;
 };
 
+/**
+ * Prepares line graphs from views on the components of a serie, by building the levels of detail
+ * of each component.
+ *
+ * If the previous data of a component have levels of detail and the new data only append samples
+ * to them (live feed), the previous levels are extended instead of being rebuilt, and the samples
+ * before @p windowStart are dropped so that the cost of the feed stays bounded. Other data are
+ * kept whole.
+ * @return the prepared data, or nullptr if the preparation has been canceled
+ */
+std::shared_ptr<IPreparedPlottables> prepareGraphs(std::map<int, TimeSeriesGraphData> components,
+    const IPreparedPlottables* previous, double windowStart, const std::atomic_bool& canceled)
+{
+    auto previousGraphs = dynamic_cast<const PreparedGraphs*>(previous);
+
+    auto prepared = std::make_shared<PreparedGraphs>();
+    for (auto& component : components)
+    {
+        if (canceled)
+        {
+            return nullptr;
+        }
+
+        auto& data = component.second;
+        auto pyramid = std::shared_ptr<const GraphDataPyramid> { nullptr };
+        if (previousGraphs)
+        {
+            auto previousIt = previousGraphs->m_Components.find(component.first);
+            if (previousIt != previousGraphs->m_Components.cend() && previousIt->second.m_Pyramid)
+            {
+                pyramid = previousIt->second.m_Pyramid->append(data, windowStart);
+            }
+        }
+
+        if (pyramid)
+        {
+            data = pyramid->data();
+        }
+        else if (GraphDataPyramid::isNeeded(data.size()))
+        {
+            pyramid = std::make_shared<const GraphDataPyramid>(data);
+        }
+        prepared->m_Components[component.first]
+            = PreparedGraphs::Component { std::move(data), std::move(pyramid) };
+    }
+
+    return prepared;
+}
+
 /**
  * Struct used to create plottables, depending on the type of the data series from which to create
  * them
@@ -41,10 +176,10 @@ PlottablesMap createGraphs(QCustomPlot& plot, int nbGraphs)
 {
     PlottablesMap result {};
 
-    // Creates {nbGraphs} QCPGraph to add to the plot
+    // Creates {nbGraphs} TimeSeriesGraph to add to the plot
     for (auto i = 0; i < nbGraphs; ++i)
     {
-        auto graph = plot.addGraph();
+        auto graph = new TimeSeriesGraph { plot.xAxis, plot.yAxis };
         result.insert({ i, graph });
     }
 
@@ -114,7 +249,8 @@ struct PlottablesCreator<T,
 
 /**
  * Struct used to update plottables, depending on the type of the data series from which to update
- * them
+ * them. Updating plottables is done in two steps: data are prepared (which may be done out of the
+ * GUI thread), then set in the plottables
  * @tparam T the data series' type
  * @remarks Default implementation can't update plottables
  */
@@ -127,10 +263,12 @@ struct PlottablesUpdater
             << QObject::tr("Can't set plot y-axis range: unmanaged data series type");
     }
 
-    static void updatePlottables(T&, PlottablesMap&, const DateTimeRange&, bool)
+    static std::shared_ptr<IPreparedPlottables> prepareData(
+        const std::shared_ptr<T>&, const IPreparedPlottables*, double, const std::atomic_bool&)
     {
         qCCritical(LOG_VisualizationGraphHelper())
             << QObject::tr("Can't update plottables: unmanaged data series type");
+        return nullptr;
     }
 };
 
@@ -144,48 +282,19 @@ struct PlottablesUpdater<T, typename std::enable_if_t<std::is_base_of<ScalarTime
 {
     static void setPlotYAxisRange(T& dataSeries, const DateTimeRange& xAxisRange, QCustomPlot& plot)
     {
-        auto minValue = 0., maxValue = 0.;
         if (auto serie = dynamic_cast<ScalarTimeSerie*>(&dataSeries))
         {
-            if (serie->size())
-            {
-                maxValue = (*std::max_element(std::begin(*serie), std::end(*serie))).v();
-                minValue = (*std::min_element(std::begin(*serie), std::end(*serie))).v();
-            }
+            setPlotYAxisRangeFromValues(*serie, 1,
+                [](const auto& first) { return &first.v(); }, xAxisRange, plot);
         }
-        plot.yAxis->setRange(QCPRange { minValue, maxValue });
     }
 
-    static void updatePlottables(
-        T& dataSeries, PlottablesMap& plottables, const DateTimeRange& range, bool rescaleAxes)
+    static std::shared_ptr<IPreparedPlottables> prepareData(const std::shared_ptr<T>& dataSeries,
+        const IPreparedPlottables* previous, double windowStart, const std::atomic_bool& canceled)
     {
-
-        // For each plottable to update, resets its data
-        for (const auto& plottable : plottables)
-        {
-            if (auto graph = dynamic_cast<QCPGraph*>(plottable.second))
-            {
-                auto dataContainer = QSharedPointer<SqpDataContainer>::create();
-                if (auto serie = dynamic_cast<ScalarTimeSerie*>(&dataSeries))
-                {
-                    std::for_each(
-                        std::begin(*serie), std::end(*serie), [&dataContainer](const auto& value) {
-                            dataContainer->appendGraphData(QCPGraphData(value.t(), value.v()));
-                        });
-                }
-                graph->setData(dataContainer);
-            }
-        }
-
-        if (!plottables.empty())
-        {
-            auto plot = plottables.begin()->second->parentPlot();
-
-            if (rescaleAxes)
-            {
-                plot->rescaleAxes();
-            }
-        }
+        return prepareGraphs(
+            { { 0, makeGraphData(dataSeries, 1, [](const auto& first) { return &first.v(); }) } },
+            previous, windowStart, canceled);
     }
 };
 
@@ -195,71 +304,25 @@ struct PlottablesUpdater<T, typename std::enable_if_t<std::is_base_of<VectorTime
 {
     static void setPlotYAxisRange(T& dataSeries, const DateTimeRange& xAxisRange, QCustomPlot& plot)
     {
-        double minValue = 0., maxValue = 0.;
         if (auto serie = dynamic_cast<VectorTimeSerie*>(&dataSeries))
         {
-            std::for_each(
-                std::begin(*serie), std::end(*serie), [&minValue, &maxValue](const auto& v) {
-                    minValue = std::min({ minValue, v.v().x, v.v().y, v.v().z });
-                    maxValue = std::max({ maxValue, v.v().x, v.v().y, v.v().z });
-                });
+            setPlotYAxisRangeFromValues(*serie, 3,
+                [](const auto& first) { return &first.v().x; }, xAxisRange, plot);
         }
-
-        plot.yAxis->setRange(QCPRange { minValue, maxValue });
     }
 
-    static void updatePlottables(
-        T& dataSeries, PlottablesMap& plottables, const DateTimeRange& range, bool rescaleAxes)
+    static std::shared_ptr<IPreparedPlottables> prepareData(const std::shared_ptr<T>& dataSeries,
+        const IPreparedPlottables* previous, double windowStart, const std::atomic_bool& canceled)
     {
-
-        // For each plottable to update, resets its data
-        for (const auto& plottable : plottables)
-        {
-            if (auto graph = dynamic_cast<QCPGraph*>(plottable.second))
-            {
-                auto dataContainer = QSharedPointer<SqpDataContainer>::create();
-                if (auto serie = dynamic_cast<VectorTimeSerie*>(&dataSeries))
-                {
-                    switch (plottable.first)
-                    {
-                        case 0:
-                            std::for_each(std::begin(*serie), std::end(*serie),
-                                [&dataContainer](const auto& value) {
-                                    dataContainer->appendGraphData(
-                                        QCPGraphData(value.t(), value.v().x));
-                                });
-                            break;
-                        case 1:
-                            std::for_each(std::begin(*serie), std::end(*serie),
-                                [&dataContainer](const auto& value) {
-                                    dataContainer->appendGraphData(
-                                        QCPGraphData(value.t(), value.v().y));
-                                });
-                            break;
-                        case 2:
-                            std::for_each(std::begin(*serie), std::end(*serie),
-                                [&dataContainer](const auto& value) {
-                                    dataContainer->appendGraphData(
-                                        QCPGraphData(value.t(), value.v().z));
-                                });
-                            break;
-                        default:
-                            break;
-                    }
-                }
-                graph->setData(dataContainer);
-            }
-        }
-
-        if (!plottables.empty())
-        {
-            auto plot = plottables.begin()->second->parentPlot();
-
-            if (rescaleAxes)
-            {
-                plot->rescaleAxes();
-            }
-        }
+        // Samples of a vector serie hold three contiguous values
+        static_assert(sizeof(VectorTimeSerie::raw_value_type) == 3 * sizeof(double),
+            "Vector components can't be read in place");
+        auto x = makeGraphData(dataSeries, 3, [](const auto& first) { return &first.v().x; });
+        auto y = makeGraphData(dataSeries, 3, [](const auto& first) { return &first.v().y; });
+        auto z = makeGraphData(dataSeries, 3, [](const auto& first) { return &first.v().z; });
+        return prepareGraphs(
+            { { 0, std::move(x) }, { 1, std::move(y) }, { 2, std::move(z) } }, previous,
+            windowStart, canceled);
     }
 };
 
@@ -270,180 +333,76 @@ struct PlottablesUpdater<T,
 {
     static void setPlotYAxisRange(T& dataSeries, const DateTimeRange& xAxisRange, QCustomPlot& plot)
     {
-        double minValue = 0., maxValue = 0.;
         if (auto serie = dynamic_cast<MultiComponentTimeSerie*>(&dataSeries))
         {
-            std::for_each(std::begin(*serie), std::end(*serie), [&minValue, &maxValue](auto& v) {
-                minValue = std::min(minValue, std::min_element(v.begin(), v.end())->v());
-                maxValue = std::max(maxValue, std::max_element(v.begin(), v.end())->v());
-            });
+            setPlotYAxisRangeFromValues(*serie, serie->size(1),
+                [](const auto& first) { return &first[0]; }, xAxisRange, plot);
         }
-        plot.yAxis->setRange(QCPRange { minValue, maxValue });
     }
 
-    static void updatePlottables(
-        T& dataSeries, PlottablesMap& plottables, const DateTimeRange& range, bool rescaleAxes)
+    static std::shared_ptr<IPreparedPlottables> prepareData(const std::shared_ptr<T>& dataSeries,
+        const IPreparedPlottables* previous, double windowStart, const std::atomic_bool& canceled)
     {
-        for (const auto& plottable : plottables)
-        {
-            if (auto graph = dynamic_cast<QCPGraph*>(plottable.second))
-            {
-                auto dataContainer = QSharedPointer<SqpDataContainer>::create();
-                if (auto serie = dynamic_cast<MultiComponentTimeSerie*>(&dataSeries))
-                {
-                    // TODO
-                    std::for_each(std::begin(*serie), std::end(*serie),
-                        [&dataContainer, component = plottable.first](const auto& value) {
-                            dataContainer->appendGraphData(
-                                QCPGraphData(value.t(), value[component]));
-                        });
-                }
-                graph->setData(dataContainer);
-            }
-        }
-
-        if (!plottables.empty())
+        std::map<int, TimeSeriesGraphData> components {};
+        auto componentCount = dataSeries ? static_cast<int>(dataSeries->size(1)) : 0;
+        for (auto component = 0; component < componentCount; ++component)
         {
-            auto plot = plottables.begin()->second->parentPlot();
-
-            if (rescaleAxes)
-            {
-                plot->rescaleAxes();
-            }
+            components[component] = makeGraphData(dataSeries, dataSeries->size(1),
+                [component](const auto& first) { return &first[component]; });
         }
+        return prepareGraphs(std::move(components), previous, windowStart, canceled);
     }
 };
 
-/*=============================================================*/
-// TODO move this to dedicated srcs
-/*=============================================================*/
-struct ColomapProperties
-{
-    int h_size_px;
-    int v_size_px;
-    double h_resolutuon;
-    double v_resolutuon;
-};
-
-inline ColomapProperties CMAxisAnalysis(const TimeSeriesUtils::axis_properties& xAxisProperties,
-    const TimeSeriesUtils::axis_properties& yAxisProperties)
-{
-    int colormap_h_size
-        = std::min(32000, static_cast<int>(xAxisProperties.range / xAxisProperties.max_resolution));
-    int colormap_v_size = static_cast<int>(yAxisProperties.range / yAxisProperties.max_resolution);
-    double colormap_h_resolution = xAxisProperties.range / static_cast<double>(colormap_h_size);
-    double colormap_v_resolution = yAxisProperties.range / static_cast<double>(colormap_v_size);
-    return ColomapProperties { colormap_h_size, colormap_v_size, colormap_h_resolution,
-        colormap_v_resolution };
-}
-
-
-template <bool condition, typename T, typename U>
-std::enable_if_t<condition, T> constexpr conditional_v(T first, U second)
-{
-    return first;
-}
-
-template <bool condition, typename T, typename U>
-std::enable_if_t<!condition, U> constexpr conditional_v(T first, U second)
-{
-    return second;
-}
-
-template <bool reversedAxis = true, bool reversedData = true>
-inline std::vector<std::pair<int, int>> build_access_pattern(const std::vector<double>& axis,
-    const TimeSeriesUtils::axis_properties& axisProperties,
-    const ColomapProperties& colormap_properties)
+/**
+ * Prepared data of a spectrogram: the colormap data, filled from the serie
+ */
+struct PreparedColorMap : public IPreparedPlottables
 {
-    std::vector<std::pair<int, int>> access_pattern;
-    for (int index = 0, axis_index = conditional_v<reversedAxis>(axis.size() - 1, 0),
-             data_index = conditional_v<reversedData>(axis.size() - 1, 0);
-         index < colormap_properties.v_size_px; index++)
+    void apply(PlottablesMap& plottables, bool rescaleAxes) override
     {
-        double current_y = (axisProperties.max_resolution * index) + axisProperties.min;
-        if (current_y > axis[axis_index])
+        if (plottables.empty())
         {
-            conditional_v<reversedAxis>(
-                [&axis_index]() { axis_index--; }, [&axis_index]() { axis_index++; })();
-            conditional_v<reversedData>(
-                [&data_index]() { data_index--; }, [&data_index]() { data_index++; })();
+            qCDebug(LOG_VisualizationGraphHelper())
+                << QObject::tr("Can't update spectrogram: no colormap has been associated");
+            return;
         }
-        access_pattern.push_back({ index, data_index });
-    }
-    return access_pattern;
-}
 
-inline bool is_log(const std::vector<double>& axis)
-{
-    if (axis.size() > 2)
-    {
-        auto first = axis.front(), midle = axis[axis.size() / 2], last = axis.back();
-        auto error_linear = (midle - (last + first) / 2) / midle;
-        first = log10(first);
-        midle = log10(midle);
-        last = log10(last);
-        auto error_log = (midle - (last + first) / 2) / midle;
-        return error_log < error_linear;
-    }
-    return false;
-}
+        // Gets the colormap to update (normally there is only one colormap)
+        Q_ASSERT(plottables.size() == 1);
+        auto colormap = dynamic_cast<QCPColorMap*>(plottables.at(0));
+        Q_ASSERT(colormap != nullptr);
+        auto plot = colormap->parentPlot();
+        plot->yAxis->setRange(m_YAxisRange);
 
-template <typename accessPattern_t, typename colomapT, typename axProp_t, typename cmProp_t>
-inline void fill_data(SpectrogramTimeSerie* serie, colomapT* colormap,
-    const accessPattern_t& y_access_pattern, const axProp_t& xAxisProperties,
-    const cmProp_t& colormap_properties)
-{
-    auto line = serie->begin();
-    auto next_line = line + 1;
-    double current_time = xAxisProperties.min;
-    int x_index = 0;
-    auto x_min_resolution
-        = std::fmin(2. * serie->max_sampling, xAxisProperties.max_resolution * 100.);
-    std::vector<double> line_values(serie->size(1));
-    double avg_coef = 0.;
-    while (x_index < colormap_properties.h_size_px)
-    {
-        if (next_line != std::end(*serie) and current_time >= next_line->t())
-        {
-            line = next_line;
-            next_line++;
-        }
-        if ((current_time - xAxisProperties.min)
-            > (static_cast<double>(x_index + 1) * colormap_properties.h_resolutuon))
-        {
-            std::for_each(std::cbegin(y_access_pattern), std::cend(y_access_pattern),
-                [&colormap, &line_values, x_index, avg_coef](const auto& acc) {
-                    colormap->data()->setCell(
-                        x_index, acc.first, line_values[acc.second] / avg_coef);
-                });
-            std::fill(std::begin(line_values), std::end(line_values), 0.);
-            x_index++;
-            avg_coef = 0.;
-        }
-        if (line->t() + x_min_resolution > current_time)
+        if (m_Data)
         {
+            // The colormap takes ownership of the data, whose range has already been computed
+            colormap->setDataScaleType(m_DataScaleType);
+            colormap->setData(m_Data.release(), false);
+            if (m_DataRange)
             {
-                std::transform(std::begin(*line), std::end(*line), std::cbegin(line_values),
-                    std::begin(line_values),
-                    [](const auto& input, auto output) { return input.v() + output; });
+                colormap->setDataRange(*m_DataRange);
             }
-            avg_coef += 1.;
         }
         else
         {
-            for (int y_index = 0; y_index < colormap_properties.v_size_px; y_index++)
-            {
-                if (avg_coef > 0.)
-                {
-                    std::fill(std::begin(line_values), std::end(line_values), 0);
-                }
-            }
+            colormap->rescaleDataRange(true);
+        }
+
+        if (rescaleAxes)
+        {
+            plot->xAxis->rescale();
+            VisualizationGraphHelper::rescaleYAxis(*plot);
         }
-        current_time += xAxisProperties.max_resolution * 0.9;
     }
-}
 
-/*=============================================================*/
+    QCPRange m_YAxisRange;
+    QCPAxis::ScaleType m_DataScaleType { QCPAxis::stLinear };
+    /// Colormap data, set to null when given to the colormap
+    std::unique_ptr<QCPColorMapData> m_Data { nullptr };
+    std::optional<QCPRange> m_DataRange {};
+};
 
 /**
  * Specialization of PlottablesUpdater for spectrograms
@@ -459,56 +418,29 @@ struct PlottablesUpdater<T,
         plot.yAxis->setRange(QCPRange { minValue, maxValue });
     }
 
-    static void updatePlottables(
-        T& dataSeries, PlottablesMap& plottables, const DateTimeRange& range, bool rescaleAxes)
+    static std::shared_ptr<IPreparedPlottables> prepareData(const std::shared_ptr<T>& dataSeries,
+        const IPreparedPlottables* previous, double windowStart, const std::atomic_bool& canceled)
     {
-        if (plottables.empty())
+        // Colormap is always rasterized from the whole serie: previous data aren't reused
+        auto prepared = std::make_shared<PreparedColorMap>();
+        auto [minValue, maxValue] = dataSeries->axis_range(1);
+        prepared->m_YAxisRange = QCPRange { minValue, maxValue };
+        if (auto serie = dynamic_cast<SpectrogramTimeSerie*>(dataSeries.get()))
         {
-            qCDebug(LOG_VisualizationGraphHelper())
-                << QObject::tr("Can't update spectrogram: no colormap has been associated");
-            return;
-        }
+            prepared->m_DataScaleType
+                = serie->y_is_log ? QCPAxis::stLogarithmic : QCPAxis::stLinear;
 
-        // Gets the colormap to update (normally there is only one colormap)
-        Q_ASSERT(plottables.size() == 1);
-        auto colormap = dynamic_cast<QCPColorMap*>(plottables.at(0));
-        Q_ASSERT(colormap != nullptr);
-        auto plot = colormap->parentPlot();
-        auto [minValue, maxValue] = dataSeries.axis_range(1);
-        plot->yAxis->setRange(QCPRange { minValue, maxValue });
-        if (auto serie = dynamic_cast<SpectrogramTimeSerie*>(&dataSeries))
-        {
-            if (serie->size(0) > 2)
+            // Spectrograms are displayed on a logarithmic y-axis (see AxisRenderingUtils)
+            auto raster
+                = SpectrogramRasterizer::rasterize(*serie, QCPAxis::stLogarithmic, canceled);
+            if (canceled)
             {
-                if (serie->y_is_log)
-                    colormap->setDataScaleType(QCPAxis::stLogarithmic);
-                else
-                    colormap->setDataScaleType(QCPAxis::stLinear);
-                const auto& xAxis = serie->axis(0);
-                auto yAxis = serie->axis(1); // copy for in place reverse order
-                auto y_is_log = is_log(yAxis);
-                std::reverse(std::begin(yAxis), std::end(yAxis));
-                auto xAxisProperties = TimeSeriesUtils::axis_analysis<TimeSeriesUtils::IsLinear,
-                    TimeSeriesUtils::CheckMedian>(xAxis, serie->min_sampling);
-                auto yAxisProperties = TimeSeriesUtils::axis_analysis<TimeSeriesUtils::IsLog,
-                    TimeSeriesUtils::DontCheckMedian>(yAxis);
-                auto colormap_properties = CMAxisAnalysis(xAxisProperties, yAxisProperties);
-
-                colormap->data()->setSize(
-                    colormap_properties.h_size_px, colormap_properties.v_size_px);
-                colormap->data()->setRange(
-                    QCPRange { xAxisProperties.min, xAxisProperties.max }, { minValue, maxValue });
-
-                auto y_access_pattern = build_access_pattern<false, true>(
-                    yAxis, yAxisProperties, colormap_properties);
-                fill_data(serie, colormap, y_access_pattern, xAxisProperties, colormap_properties);
-            }
-            colormap->rescaleDataRange(true);
-            if (rescaleAxes)
-            {
-                plot->rescaleAxes();
+                return nullptr;
             }
+            prepared->m_Data = std::move(raster.m_Data);
+            prepared->m_DataRange = raster.m_DataRange;
         }
+        return prepared;
     }
 };
 
@@ -520,8 +452,8 @@ struct IPlottablesHelper
     virtual ~IPlottablesHelper() noexcept = default;
     virtual PlottablesMap create(QCustomPlot& plot) const = 0;
     virtual void setYAxisRange(const DateTimeRange& xAxisRange, QCustomPlot& plot) const = 0;
-    virtual void update(
-        PlottablesMap& plottables, const DateTimeRange& range, bool rescaleAxes = false) const = 0;
+    virtual std::shared_ptr<IPreparedPlottables> prepare(const IPreparedPlottables* previous,
+        double windowStart, const std::atomic_bool& canceled) const = 0;
 };
 
 /**
@@ -539,18 +471,20 @@ struct PlottablesHelper : public IPlottablesHelper
         return PlottablesCreator<T>::createPlottables(plot, m_DataSeries);
     }
 
-    void update(
-        PlottablesMap& plottables, const DateTimeRange& range, bool rescaleAxes) const override
+    std::shared_ptr<IPreparedPlottables> prepare(const IPreparedPlottables* previous,
+        double windowStart, const std::atomic_bool& canceled) const override
     {
         if (m_DataSeries)
         {
-            PlottablesUpdater<T>::updatePlottables(*m_DataSeries, plottables, range, rescaleAxes);
+            return PlottablesUpdater<T>::prepareData(
+                m_DataSeries, previous, windowStart, canceled);
         }
         else
         {
             qCCritical(LOG_VisualizationGraphHelper()) << "Can't update plottables: inconsistency "
                                                           "between the type of data series and the "
                                                           "type supposed";
+            return nullptr;
         }
     }
 
@@ -571,23 +505,24 @@ struct PlottablesHelper : public IPlottablesHelper
     std::shared_ptr<T> m_DataSeries;
 };
 
-/// Creates IPlottablesHelper according to the type of data series a variable holds
-std::unique_ptr<IPlottablesHelper> createHelper(std::shared_ptr<Variable2> variable) noexcept
+/// Creates IPlottablesHelper according to the type of a data series
+std::unique_ptr<IPlottablesHelper> createHelper(
+    DataSeriesType type, std::shared_ptr<TimeSeries::ITimeSerie> data) noexcept
 {
-    switch (variable->type())
+    switch (type)
     {
         case DataSeriesType::SCALAR:
             return std::make_unique<PlottablesHelper<ScalarTimeSerie>>(
-                std::dynamic_pointer_cast<ScalarTimeSerie>(variable->data()));
+                std::dynamic_pointer_cast<ScalarTimeSerie>(data));
         case DataSeriesType::SPECTROGRAM:
             return std::make_unique<PlottablesHelper<SpectrogramTimeSerie>>(
-                std::dynamic_pointer_cast<SpectrogramTimeSerie>(variable->data()));
+                std::dynamic_pointer_cast<SpectrogramTimeSerie>(data));
         case DataSeriesType::VECTOR:
             return std::make_unique<PlottablesHelper<VectorTimeSerie>>(
-                std::dynamic_pointer_cast<VectorTimeSerie>(variable->data()));
+                std::dynamic_pointer_cast<VectorTimeSerie>(data));
         case DataSeriesType::MULTICOMPONENT:
             return std::make_unique<PlottablesHelper<MultiComponentTimeSerie>>(
-                std::dynamic_pointer_cast<MultiComponentTimeSerie>(variable->data()));
+                std::dynamic_pointer_cast<MultiComponentTimeSerie>(data));
         default:
             // Creates default helper
             break;
@@ -596,6 +531,12 @@ std::unique_ptr<IPlottablesHelper> createHelper(std::shared_ptr<Variable2> varia
     return std::make_unique<PlottablesHelper<TimeSeries::ITimeSerie>>(nullptr);
 }
 
+/// Creates IPlottablesHelper according to the type of data series a variable holds
+std::unique_ptr<IPlottablesHelper> createHelper(std::shared_ptr<Variable2> variable) noexcept
+{
+    return createHelper(variable->type(), variable->data());
+}
+
 } // namespace
 
 PlottablesMap VisualizationGraphHelper::create(
@@ -620,8 +561,10 @@ void VisualizationGraphHelper::setYAxisRange(
 {
     if (variable)
     {
+        // Range is computed over what is displayed, which may be narrower than the data loaded
+        auto xAxisRange = plot.xAxis->range();
         auto helper = createHelper(variable);
-        helper->setYAxisRange(variable->range(), plot);
+        helper->setYAxisRange(DateTimeRange { xAxisRange.lower, xAxisRange.upper }, plot);
     }
     else
     {
@@ -630,9 +573,57 @@ void VisualizationGraphHelper::setYAxisRange(
     }
 }
 
-void VisualizationGraphHelper::updateData(
-    PlottablesMap& plottables, std::shared_ptr<Variable2> variable, const DateTimeRange& dateTime)
+void VisualizationGraphHelper::rescaleYAxis(QCustomPlot& plot) noexcept
+{
+    auto xAxisRange = plot.xAxis->range();
+    auto yAxisRange = std::optional<QCPRange> {};
+    for (auto i = 0; i < plot.plottableCount(); ++i)
+    {
+        auto plottable = plot.plottable(i);
+        if (!plottable->visible() || plottable->valueAxis() != plot.yAxis)
+        {
+            continue;
+        }
+
+        auto range = std::optional<QCPRange> {};
+        if (auto graph = dynamic_cast<TimeSeriesGraph*>(plottable))
+        {
+            range = RangeStatistics::valueRange(graph->data(), xAxisRange.lower, xAxisRange.upper);
+        }
+        else
+        {
+            auto foundRange = false;
+            auto plottableRange = plottable->getValueRange(foundRange, QCP::sdBoth, xAxisRange);
+            if (foundRange)
+            {
+                range = plottableRange;
+            }
+        }
+
+        if (range)
+        {
+            yAxisRange = yAxisRange ? QCPRange { std::min(yAxisRange->lower, range->lower),
+                                          std::max(yAxisRange->upper, range->upper) }
+                                    : *range;
+        }
+    }
+
+    if (yAxisRange)
+    {
+        plot.yAxis->setRange(*yAxisRange);
+    }
+}
+
+std::shared_ptr<IPreparedPlottables> VisualizationGraphHelper::prepareData(DataSeriesType type,
+    std::shared_ptr<TimeSeries::ITimeSerie> data, const IPreparedPlottables* previous,
+    double windowStart, const std::atomic_bool& canceled)
+{
+    auto helper = createHelper(type, std::move(data));
+    return helper->prepare(previous, windowStart, canceled);
+}
+
+void VisualizationGraphHelper::applyData(
+    PlottablesMap& plottables, IPreparedPlottables& preparedData)
 {
-    auto helper = createHelper(variable);
-    helper->update(plottables, dateTime);
+    preparedData.apply(plottables, false);
 }
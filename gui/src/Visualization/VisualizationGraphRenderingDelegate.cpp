@@ -1,12 +1,16 @@
 #include "Visualization/VisualizationGraphRenderingDelegate.h"
 #include "Visualization/AxisRenderingUtils.h"
 #include "Visualization/ColorScaleEditor.h"
+#include "Visualization/NearestSampleIndex.h"
 #include "Visualization/PlottablesRenderingUtils.h"
+#include "Visualization/ReplotScheduler.h"
 #include "Visualization/SqpColorScale.h"
+#include "Visualization/TimeSeriesGraph.h"
 #include "Visualization/VisualizationGraphWidget.h"
 #include "Visualization/qcustomplot.h"
 
 #include <Common/DateUtils.h>
+#include <Common/VisualizationDef.h>
 
 #include <SqpApplication.h>
 
@@ -159,6 +163,7 @@ struct VisualizationGraphRenderingDelegate::VisualizationGraphRenderingDelegateP
             , m_ColorScale { SqpColorScale { m_Plot } }
     {
         initPointTracerStyle(*m_PointTracer);
+        m_PointTracer->setLayer(TRACER_LAYER);
 
         m_TracerTimer.setInterval(TOOLTIP_TIMEOUT);
         m_TracerTimer.setSingleShot(true);
@@ -219,6 +224,7 @@ struct VisualizationGraphRenderingDelegate::VisualizationGraphRenderingDelegateP
     bool m_ShowXAxis; /// X-axis properties are shown or hidden
     QString m_XAxisLabel;
     SqpColorScale m_ColorScale; /// Color scale used for some types of graphs (as spectrograms)
+    NearestSampleIndex m_NearestSampleIndex; /// Finds the sample under the mouse for the tooltip
 };
 
 VisualizationGraphRenderingDelegate::VisualizationGraphRenderingDelegate(
@@ -246,36 +252,29 @@ void VisualizationGraphRenderingDelegate::updateTooltip(QMouseEvent* event) noex
     impl->m_TracerTimer.disconnect();
 
     // Reinits tracers
-    impl->m_PointTracer->setGraph(nullptr);
+    auto tracerWasVisible = impl->m_PointTracer->visible();
     impl->m_PointTracer->setVisible(false);
-    impl->m_Plot.replot();
 
     QString tooltip {};
 
-    // Gets the graph under the mouse position
+    // Gets the closest data point to the mouse among the graphs
     auto eventPos = event->pos();
-    if (auto graph = qobject_cast<QCPGraph*>(impl->m_Plot.plottableAt(eventPos)))
+    if (auto sample = impl->m_NearestSampleIndex.nearest(
+            impl->m_Plot, eventPos, impl->m_Plot.selectionTolerance()))
     {
-        auto mouseKey = graph->keyAxis()->pixelToCoord(eventPos.x());
-        auto graphData = graph->data();
-
-        // Gets the closest data point to the mouse
-        auto graphDataIt = graphData->findBegin(mouseKey);
-        if (graphDataIt != graphData->constEnd())
-        {
-            // Sets tooltip
-            auto key = formatValue(graphDataIt->key, *graph->keyAxis());
-            auto value = formatValue(graphDataIt->value, *graph->valueAxis());
-            tooltip = GRAPH_TOOLTIP_FORMAT.arg(key, value);
-
-            // Displays point tracer
-            impl->m_PointTracer->setGraph(graph);
-            impl->m_PointTracer->setGraphKey(graphDataIt->key);
-            impl->m_PointTracer->setLayer(
-                impl->m_Plot.layer("main")); // Tracer is set on top of the plot's main layer
-            impl->m_PointTracer->setVisible(true);
-            impl->m_Plot.replot();
-        }
+        auto graph = sample->m_Graph;
+        auto dataKey = graph->data().key(sample->m_Index);
+        auto dataValue = graph->data().value(sample->m_Index);
+
+        // Sets tooltip
+        auto key = formatValue(dataKey, *graph->keyAxis());
+        auto value = formatValue(dataValue, *graph->valueAxis());
+        tooltip = GRAPH_TOOLTIP_FORMAT.arg(key, value);
+
+        // Displays point tracer
+        impl->m_PointTracer->position->setAxes(graph->keyAxis(), graph->valueAxis());
+        impl->m_PointTracer->position->setCoords(dataKey, dataValue);
+        impl->m_PointTracer->setVisible(true);
     }
     else if (auto colorMap = qobject_cast<QCPColorMap*>(impl->m_Plot.plottableAt(eventPos)))
     {
@@ -294,6 +293,12 @@ void VisualizationGraphRenderingDelegate::updateTooltip(QMouseEvent* event) noex
             formatValue(value, *colorMap->colorScale()->axis()));
     }
 
+    // Only the layer of the tracer is repainted
+    if (tracerWasVisible || impl->m_PointTracer->visible())
+    {
+        sqpApp->replotScheduler().replotLayer(*impl->m_PointTracer->layer());
+    }
+
     if (!tooltip.isEmpty())
     {
         // Starts timer to show tooltip after timeout
@@ -311,7 +316,8 @@ void VisualizationGraphRenderingDelegate::onPlotUpdated() noexcept
 {
     // Updates color scale bounds
     impl->m_ColorScale.updateDataRange();
-    impl->m_Plot.replot();
+    impl->m_NearestSampleIndex.invalidate();
+    sqpApp->replotScheduler().scheduleReplot(impl->m_Plot);
 }
 
 void VisualizationGraphRenderingDelegate::setAxesUnits(Variable2& variable) noexcept
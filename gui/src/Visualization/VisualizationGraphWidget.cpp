@@ -1,5 +1,8 @@
 #include "Visualization/VisualizationGraphWidget.h"
 #include "Visualization/IVisualizationWidgetVisitor.h"
+#include "Visualization/PanPrefetcher.h"
+#include "Visualization/RangeChangeBroadcaster.h"
+#include "Visualization/ReplotScheduler.h"
 #include "Visualization/VisualizationCursorItem.h"
 #include "Visualization/VisualizationDefs.h"
 #include "Visualization/VisualizationGraphHelper.h"
@@ -14,7 +17,9 @@
 #include <Actions/ActionsGuiController.h>
 #include <Actions/FilteringAction.h>
 #include <Common/MimeTypesDef.h>
+#include <Common/VisualizationDef.h>
 #include <Common/containers.h>
+#include <DataSource/CachedDataProvider.h>
 #include <Data/DateTimeRangeHelper.h>
 #include <DragAndDrop/DragDropGuiController.h>
 #include <Settings/SqpSettingsDefs.h>
@@ -23,6 +28,10 @@
 #include <Variable/Variable2.h>
 #include <Variable/VariableController2.h>
 
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
+
+#include <atomic>
 #include <unordered_map>
 
 Q_LOGGING_CATEGORY(LOG_VisualizationGraphWidget, "VisualizationGraphWidget")
@@ -68,20 +77,88 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         m_plot = new QCustomPlot();
         // Necessary for all platform since Qt::AA_EnableHighDpiScaling is enable.
         m_plot->setPlottingHint(QCP::phFastPolylines, true);
+
+        // Interactive items are drawn above the plottables, each kind on its own buffered layer
+        auto layer = m_plot->layer(QStringLiteral("main"));
+        for (const auto& layerName : { SELECTION_ZONES_LAYER, TRACER_LAYER, CURSORS_LAYER })
+        {
+            m_plot->addLayer(layerName, layer, QCustomPlot::limAbove);
+            layer = m_plot->layer(layerName);
+            layer->setMode(QCPLayer::lmBuffered);
+        }
     }
 
-    void updateData(
-        PlottablesMap& plottables, std::shared_ptr<Variable2> variable, const DateTimeRange& range)
-    {
-        VisualizationGraphHelper::updateData(plottables, variable, range);
+    /**
+     * Updates the plottables of a variable with its data. Data are prepared in a worker thread,
+     * then set in the plottables in the GUI thread. A preparation still in progress for the
+     * variable is canceled, as it is superseded by the new one.
+     *
+     * The data last set in the plottables are given to the preparation, so that samples appended
+     * to a live variable are the only ones to be processed. Samples of a live variable older than
+     * one range width before its range are then dropped
+     */
+    void updateData(std::shared_ptr<Variable2> variable)
+    {
+        using PreparedData = std::shared_ptr<IPreparedPlottables>;
+
+        cancelDataPreparation(variable);
+        auto canceled = std::make_shared<std::atomic_bool>(false);
+        m_DataPreparations[variable] = canceled;
+
+        auto watcher = new QFutureWatcher<PreparedData> { m_plot };
+        QObject::connect(watcher, &QFutureWatcher<PreparedData>::finished, m_plot,
+            [this, watcher, variable, canceled]() {
+                watcher->deleteLater();
+                if (*canceled)
+                {
+                    return;
+                }
+                m_DataPreparations.erase(variable);
+
+                auto preparedData = watcher->result();
+                auto it = m_VariableToPlotMultiMap.find(variable);
+                if (preparedData && it != m_VariableToPlotMultiMap.end())
+                {
+                    VisualizationGraphHelper::applyData(it->second, *preparedData);
+                    m_AppliedData[variable] = preparedData;
 
-        // Prevents that data has changed to update rendering
-        m_RenderingDelegate->onPlotUpdated();
+                    // Prevents that data has changed to update rendering
+                    m_RenderingDelegate->onPlotUpdated();
+                }
+            });
+
+        auto appliedIt = m_AppliedData.find(variable);
+        auto previous = appliedIt != m_AppliedData.cend() ? appliedIt->second : nullptr;
+        auto range = variable->range();
+        auto windowStart = range.m_TStart - (range.m_TEnd - range.m_TStart);
+
+        // Data series and its type are read in the GUI thread, the worker only reads the series
+        auto prepare = [type = variable->type(), data = variable->data(), previous, windowStart,
+                           canceled]() -> PreparedData {
+            return VisualizationGraphHelper::prepareData(
+                type, data, previous.get(), windowStart, *canceled);
+        };
+        watcher->setFuture(QtConcurrent::run(prepare));
+    }
+
+    /// Cancels the preparation of data in progress for a variable, if any
+    void cancelDataPreparation(std::shared_ptr<Variable2> variable)
+    {
+        auto it = m_DataPreparations.find(variable);
+        if (it != m_DataPreparations.end())
+        {
+            *it->second = true;
+            m_DataPreparations.erase(it);
+        }
     }
 
     QString m_Name;
     // 1 variable -> n qcpplot
     std::map<std::shared_ptr<Variable2>, PlottablesMap> m_VariableToPlotMultiMap;
+    /// Preparations of plottables data in progress, with their cancellation flags
+    std::map<std::shared_ptr<Variable2>, std::shared_ptr<std::atomic_bool>> m_DataPreparations;
+    /// Data last set in the plottables of each variable
+    std::map<std::shared_ptr<Variable2>, std::shared_ptr<IPreparedPlottables>> m_AppliedData;
     GraphFlags m_Flags;
     bool m_IsCalibration;
     QCustomPlot* m_plot;
@@ -105,6 +182,11 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
 
     bool m_VariableAutoRangeOnInit = true;
 
+    /// Synchronization group of the graph, null if the graph isn't in a zone
+    QUuid m_SynchronisationGroupId {};
+    /// Decides the ranges requested for the variables, so that data is loaded ahead of pans
+    PanPrefetcher m_PanPrefetcher {};
+
     inline void enterPlotDrag(const QPoint& position)
     {
         m_lastMousePos = m_plot->mapFromParent(position);
@@ -118,7 +200,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         QPointF pos { m_plot->xAxis->pixelToCoord(newPos.x()),
             m_plot->yAxis->pixelToCoord(newPos.y()) };
         m_DrawingZoomRect->bottomRight->setCoords(pos);
-        m_plot->replot(QCustomPlot::rpQueuedReplot);
+        sqpApp->replotScheduler().scheduleReplot(*m_plot);
     }
 
     void applyZoomRect()
@@ -141,7 +223,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
             axisX->setRange(newAxisXRange);
             axisY->setRange(newAxisYRange);
 
-            m_plot->replot(QCustomPlot::rpQueuedReplot);
+            sqpApp->replotScheduler().scheduleReplot(*m_plot);
         }
     }
 
@@ -149,7 +231,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
     void updateZoneRect(const QPoint& newPos)
     {
         m_DrawingZone->setEnd(m_plot->xAxis->pixelToCoord(newPos.x()));
-        m_plot->replot(QCustomPlot::rpQueuedReplot);
+        sqpApp->replotScheduler().replotLayer(*m_DrawingZone->layer());
     }
 
     void startDrawingRect(const QPoint& pos)
@@ -173,7 +255,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         {
             m_plot->removeItem(m_DrawingZoomRect); // the item is deleted by QCustomPlot
             m_DrawingZoomRect = nullptr;
-            m_plot->replot(QCustomPlot::rpQueuedReplot);
+            sqpApp->replotScheduler().scheduleReplot(*m_plot);
         }
     }
 
@@ -193,6 +275,9 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         m_DrawingZone = new VisualizationSelectionZoneItem { m_plot };
         m_DrawingZone->setRange(axisPos.x(), axisPos.x());
         m_DrawingZone->setEditionEnabled(false);
+
+        // The new zone invalidates the buffer of its layer, which is then redrawn with the plot
+        sqpApp->replotScheduler().scheduleReplot(*m_plot);
     }
 
     void endDrawingZone()
@@ -210,7 +295,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
                 m_plot->removeItem(m_DrawingZone);
             }
 
-            m_plot->replot(QCustomPlot::rpQueuedReplot);
+            sqpApp->replotScheduler().scheduleReplot(*m_plot);
             m_DrawingZone = nullptr;
         }
     }
@@ -311,13 +396,23 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         this->m_plot->xAxis->setRange(newRange.m_TStart, newRange.m_TEnd);
         if (updateVar)
         {
+            auto products = std::vector<QVariantHash> {};
             for (auto it = m_VariableToPlotMultiMap.begin(), end = m_VariableToPlotMultiMap.end();
                  it != end; it = m_VariableToPlotMultiMap.upper_bound(it->first))
             {
-                sqpApp->variableController().asyncChangeRange(it->first, newRange);
+                sqpApp->rangeChangeBroadcaster().changeRange(
+                    m_SynchronisationGroupId, it->first, newRange);
+                products.push_back(it->first->metadata());
+            }
+
+            // Windows around the range are fetched apart from the range, which isn't delayed
+            auto prefetchedRanges = m_PanPrefetcher.rangesToPrefetch(newRange);
+            if (!prefetchedRanges.empty())
+            {
+                CachedDataProvider::prefetch(products, prefetchedRanges);
             }
         }
-        m_plot->replot(QCustomPlot::rpQueuedReplot);
+        sqpApp->replotScheduler().scheduleReplot(*m_plot);
     }
 
     void setRange(const QCPRange& newRange)
@@ -326,7 +421,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         setRange(graphRange);
     }
 
-    void rescaleY() { m_plot->yAxis->rescale(true); }
+    void rescaleY() { VisualizationGraphHelper::rescaleYAxis(*m_plot); }
 
     std::tuple<double, double> moveGraph(const QPoint& destination)
     {
@@ -362,7 +457,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         axis->scaleRange(factor, axis->pixelToCoord(center));
         if (orientation == Qt::Horizontal)
             setRange(axis->range());
-        m_plot->replot(QCustomPlot::rpQueuedReplot);
+        sqpApp->replotScheduler().scheduleReplot(*m_plot);
     }
 
     void transform(const DateTimeRangeTransformation& tranformation)
@@ -371,7 +466,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         DateTimeRange range { graphRange.lower, graphRange.upper };
         range = range.transform(tranformation);
         setRange(range);
-        m_plot->replot(QCustomPlot::rpQueuedReplot);
+        sqpApp->replotScheduler().scheduleReplot(*m_plot);
     }
 
     void move(double dx, double dy)
@@ -381,7 +476,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         xAxis->setRange(QCPRange(xAxis->range().lower + dx, xAxis->range().upper + dx));
         yAxis->setRange(QCPRange(yAxis->range().lower + dy, yAxis->range().upper + dy));
         setRange(xAxis->range());
-        m_plot->replot(QCustomPlot::rpQueuedReplot);
+        sqpApp->replotScheduler().scheduleReplot(*m_plot);
     }
 
     void move(double factor, Qt::Orientation orientation)
@@ -414,7 +509,7 @@ struct VisualizationGraphWidget::VisualizationGraphWidgetPrivate
         }
         if (orientation == Qt::Horizontal)
             setRange(axis->range());
-        m_plot->replot(QCustomPlot::rpQueuedReplot);
+        sqpApp->replotScheduler().scheduleReplot(*m_plot);
     }
 };
 
@@ -490,6 +585,9 @@ void VisualizationGraphWidget::addVariable(std::shared_ptr<Variable2> variable,
 
     impl->m_VariableToPlotMultiMap.insert({ variable, std::move(createdPlottables) });
 
+    // The new variable hasn't been prefetched with the others
+    impl->m_PanPrefetcher.reset();
+
     setGraphRange(range);
     // If the variable already has its data loaded, load its units and its range in the graph
     if (variable->data() != nullptr)
@@ -502,7 +600,7 @@ void VisualizationGraphWidget::addVariable(std::shared_ptr<Variable2> variable,
         connect(
             variable.get(), &Variable2::updated, context, [this, variable, context, range](QUuid) {
                 this->impl->m_RenderingDelegate->setAxesUnits(*variable);
-                this->impl->m_plot->replot(QCustomPlot::rpQueuedReplot);
+                sqpApp->replotScheduler().scheduleReplot(*this->impl->m_plot);
                 delete context;
             });
     }
@@ -523,6 +621,9 @@ void VisualizationGraphWidget::removeVariable(std::shared_ptr<Variable2> variabl
     {
         emit variableAboutToBeRemoved(variable);
 
+        impl->cancelDataPreparation(variable);
+        impl->m_AppliedData.erase(variable);
+
         auto& plottablesMap = variableIt->second;
 
         for (auto plottableIt = plottablesMap.cbegin(), plottableEnd = plottablesMap.cend();
@@ -536,7 +637,7 @@ void VisualizationGraphWidget::removeVariable(std::shared_ptr<Variable2> variabl
     }
 
     // Updates graph
-    impl->m_plot->replot(QCustomPlot::rpQueuedReplot);
+    sqpApp->replotScheduler().scheduleReplot(*impl->m_plot);
 }
 
 std::vector<std::shared_ptr<Variable2>> VisualizationGraphWidget::variables() const
@@ -583,6 +684,11 @@ void VisualizationGraphWidget::setAutoRangeOnVariableInitialization(bool value)
     impl->m_VariableAutoRangeOnInit = value;
 }
 
+void VisualizationGraphWidget::setSynchronisationGroupId(const QUuid& groupId)
+{
+    impl->m_SynchronisationGroupId = groupId;
+}
+
 QVector<DateTimeRange> VisualizationGraphWidget::selectionZoneRanges() const
 {
     QVector<DateTimeRange> ranges;
@@ -604,7 +710,7 @@ void VisualizationGraphWidget::addSelectionZones(const QVector<DateTimeRange>& r
         impl->addSelectionZone(zone);
     }
 
-    plot().replot(QCustomPlot::rpQueuedReplot);
+    sqpApp->replotScheduler().scheduleReplot(plot());
 }
 
 VisualizationSelectionZoneItem* VisualizationGraphWidget::addSelectionZone(
@@ -616,7 +722,7 @@ VisualizationSelectionZoneItem* VisualizationGraphWidget::addSelectionZone(
     zone->setRange(range.m_TStart, range.m_TEnd);
     impl->addSelectionZone(zone);
 
-    plot().replot(QCustomPlot::rpQueuedReplot);
+    sqpApp->replotScheduler().scheduleReplot(plot());
 
     return zone;
 }
@@ -633,7 +739,7 @@ void VisualizationGraphWidget::removeSelectionZone(VisualizationSelectionZoneIte
 
     impl->m_SelectionZones.removeAll(selectionZone);
     plot().removeItem(selectionZone);
-    plot().replot(QCustomPlot::rpQueuedReplot);
+    sqpApp->replotScheduler().scheduleReplot(plot());
 }
 
 void VisualizationGraphWidget::undoZoom()
@@ -645,7 +751,7 @@ void VisualizationGraphWidget::undoZoom()
     axisX->setRange(zoom.first);
     axisY->setRange(zoom.second);
 
-    plot().replot(QCustomPlot::rpQueuedReplot);
+    sqpApp->replotScheduler().scheduleReplot(plot());
 }
 
 void VisualizationGraphWidget::zoom(
@@ -796,6 +902,7 @@ void VisualizationGraphWidget::addVerticalCursor(double time)
     auto text
         = DateUtils::dateTime(time).toString(CURSOR_LABELS_DATETIME_FORMAT).replace(' ', '\n');
     impl->m_VerticalCursor->setLabelText(text);
+    impl->m_VerticalCursor->refresh();
 }
 
 void VisualizationGraphWidget::addVerticalCursorAtViewportPosition(double position)
@@ -807,12 +914,16 @@ void VisualizationGraphWidget::addVerticalCursorAtViewportPosition(double positi
     auto text
         = DateUtils::dateTime(axis->pixelToCoord(position)).toString(CURSOR_LABELS_DATETIME_FORMAT);
     impl->m_VerticalCursor->setLabelText(text);
+    impl->m_VerticalCursor->refresh();
 }
 
 void VisualizationGraphWidget::removeVerticalCursor()
 {
-    impl->m_VerticalCursor->setVisible(false);
-    plot().replot(QCustomPlot::rpQueuedReplot);
+    if (impl->m_VerticalCursor->isVisible())
+    {
+        impl->m_VerticalCursor->setVisible(false);
+        impl->m_VerticalCursor->refresh();
+    }
 }
 
 void VisualizationGraphWidget::addHorizontalCursor(double value)
@@ -820,6 +931,7 @@ void VisualizationGraphWidget::addHorizontalCursor(double value)
     impl->m_HorizontalCursor->setPosition(value);
     impl->m_HorizontalCursor->setVisible(true);
     impl->m_HorizontalCursor->setLabelText(QString::number(value));
+    impl->m_HorizontalCursor->refresh();
 }
 
 void VisualizationGraphWidget::addHorizontalCursorAtViewportPosition(double position)
@@ -829,12 +941,16 @@ void VisualizationGraphWidget::addHorizontalCursorAtViewportPosition(double posi
 
     auto axis = plot().axisRect()->axis(QCPAxis::atLeft);
     impl->m_HorizontalCursor->setLabelText(QString::number(axis->pixelToCoord(position)));
+    impl->m_HorizontalCursor->refresh();
 }
 
 void VisualizationGraphWidget::removeHorizontalCursor()
 {
-    impl->m_HorizontalCursor->setVisible(false);
-    plot().replot(QCustomPlot::rpQueuedReplot);
+    if (impl->m_HorizontalCursor->isVisible())
+    {
+        impl->m_HorizontalCursor->setVisible(false);
+        impl->m_HorizontalCursor->refresh();
+    }
 }
 
 void VisualizationGraphWidget::closeEvent(QCloseEvent* event)
@@ -851,6 +967,9 @@ void VisualizationGraphWidget::closeEvent(QCloseEvent* event)
     {
         emit variableAboutToBeRemoved(variableEntry.first);
     }
+
+    // The graph no longer belongs to the synchronization group of its zone
+    impl->m_SynchronisationGroupId = QUuid {};
 }
 
 void VisualizationGraphWidget::enterEvent(QEvent* event)
@@ -938,7 +1057,7 @@ void VisualizationGraphWidget::mouseMoveEvent(QMouseEvent* event)
                     QMouseEvent e { QEvent::MouseMove, posInPlot, event->button(), event->buttons(),
                         event->modifiers() };
                     sqpApp->sendEvent(this->impl->m_plot, &e);
-                    this->impl->m_plot->replot(QCustomPlot::rpImmediateRefresh);
+                    sqpApp->replotScheduler().replotLayer(*item->layer());
                 }
             }
         }
@@ -1097,7 +1216,7 @@ void VisualizationGraphWidget::keyPressEvent(QKeyEvent* event)
             break;
         case Qt::Key_M:
             impl->rescaleY();
-            impl->m_plot->replot(QCustomPlot::rpQueuedReplot);
+            sqpApp->replotScheduler().scheduleReplot(*impl->m_plot);
             break;
         case Qt::Key_Left:
             if (event->modifiers() != Qt::ControlModifier)
@@ -1311,7 +1430,6 @@ void VisualizationGraphWidget::onMouseMove(QMouseEvent* event) noexcept
             }
             selectionZoneItemUnderCursor->setHovered(true);
             impl->m_HoveredZone = selectionZoneItemUnderCursor;
-            plot().replot(QCustomPlot::rpQueuedReplot);
         }
     }
     else
@@ -1456,7 +1574,7 @@ void VisualizationGraphWidget::onMouseRelease(QMouseEvent* event) noexcept
             axisX->setRange(newAxisXRange);
             axisY->setRange(newAxisYRange);
 
-            plot().replot(QCustomPlot::rpQueuedReplot);
+            sqpApp->replotScheduler().scheduleReplot(plot());
         }
     }
 
@@ -1545,7 +1663,7 @@ void VisualizationGraphWidget::onDataCacheVariableUpdated()
             << "TORM: VisualizationGraphWidget::onDataCacheVariableUpdated E" << dateTime;
         if (dateTime.contains(variable->range()) || dateTime.intersect(variable->range()))
         {
-            impl->updateData(variableEntry.second, variable, variable->range());
+            impl->updateData(variable);
         }
     }
 }
@@ -1556,7 +1674,7 @@ void VisualizationGraphWidget::onUpdateVarDisplaying(
     auto it = impl->m_VariableToPlotMultiMap.find(variable);
     if (it != impl->m_VariableToPlotMultiMap.end())
     {
-        impl->updateData(it->second, variable, range);
+        impl->updateData(variable);
     }
 }
 
@@ -1566,7 +1684,7 @@ void VisualizationGraphWidget::variableUpdated(QUuid id)
     {
         if (var->ID() == id)
         {
-            impl->updateData(plotables, var, this->graphRange());
+            impl->updateData(var);
         }
     }
 }
@@ -1,8 +1,12 @@
 #include "Visualization/VisualizationSelectionZoneItem.h"
+#include "Visualization/ReplotScheduler.h"
 #include "Visualization/VisualizationGraphWidget.h"
 #include "Visualization/VisualizationSelectionZoneManager.h"
 #include "Visualization/VisualizationWidget.h"
 
+#include <Common/VisualizationDef.h>
+#include <SqpApplication.h>
+
 const QString &DEFAULT_COLOR = QStringLiteral("#E79D41");
 
 struct VisualizationSelectionZoneItem::VisualizationSelectionZoneItemPrivate {
@@ -98,7 +102,7 @@ struct VisualizationSelectionZoneItem::VisualizationSelectionZoneItemPrivate {
             if (newZoneStart < newZoneEnd) {
                 result = true;
                 otherZone->setRange(newZoneStart, newZoneEnd);
-                otherZone->parentPlot()->replot();
+                sqpApp->replotScheduler().replotLayer(*otherZone->layer());
             }
         }
 
@@ -115,8 +119,10 @@ VisualizationSelectionZoneItem::VisualizationSelectionZoneItem(QCustomPlot *plot
     bottomRight->setTypeX(QCPItemPosition::ptPlotCoords);
     bottomRight->setTypeY(QCPItemPosition::ptAxisRectRatio);
     setSelectable(false);
+    setLayer(SELECTION_ZONES_LAYER);
 
     impl->m_RightLine = new QCPItemStraightLine(plot);
+    impl->m_RightLine->setLayer(SELECTION_ZONES_LAYER);
     impl->m_RightLine->point1->setParentAnchor(topRight);
     impl->m_RightLine->point2->setParentAnchor(bottomRight);
     impl->m_RightLine->point1->setTypeX(QCPItemPosition::ptAbsolute);
@@ -126,6 +132,7 @@ VisualizationSelectionZoneItem::VisualizationSelectionZoneItem(QCustomPlot *plot
     impl->m_RightLine->setSelectable(false);
 
     impl->m_LeftLine = new QCPItemStraightLine(plot);
+    impl->m_LeftLine->setLayer(SELECTION_ZONES_LAYER);
     impl->m_LeftLine->point1->setParentAnchor(topLeft);
     impl->m_LeftLine->point2->setParentAnchor(bottomLeft);
     impl->m_LeftLine->point1->setTypeX(QCPItemPosition::ptAbsolute);
@@ -164,6 +171,7 @@ void VisualizationSelectionZoneItem::setName(const QString &name)
     }
     else if (!impl->m_NameLabelItem) {
         impl->m_NameLabelItem = new QCPItemText(impl->m_Plot);
+        impl->m_NameLabelItem->setLayer(SELECTION_ZONES_LAYER);
         impl->m_NameLabelItem->setText(name);
         impl->m_NameLabelItem->setPositionAlignment(Qt::AlignHCenter | Qt::AlignTop);
         impl->m_NameLabelItem->setColor(impl->m_Color);
@@ -295,6 +303,8 @@ void VisualizationSelectionZoneItem::setHovered(bool value)
     else {
         setColor(impl->m_Color);
     }
+
+    sqpApp->replotScheduler().replotLayer(*layer());
 }
 
 void VisualizationSelectionZoneItem::setAssociatedEditedZones(
@@ -391,7 +401,7 @@ void VisualizationSelectionZoneItem::mouseMoveEvent(QMouseEvent *event, const QP
         emit rangeEdited(range());
 
         for (auto associatedZone : impl->m_AssociatedEditedZones) {
-            associatedZone->parentPlot()->replot();
+            sqpApp->replotScheduler().replotLayer(*associatedZone->layer());
             emit associatedZone->rangeEdited(associatedZone->range());
         }
     }
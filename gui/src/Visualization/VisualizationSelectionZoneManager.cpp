@@ -1,6 +1,9 @@
 #include "Visualization/VisualizationSelectionZoneManager.h"
+#include "Visualization/ReplotScheduler.h"
 #include "Visualization/VisualizationSelectionZoneItem.h"
 
+#include <SqpApplication.h>
+
 struct VisualizationSelectionZoneManager::VisualizationSelectionZoneManagerPrivate {
     QVector<VisualizationSelectionZoneItem *> m_SelectedItems;
 };
@@ -24,7 +27,7 @@ void VisualizationSelectionZoneManager::setSelected(VisualizationSelectionZoneIt
 {
     if (value != item->selected()) {
         item->setSelected(value);
-        item->parentPlot()->replot(QCustomPlot::rpQueuedReplot);
+        sqpApp->replotScheduler().replotLayer(*item->layer());
     }
 
     if (!value && impl->m_SelectedItems.contains(item)) {
@@ -39,9 +42,8 @@ void VisualizationSelectionZoneManager::clearSelection()
 {
     for (auto item : impl->m_SelectedItems) {
         item->setSelected(false);
-        auto parentPlot = item->parentPlot();
-        if (parentPlot) {
-            parentPlot->replot(QCustomPlot::rpQueuedReplot);
+        if (auto layer = item->layer()) {
+            sqpApp->replotScheduler().replotLayer(*layer);
         }
     }
 
@@ -200,6 +200,7 @@ void VisualizationZoneWidget::insertGraph(int index, VisualizationGraphWidget* g
 
     // Synchronize new graph with others in the zone
     impl->m_Synchronizer->addGraph(*graphWidget);
+    graphWidget->setSynchronisationGroupId(impl->m_SynchronisationGroupId);
 
     ui->dragDropContainer->insertDragWidget(index, graphWidget);
 }
@@ -649,6 +650,9 @@ void VisualizationZoneWidget::VisualizationZoneWidgetPrivate::dropGraph(
                     graphWidget->setGraphRange(visualizationGraphWidget->graphRange());
                 }
             }
+
+            // The graph leaves the synchronization group of its previous zone
+            graphWidget->setSynchronisationGroupId(zoneWidget->impl->m_SynchronisationGroupId);
         }
 
         zoneWidget->ui->dragDropContainer->insertDragWidget(index, graphWidget);
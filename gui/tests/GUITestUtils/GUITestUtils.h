@@ -149,6 +149,8 @@ ALIAS_TEMPLATE_FUNCTION(isReady, static_cast<SqpApplication*>(qApp)->variableCon
 
 void waitForVar(std::shared_ptr<Variable2> var)
 {
+    // Range changes are issued at the end of the current event loop iteration
+    QCoreApplication::processEvents();
     while (!isReady(var))
         QCoreApplication::processEvents();
 }
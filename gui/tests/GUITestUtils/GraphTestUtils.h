@@ -0,0 +1,55 @@
+#ifndef GRAPHTESTUTILS_H
+#define GRAPHTESTUTILS_H
+
+#include <Visualization/TimeSeriesGraph.h>
+
+#include <memory>
+#include <vector>
+
+/// Keys and values of a serie displayed by graphs, owned by the views on them. Each sample holds
+/// @c m_Stride contiguous values, one per component
+struct GraphTestBuffers
+{
+    std::vector<double> m_Keys;
+    std::vector<double> m_Values;
+    std::size_t m_Stride { 1 };
+};
+
+/**
+ * Generates the buffers of a serie
+ * @param keyFun function giving the key of a sample from its index
+ * @param valueFun function giving a value from the index of its sample and its component
+ */
+template <typename KeyFun, typename ValueFun>
+std::shared_ptr<GraphTestBuffers> generateGraphBuffers(
+    std::size_t size, std::size_t stride, KeyFun keyFun, ValueFun valueFun)
+{
+    auto buffers = std::make_shared<GraphTestBuffers>();
+    buffers->m_Stride = stride;
+    buffers->m_Keys.reserve(size);
+    buffers->m_Values.reserve(size * stride);
+    for (auto index = std::size_t { 0 }; index < size; ++index)
+    {
+        buffers->m_Keys.push_back(keyFun(index));
+        for (auto component = std::size_t { 0 }; component < stride; ++component)
+        {
+            buffers->m_Values.push_back(valueFun(index, component));
+        }
+    }
+    return buffers;
+}
+
+/// Returns a view on a component of the buffers, as set in a graph
+inline TimeSeriesGraphData graphDataView(
+    const std::shared_ptr<GraphTestBuffers>& buffers, std::size_t component = 0)
+{
+    auto data = TimeSeriesGraphData {};
+    data.m_Owner = buffers;
+    data.m_Keys = buffers->m_Keys.data();
+    data.m_Values = buffers->m_Values.data() + component;
+    data.m_Stride = buffers->m_Stride;
+    data.m_Size = buffers->m_Keys.size();
+    return data;
+}
+
+#endif // GRAPHTESTUTILS_H
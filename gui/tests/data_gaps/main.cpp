@@ -0,0 +1,99 @@
+#include <QObject>
+#include <QtTest>
+
+#include <DataSource/DataGaps.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+const auto NaN = std::numeric_limits<double>::quiet_NaN();
+
+bool isSame(const DataGaps& gaps, const std::vector<DataGaps::Gap>& expected)
+{
+    return std::equal(std::cbegin(gaps.m_Gaps), std::cend(gaps.m_Gaps), std::cbegin(expected),
+        std::cend(expected), [](const auto& gap, const auto& other) {
+            return gap.m_TStart == other.m_TStart && gap.m_TEnd == other.m_TEnd;
+        });
+}
+
+} // namespace
+
+class A_DataGaps : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_DataGaps(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void has_no_gap_for_regular_data()
+    {
+        auto xAxis = std::vector<double> { 0., 1., 2., 3., 4. };
+        QVERIFY(DataGaps::find(xAxis, 1.).empty());
+        QVERIFY(DataGaps::find(xAxis, 1., 0., 4.).empty());
+    }
+
+    void finds_the_intervals_wider_than_the_resolution()
+    {
+        auto xAxis = std::vector<double> { 0., 1., 2., 10., 11., 12., 30. };
+        QVERIFY(isSame(DataGaps::find(xAxis, 1.5), { { 2., 10. }, { 12., 30. } }));
+
+        // An interval equal to the resolution isn't a gap
+        QVERIFY(isSame(DataGaps::find(xAxis, 8.), { { 12., 30. } }));
+    }
+
+    void finds_the_gaps_at_the_bounds_of_the_range()
+    {
+        auto xAxis = std::vector<double> { 10., 11., 12. };
+        QVERIFY(isSame(DataGaps::find(xAxis, 1., 0., 20.), { { 0., 10. }, { 12., 20. } }));
+        QVERIFY(isSame(DataGaps::find(xAxis, 1., 9., 20.), { { 12., 20. } }));
+        QVERIFY(isSame(DataGaps::find(xAxis, 1., NaN, 20.), { { 12., 20. } }));
+        QVERIFY(isSame(DataGaps::find(xAxis, 1., 0., NaN), { { 0., 10. } }));
+    }
+
+    void has_no_gap_without_resolution_or_data()
+    {
+        auto xAxis = std::vector<double> { 0., 10., 20. };
+        QVERIFY(DataGaps::find(xAxis, NaN).empty());
+        QVERIFY(DataGaps::find(xAxis, 0.).empty());
+        QVERIFY(DataGaps::find(xAxis, -1.).empty());
+        QVERIFY(DataGaps::find({}, 1., 0., 10.).empty());
+    }
+
+    void contains_the_times_strictly_inside_its_gaps()
+    {
+        auto gaps = DataGaps::find({ 0., 1., 2., 10., 11., 12., 30. }, 1.5);
+        QVERIFY(gaps.contains(5.));
+        QVERIFY(gaps.contains(20.));
+        QVERIFY(!gaps.contains(2.));
+        QVERIFY(!gaps.contains(10.));
+        QVERIFY(!gaps.contains(11.));
+        QVERIFY(!gaps.contains(-1.));
+        QVERIFY(!gaps.contains(40.));
+        QVERIFY(!DataGaps {}.contains(5.));
+    }
+
+    void has_as_many_gaps_as_interruptions_of_the_data()
+    {
+        // A serie of 10000 lines interrupted every 1000 lines
+        auto xAxis = std::vector<double> {};
+        for (auto index = 0; index < 10000; ++index)
+        {
+            xAxis.push_back(index + 100. * (index / 1000));
+        }
+
+        auto gaps = DataGaps::find(xAxis, 1.);
+        QCOMPARE(gaps.m_Gaps.size(), std::size_t { 9 });
+        for (const auto& gap : gaps.m_Gaps)
+        {
+            QCOMPARE(gap.m_TEnd - gap.m_TStart, 101.);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(A_DataGaps)
+
+#include "main.moc"
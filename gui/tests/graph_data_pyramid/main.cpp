@@ -0,0 +1,232 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Visualization/GraphDataPyramid.h>
+
+#include <GraphTestUtils.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+/// Size of the data, enough for several levels
+const auto DATA_SIZE = std::size_t { 1 } << 20;
+
+/// Pixel counts for which the levels of pyramids are compared, from the coarsest level to the raw
+/// data
+const auto PIXELS = { 1, 1000, 4000, 30000, 200000, 1 << 20 };
+
+/// Generates a signal of @p size samples, with holes of NaN values. The largest hole spans several
+/// buckets of the coarsest level
+std::shared_ptr<GraphTestBuffers> generate(std::size_t size)
+{
+    auto isHole = [](std::size_t index) {
+        return index % 50000 < 1000 || (index >= 300000 && index < 400000);
+    };
+
+    return generateGraphBuffers(size, 1, [](auto index) { return static_cast<double>(index); },
+        [&isHole](auto index, auto) {
+            return isHole(index) ? std::numeric_limits<double>::quiet_NaN()
+                                 : std::sin(index * 0.001) + std::cos(index * 0.37) * 0.1;
+        });
+}
+
+/// Returns a view on the first @p size samples of the buffers
+TimeSeriesGraphData view(const std::shared_ptr<GraphTestBuffers>& buffers, std::size_t size)
+{
+    return graphDataView(buffers).slice(0, size);
+}
+
+bool isSame(const TimeSeriesGraphData& data, const TimeSeriesGraphData& other)
+{
+    if (data.size() != other.size())
+    {
+        return false;
+    }
+    for (auto index = std::size_t { 0 }; index < data.size(); ++index)
+    {
+        auto value = data.value(index), otherValue = other.value(index);
+        if (data.key(index) != other.key(index)
+            || !(value == otherValue || (std::isnan(value) && std::isnan(otherValue))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Returns true if two pyramids have the same levels
+bool isSame(const GraphDataPyramid& pyramid, const GraphDataPyramid& other)
+{
+    if (pyramid.levelCount() != other.levelCount())
+    {
+        return false;
+    }
+
+    auto keyRange = QCPRange { pyramid.data().key(0),
+        pyramid.data().key(pyramid.data().size() - 1) };
+    for (auto pixels : PIXELS)
+    {
+        if (!isSame(pyramid.level(keyRange, pixels), other.level(keyRange, pixels)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+class A_GraphDataPyramid : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_GraphDataPyramid(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void is_only_needed_for_big_data()
+    {
+        QVERIFY(!GraphDataPyramid::isNeeded(1000));
+        QVERIFY(GraphDataPyramid::isNeeded(DATA_SIZE));
+    }
+
+    void has_levels_coarser_than_the_data()
+    {
+        auto buffers = generate(DATA_SIZE);
+        auto pyramid = GraphDataPyramid { view(buffers, DATA_SIZE) };
+        QVERIFY(pyramid.levelCount() >= 2);
+        QVERIFY(pyramid.isBuiltFrom(view(buffers, DATA_SIZE)));
+        QVERIFY(!pyramid.isBuiltFrom(view(buffers, DATA_SIZE - 1)));
+
+        // The coarsest level keeps at least two samples per pixel column, the raw data is returned
+        // when no level is fine enough
+        auto keyRange = QCPRange { 0., static_cast<double>(DATA_SIZE - 1) };
+        auto coarsest = pyramid.level(keyRange, 1);
+        QVERIFY(coarsest.size() < DATA_SIZE / GraphDataPyramid::LEVEL_FACTOR);
+        QVERIFY(coarsest.size() >= 2);
+        QVERIFY(isSame(pyramid.level(keyRange, static_cast<int>(DATA_SIZE)), pyramid.data()));
+    }
+
+    void keeps_min_max_and_holes_of_the_data()
+    {
+        auto buffers = generate(DATA_SIZE);
+        auto pyramid = GraphDataPyramid { view(buffers, DATA_SIZE) };
+
+        auto keyRange = QCPRange { 0., static_cast<double>(DATA_SIZE - 1) };
+        auto level = pyramid.level(keyRange, 1);
+        auto hasNaN = false;
+        auto min = std::numeric_limits<double>::max(), max = std::numeric_limits<double>::lowest();
+        for (auto index = std::size_t { 0 }; index < level.size(); ++index)
+        {
+            if (std::isnan(level.value(index)))
+            {
+                hasNaN = true;
+                continue;
+            }
+            min = std::min(min, level.value(index));
+            max = std::max(max, level.value(index));
+        }
+
+        auto dataMin = std::numeric_limits<double>::max();
+        auto dataMax = std::numeric_limits<double>::lowest();
+        for (auto value : buffers->m_Values)
+        {
+            if (!std::isnan(value))
+            {
+                dataMin = std::min(dataMin, value);
+                dataMax = std::max(dataMax, value);
+            }
+        }
+        QVERIFY(hasNaN);
+        QCOMPARE(min, dataMin);
+        QCOMPARE(max, dataMax);
+    }
+
+    void gives_the_same_levels_when_appended_as_when_rebuilt()
+    {
+        auto buffers = generate(DATA_SIZE);
+
+        // Data is appended in chunks that don't fill the buckets of the levels
+        auto pyramid = std::make_shared<const GraphDataPyramid>(view(buffers, DATA_SIZE / 4));
+        for (auto size = DATA_SIZE / 4 + 12345; size < DATA_SIZE; size += 77777)
+        {
+            pyramid = pyramid->append(view(buffers, size), 0.);
+            QVERIFY(pyramid != nullptr);
+            QVERIFY(isSame(*pyramid, GraphDataPyramid { view(buffers, size) }));
+        }
+
+        pyramid = pyramid->append(view(buffers, DATA_SIZE), 0.);
+        QVERIFY(pyramid != nullptr);
+        QVERIFY(isSame(*pyramid, GraphDataPyramid { view(buffers, DATA_SIZE) }));
+    }
+
+    void keeps_previous_pyramids_unchanged_when_appended()
+    {
+        auto buffers = generate(DATA_SIZE);
+        auto pyramid = std::make_shared<const GraphDataPyramid>(view(buffers, DATA_SIZE / 2));
+        auto appended = pyramid->append(view(buffers, DATA_SIZE), 0.);
+        QVERIFY(appended != nullptr);
+
+        // Both pyramids share the buffers of their levels
+        QVERIFY(isSame(*pyramid, GraphDataPyramid { view(buffers, DATA_SIZE / 2) }));
+        QVERIFY(isSame(*appended, GraphDataPyramid { view(buffers, DATA_SIZE) }));
+
+        // Appending again to the first pyramid can't extend the shared buffers in place
+        auto otherAppended = pyramid->append(view(buffers, DATA_SIZE * 3 / 4), 0.);
+        QVERIFY(otherAppended != nullptr);
+        QVERIFY(isSame(*otherAppended, GraphDataPyramid { view(buffers, DATA_SIZE * 3 / 4) }));
+        QVERIFY(isSame(*appended, GraphDataPyramid { view(buffers, DATA_SIZE) }));
+    }
+
+    void drops_the_samples_before_the_window()
+    {
+        auto buffers = generate(DATA_SIZE);
+        auto pyramid = std::make_shared<const GraphDataPyramid>(view(buffers, DATA_SIZE / 2));
+
+        auto windowStart = static_cast<double>(DATA_SIZE / 4);
+        auto appended = pyramid->append(view(buffers, DATA_SIZE), windowStart);
+        QVERIFY(appended != nullptr);
+        QCOMPARE(appended->data().key(0), windowStart);
+        QCOMPARE(appended->data().size(), DATA_SIZE - DATA_SIZE / 4);
+
+        auto keyRange = QCPRange { 0., static_cast<double>(DATA_SIZE - 1) };
+        for (auto pixels : PIXELS)
+        {
+            auto level = appended->level(keyRange, pixels);
+            QVERIFY(level.size() > 0);
+            QVERIFY(level.key(0) >= windowStart);
+        }
+    }
+
+    void is_rebuilt_when_data_isnt_an_extension()
+    {
+        auto buffers = generate(DATA_SIZE);
+        auto pyramid = GraphDataPyramid { view(buffers, DATA_SIZE / 2) };
+
+        // Data starting before the data of the pyramid
+        auto earlierBuffers = std::make_shared<GraphTestBuffers>(*buffers);
+        for (auto& key : earlierBuffers->m_Keys)
+        {
+            key -= 1.;
+        }
+        QVERIFY(pyramid.append(view(earlierBuffers, DATA_SIZE), 0.) == nullptr);
+
+        // Data whose last sample of the pyramid has changed
+        auto changedBuffers = std::make_shared<GraphTestBuffers>(*buffers);
+        changedBuffers->m_Values[DATA_SIZE / 2 - 1] += 1.;
+        QVERIFY(pyramid.append(view(changedBuffers, DATA_SIZE), 0.) == nullptr);
+
+        // Data that doesn't contain the last sample of the pyramid
+        QVERIFY(pyramid.append(view(buffers, DATA_SIZE / 4), 0.) == nullptr);
+
+        QVERIFY(pyramid.append(view(buffers, DATA_SIZE), 0.) != nullptr);
+    }
+};
+
+QTEST_GUILESS_MAIN(A_GraphDataPyramid)
+
+#include "main.moc"
@@ -0,0 +1,129 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Visualization/GraphDecimation.h>
+#include <Visualization/qcustomplot.h>
+
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using Samples = std::vector<std::pair<double, double>>;
+
+const auto NaN = std::numeric_limits<double>::quiet_NaN();
+
+/// Decimates samples in columns of @p columnWidth starting from 0
+Samples envelope(const Samples& samples, double columnWidth)
+{
+    auto result = Samples {};
+    GraphDecimation::envelope(
+        std::cbegin(samples), std::cend(samples), [](const auto& sample) { return sample.first; },
+        [](const auto& sample) { return sample.second; }, 0., columnWidth,
+        [&result](double key, double value) { result.emplace_back(key, value); });
+    return result;
+}
+
+bool isSame(const Samples& samples, const Samples& expected)
+{
+    return std::equal(std::cbegin(samples), std::cend(samples), std::cbegin(expected),
+        std::cend(expected), [](const auto& sample, const auto& other) {
+            return sample.first == other.first
+                && (sample.second == other.second
+                    || (std::isnan(sample.second) && std::isnan(other.second)));
+        });
+}
+
+} // namespace
+
+class A_GraphDecimation : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_GraphDecimation(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void is_only_needed_above_four_samples_per_pixel()
+    {
+        QVERIFY(!GraphDecimation::isDecimationNeeded(400, 100));
+        QVERIFY(GraphDecimation::isDecimationNeeded(401, 100));
+        QVERIFY(!GraphDecimation::isDecimationNeeded(1000, 0));
+    }
+
+    void keeps_first_min_max_and_last_samples_of_a_column_in_time_order()
+    {
+        auto samples = Samples { { 0., 2. }, { 1., 5. }, { 2., -1. }, { 3., 3. }, { 4., 1. } };
+        QVERIFY(isSame(
+            envelope(samples, 10.), { { 0., 2. }, { 1., 5. }, { 2., -1. }, { 4., 1. } }));
+    }
+
+    void emits_samples_shared_by_first_min_max_and_last_once()
+    {
+        // The first sample is the min, the last one the max
+        auto samples = Samples { { 0., 0. }, { 1., 1. }, { 2., 2. } };
+        QVERIFY(isSame(envelope(samples, 10.), { { 0., 0. }, { 2., 2. } }));
+
+        auto single = Samples { { 5., 3. } };
+        QVERIFY(isSame(envelope(single, 10.), single));
+    }
+
+    void reduces_each_column_separately()
+    {
+        auto samples = Samples { { 0., 1. }, { 1., 3. }, { 2., 2. }, { 10., 7. }, { 11., 4. },
+            { 12., 9. }, { 13., 8. } };
+        QVERIFY(isSame(envelope(samples, 10.),
+            { { 0., 1. }, { 1., 3. }, { 2., 2. }, { 10., 7. }, { 11., 4. }, { 12., 9. },
+                { 13., 8. } }));
+    }
+
+    void ignores_nan_values_in_envelopes()
+    {
+        auto samples = Samples { { 0., NaN }, { 1., 4. }, { 2., NaN }, { 3., -4. }, { 4., NaN } };
+        QVERIFY(isSame(envelope(samples, 10.), { { 1., 4. }, { 3., -4. } }));
+    }
+
+    void keeps_columns_of_nan_values_as_holes()
+    {
+        auto samples = Samples { { 0., 1. }, { 1., 2. }, { 10., NaN }, { 11., NaN }, { 20., 3. } };
+        QVERIFY(isSame(
+            envelope(samples, 10.), { { 0., 1. }, { 1., 2. }, { 10., NaN }, { 20., 3. } }));
+    }
+
+    void emits_nothing_for_no_samples()
+    {
+        QVERIFY(envelope(Samples {}, 10.).empty());
+    }
+
+    void gives_the_vertical_extent_of_dense_columns()
+    {
+        auto samples = Samples {};
+        for (auto i = 0; i < 100000; ++i)
+        {
+            samples.emplace_back(i / 1000., std::sin(i * 0.01));
+        }
+
+        // Each column of 1 key unit holds 1000 samples, reduced to at most 4
+        auto result = envelope(samples, 1.);
+        QVERIFY(result.size() <= 4 * 100);
+
+        auto extents = [](const Samples& samples) {
+            auto result = std::vector<QCPRange>(100, QCPRange { std::numeric_limits<double>::max(),
+                                                         std::numeric_limits<double>::lowest() });
+            for (const auto& [key, value] : samples)
+            {
+                auto& extent = result[static_cast<std::size_t>(std::floor(key))];
+                extent.lower = std::min(extent.lower, value);
+                extent.upper = std::max(extent.upper, value);
+            }
+            return result;
+        };
+        QVERIFY(extents(result) == extents(samples));
+    }
+};
+
+QTEST_GUILESS_MAIN(A_GraphDecimation)
+
+#include "main.moc"
@@ -0,0 +1,174 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Visualization/MinMaxKernels.h>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace
+{
+
+const auto NaN = std::numeric_limits<double>::quiet_NaN();
+
+/// Max number of values reduced: several iterations of the widest SIMD loop (AVX, 8 values), plus
+/// every size of the remainder left to the scalar reduction
+const auto MAX_SIZE = std::size_t { 40 };
+
+/// Reference reduction, value by value
+std::optional<QCPRange> referenceMinMax(
+    const std::vector<double>& values, std::size_t size, std::size_t stride)
+{
+    auto result = std::optional<QCPRange> {};
+    for (auto index = std::size_t { 0 }; index < size; ++index)
+    {
+        auto value = values[index * stride];
+        if (!std::isnan(value))
+        {
+            result = result
+                ? QCPRange { std::min(result->lower, value), std::max(result->upper, value) }
+                : QCPRange { value, value };
+        }
+    }
+    return result;
+}
+
+/// Generates values, distinct so that the position of the min and the max matters
+std::vector<double> generate(std::size_t size)
+{
+    auto values = std::vector<double>(size);
+    for (auto index = std::size_t { 0 }; index < size; ++index)
+    {
+        values[index] = std::sin(index * 1.7) * (index + 1);
+    }
+    return values;
+}
+
+} // namespace
+
+/**
+ * Kernels are chosen when the library is compiled (AVX, SSE2 or scalar): sizes and positions of
+ * NaN values are chosen so that every lane of the SIMD loop and every size of its remainder are
+ * covered whatever the kernel
+ */
+class A_MinMaxKernel : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_MinMaxKernel(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void gives_nothing_for_no_values()
+    {
+        auto values = std::vector<double> { 1. };
+        QVERIFY(!MinMaxKernels::minMax(values.data(), 0));
+        QVERIFY(!MinMaxKernels::minMax(values.data(), 0, 3));
+    }
+
+    void reduces_contiguous_values_of_any_size()
+    {
+        for (auto size = std::size_t { 1 }; size <= MAX_SIZE; ++size)
+        {
+            auto values = generate(size);
+            QCOMPARE(MinMaxKernels::minMax(values.data(), size), referenceMinMax(values, size, 1));
+        }
+    }
+
+    void finds_the_min_and_max_in_any_lane()
+    {
+        for (auto size = std::size_t { 1 }; size <= MAX_SIZE; ++size)
+        {
+            for (auto position = std::size_t { 0 }; position < size; ++position)
+            {
+                auto values = std::vector<double>(size, 0.);
+                values[position] = 1.;
+                QVERIFY(MinMaxKernels::minMax(values.data(), size) == QCPRange(0., 1.));
+                values[position] = -1.;
+                QVERIFY(MinMaxKernels::minMax(values.data(), size) == QCPRange(-1., 0.));
+            }
+        }
+    }
+
+    void ignores_nan_values_in_any_lane()
+    {
+        for (auto size = std::size_t { 1 }; size <= MAX_SIZE; ++size)
+        {
+            for (auto position = std::size_t { 0 }; position < size; ++position)
+            {
+                // A single NaN value
+                auto values = generate(size);
+                values[position] = NaN;
+                QCOMPARE(MinMaxKernels::minMax(values.data(), size),
+                    referenceMinMax(values, size, 1));
+
+                // All values but one are NaN
+                auto nanValues = std::vector<double>(size, NaN);
+                nanValues[position] = 2.;
+                QVERIFY(MinMaxKernels::minMax(nanValues.data(), size) == QCPRange(2., 2.));
+            }
+        }
+    }
+
+    void ignores_leading_and_trailing_nan_values()
+    {
+        // NaN values as first operand of the SIMD min/max must not replace the accumulators
+        auto values = generate(MAX_SIZE);
+        for (auto index = std::size_t { 0 }; index < 8; ++index)
+        {
+            values[index] = NaN;
+            values[MAX_SIZE - 1 - index] = NaN;
+        }
+        QCOMPARE(MinMaxKernels::minMax(values.data(), MAX_SIZE),
+            referenceMinMax(values, MAX_SIZE, 1));
+    }
+
+    void gives_nothing_for_nan_values_only()
+    {
+        for (auto size = std::size_t { 1 }; size <= MAX_SIZE; ++size)
+        {
+            auto values = std::vector<double>(size, NaN);
+            QVERIFY(!MinMaxKernels::minMax(values.data(), size));
+            QVERIFY(!MinMaxKernels::minMax(values.data(), size / 2, 2));
+        }
+    }
+
+    void keeps_infinite_values()
+    {
+        auto values = std::vector<double>(MAX_SIZE, 0.);
+        values[3] = std::numeric_limits<double>::infinity();
+        values[17] = -std::numeric_limits<double>::infinity();
+        auto infinity = std::numeric_limits<double>::infinity();
+        QVERIFY(MinMaxKernels::minMax(values.data(), MAX_SIZE) == QCPRange(-infinity, infinity));
+    }
+
+    void reduces_strided_values()
+    {
+        // Components of a vector serie, the first one having NaN values
+        for (auto size = std::size_t { 1 }; size <= MAX_SIZE; ++size)
+        {
+            auto values = generate(3 * size);
+            for (auto sample = std::size_t { 0 }; sample < size; sample += 3)
+            {
+                values[3 * sample] = NaN;
+            }
+
+            for (auto component = std::size_t { 0 }; component < 3; ++component)
+            {
+                auto componentValues
+                    = std::vector<double>(values.cbegin() + component, values.cend());
+                QCOMPARE(MinMaxKernels::minMax(values.data() + component, size, 3),
+                    referenceMinMax(componentValues, size, 3));
+            }
+
+            // A stride of one is a contiguous reduction
+            QCOMPARE(MinMaxKernels::minMax(values.data(), 3 * size, 1),
+                referenceMinMax(values, 3 * size, 1));
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(A_MinMaxKernel)
+
+#include "main.moc"
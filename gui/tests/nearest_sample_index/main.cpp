@@ -0,0 +1,193 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Visualization/NearestSampleIndex.h>
+#include <Visualization/TimeSeriesGraph.h>
+
+#include <GraphTestUtils.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+const auto NaN = std::numeric_limits<double>::quiet_NaN();
+
+/// Number of samples of dense data: far more than the pixel columns of the plot
+const auto DENSE_SIZE = std::size_t { 1000000 };
+
+/// Generates a sample every 100 s from 0 to 1000 s, of value 0
+std::shared_ptr<GraphTestBuffers> sparseBuffers()
+{
+    return generateGraphBuffers(
+        11, 1, [](auto index) { return index * 100.; }, [](auto, auto) { return 0.; });
+}
+
+/// Generates samples from 0 to 1000 s, whose values spread over [-1, 1] in each pixel column
+std::shared_ptr<GraphTestBuffers> denseBuffers()
+{
+    return generateGraphBuffers(DENSE_SIZE, 1,
+        [](auto index) { return index * 1000. / DENSE_SIZE; },
+        [](auto index, auto) { return std::sin(index * 0.37); });
+}
+
+/// Returns the distance of the closest sample to a position, by testing all the samples
+double bruteForceDistance(const TimeSeriesGraph& graph, const QPoint& pos)
+{
+    const auto& data = graph.data();
+    auto result = std::numeric_limits<double>::max();
+    for (auto index = std::size_t { 0 }; index < data.size(); ++index)
+    {
+        if (!std::isnan(data.value(index)))
+        {
+            auto samplePos = graph.coordsToPixels(data.key(index), data.value(index));
+            result = std::min(result, QLineF { samplePos, pos }.length());
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+class A_NearestSampleIndex : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_NearestSampleIndex(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void init()
+    {
+        m_Plot = std::make_unique<QCustomPlot>();
+        m_Plot->resize(800, 600);
+        m_Plot->xAxis->setRange(0., 1000.);
+        m_Plot->yAxis->setRange(-1.5, 1.5);
+        m_Graph = new TimeSeriesGraph { m_Plot->xAxis, m_Plot->yAxis };
+        m_Plot->replot();
+    }
+
+    void cleanup() { m_Plot.reset(); }
+
+    void finds_the_closest_sample_of_sparse_data()
+    {
+        m_Graph->setData(graphDataView(sparseBuffers()));
+        auto samplePos = m_Graph->coordsToPixels(300., 0.).toPoint();
+        auto pos = samplePos + QPoint { 3, 2 };
+
+        auto index = NearestSampleIndex {};
+        auto sample = index.nearest(*m_Plot, pos, 10.);
+        QVERIFY(sample);
+        QCOMPARE(sample->m_Graph, m_Graph);
+        QCOMPARE(sample->m_Index, std::size_t { 3 });
+        QCOMPARE(sample->m_Distance, QLineF(m_Graph->coordsToPixels(300., 0.), pos).length());
+    }
+
+    void ignores_nan_values()
+    {
+        auto buffers = sparseBuffers();
+        buffers->m_Values[3] = NaN;
+        m_Graph->setData(graphDataView(buffers));
+
+        // The sample at 400 s is the closest one once the sample at 300 s is ignored
+        auto pos = m_Graph->coordsToPixels(310., 0.).toPoint();
+        auto sample = NearestSampleIndex {}.nearest(*m_Plot, pos, 1000.);
+        QVERIFY(sample);
+        QCOMPARE(sample->m_Index, std::size_t { 4 });
+    }
+
+    void finds_nothing_farther_than_the_max_distance()
+    {
+        m_Graph->setData(graphDataView(sparseBuffers()));
+        auto pos = m_Graph->coordsToPixels(300., 0.).toPoint() + QPoint { 0, 20 };
+
+        auto index = NearestSampleIndex {};
+        QVERIFY(!index.nearest(*m_Plot, pos, 10.));
+        QVERIFY(index.nearest(*m_Plot, pos, 30.));
+    }
+
+    void finds_nothing_outside_of_the_axis_rect()
+    {
+        m_Graph->setData(graphDataView(sparseBuffers()));
+        auto axisRect = m_Plot->axisRect()->rect();
+
+        auto index = NearestSampleIndex {};
+        QVERIFY(!index.nearest(*m_Plot, axisRect.topLeft() - QPoint { 1, 1 }, 1000.));
+        QVERIFY(!index.nearest(*m_Plot, axisRect.bottomRight() + QPoint { 1, 1 }, 1000.));
+        QVERIFY(index.nearest(*m_Plot, axisRect.center(), 1000.));
+    }
+
+    void finds_the_closest_sample_of_dense_data()
+    {
+        m_Graph->setData(graphDataView(denseBuffers()));
+        auto axisRect = m_Plot->axisRect()->rect();
+
+        // The sample found is in the column of the position, less than a pixel farther than the
+        // closest sample, which may be in a neighbour column
+        auto index = NearestSampleIndex {};
+        for (auto y = axisRect.top() + 5; y < axisRect.bottom(); y += 53)
+        {
+            auto pos = QPoint { axisRect.center().x(), y };
+            auto sample = index.nearest(*m_Plot, pos, 1000.);
+            QVERIFY(sample);
+            QVERIFY(sample->m_Distance <= bruteForceDistance(*m_Graph, pos) + 1.);
+        }
+    }
+
+    void finds_the_samples_of_the_new_data_once_invalidated()
+    {
+        auto buffers = denseBuffers();
+        m_Graph->setData(graphDataView(buffers));
+        auto pos = m_Plot->axisRect()->rect().center();
+
+        auto index = NearestSampleIndex {};
+        QVERIFY(index.nearest(*m_Plot, pos, 1000.));
+
+        // Values change in the same buffers
+        for (auto& value : buffers->m_Values)
+        {
+            value = value / 2. + 0.5;
+        }
+        index.invalidate();
+        auto sample = index.nearest(*m_Plot, pos, 1000.);
+        QVERIFY(sample);
+        QVERIFY(sample->m_Distance <= bruteForceDistance(*m_Graph, pos) + 1.);
+    }
+
+    void finds_the_samples_of_columns_hovered_again()
+    {
+        m_Graph->setData(graphDataView(denseBuffers()));
+        auto axisRect = m_Plot->axisRect()->rect();
+
+        // The mouse sweeps more columns than the cached ones, then comes back
+        auto index = NearestSampleIndex {};
+        auto positions = std::vector<QPoint> {};
+        for (auto x = axisRect.left() + 2; x < axisRect.right(); x += 37)
+        {
+            positions.push_back({ x, axisRect.center().y() + (x % 7) * 10 });
+        }
+        QVERIFY(positions.size() > 8);
+        auto first = positions[0];
+        auto second = positions[1];
+        positions.push_back(first);
+        positions.push_back(second);
+
+        for (const auto& pos : positions)
+        {
+            auto sample = index.nearest(*m_Plot, pos, 1000.);
+            QVERIFY(sample);
+            QVERIFY(sample->m_Distance <= bruteForceDistance(*m_Graph, pos) + 1.);
+        }
+    }
+
+private:
+    std::unique_ptr<QCustomPlot> m_Plot;
+    /// Graph of the plot, owned by it
+    TimeSeriesGraph* m_Graph { nullptr };
+};
+
+QTEST_MAIN(A_NearestSampleIndex)
+
+#include "main.moc"
@@ -0,0 +1,137 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Visualization/PanPrefetcher.h>
+
+#include <vector>
+
+namespace
+{
+
+/// Width of the ranges displayed, in seconds
+const auto WIDTH = 3600.;
+
+DateTimeRange shifted(const DateTimeRange& range, double shift)
+{
+    return DateTimeRange { range.m_TStart + shift, range.m_TEnd + shift };
+}
+
+} // namespace
+
+class A_PanPrefetcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_PanPrefetcher(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void prefetches_nothing_for_the_first_range()
+    {
+        auto prefetcher = PanPrefetcher {};
+        QVERIFY(prefetcher.rangesToPrefetch(DateTimeRange { 0., WIDTH }).empty());
+    }
+
+    void prefetches_the_windows_around_a_pan_ahead_of_it_first()
+    {
+        auto prefetcher = PanPrefetcher {};
+        auto range = DateTimeRange { 0., WIDTH };
+        prefetcher.rangesToPrefetch(range);
+
+        range = shifted(range, WIDTH / 10.);
+        auto windows = prefetcher.rangesToPrefetch(range);
+        QCOMPARE(windows.size(), std::size_t { 2 });
+
+        // Ahead of the pan, at least one window
+        QCOMPARE(windows[0].m_TStart, range.m_TEnd);
+        QVERIFY(windows[0].m_TEnd >= range.m_TEnd + WIDTH);
+        QVERIFY(windows[0].m_TEnd <= range.m_TEnd + 4. * WIDTH);
+
+        // Behind the pan, one window in case it changes direction
+        QCOMPARE(windows[1].m_TEnd, range.m_TStart);
+        QCOMPARE(windows[1].m_TStart, range.m_TStart - WIDTH);
+    }
+
+    void prefetches_before_the_range_for_a_backward_pan()
+    {
+        auto prefetcher = PanPrefetcher {};
+        auto range = DateTimeRange { 0., WIDTH };
+        prefetcher.rangesToPrefetch(range);
+
+        range = shifted(range, -WIDTH / 10.);
+        auto windows = prefetcher.rangesToPrefetch(range);
+        QCOMPARE(windows.size(), std::size_t { 2 });
+        QCOMPARE(windows[0].m_TEnd, range.m_TStart);
+        QVERIFY(windows[0].m_TStart <= range.m_TStart - WIDTH);
+        QCOMPARE(windows[1].m_TStart, range.m_TEnd);
+        QCOMPARE(windows[1].m_TEnd, range.m_TEnd + WIDTH);
+    }
+
+    void prefetches_again_only_when_the_pan_gets_out_of_the_prefetched_windows()
+    {
+        auto prefetcher = PanPrefetcher {};
+        auto range = DateTimeRange { 0., WIDTH };
+        prefetcher.rangesToPrefetch(range);
+
+        range = shifted(range, WIDTH / 10.);
+        auto windows = prefetcher.rangesToPrefetch(range);
+        QCOMPARE(windows.size(), std::size_t { 2 });
+        auto prefetchedEnd = windows[0].m_TEnd;
+
+        // Moves in the prefetched windows
+        while (range.m_TEnd + WIDTH / 10. <= prefetchedEnd)
+        {
+            range = shifted(range, WIDTH / 10.);
+            QVERIFY(prefetcher.rangesToPrefetch(range).empty());
+        }
+
+        // Gets out of them
+        range = shifted(range, WIDTH / 10.);
+        windows = prefetcher.rangesToPrefetch(range);
+        QCOMPARE(windows.size(), std::size_t { 2 });
+        QCOMPARE(windows[0].m_TStart, range.m_TEnd);
+    }
+
+    void stops_prefetching_on_a_zoom()
+    {
+        auto prefetcher = PanPrefetcher {};
+        auto range = DateTimeRange { 0., WIDTH };
+        prefetcher.rangesToPrefetch(range);
+        prefetcher.rangesToPrefetch(shifted(range, WIDTH / 10.));
+
+        QVERIFY(prefetcher.rangesToPrefetch(DateTimeRange { 0., 2. * WIDTH }).empty());
+        range = DateTimeRange { 0., WIDTH / 2. };
+        QVERIFY(prefetcher.rangesToPrefetch(range).empty());
+
+        // A pan after the zoom is prefetched again, even in the windows prefetched before
+        auto windows = prefetcher.rangesToPrefetch(shifted(range, WIDTH / 20.));
+        QCOMPARE(windows.size(), std::size_t { 2 });
+    }
+
+    void prefetches_nothing_if_the_range_doesnt_move()
+    {
+        auto prefetcher = PanPrefetcher {};
+        auto range = DateTimeRange { 0., WIDTH };
+        prefetcher.rangesToPrefetch(range);
+        QVERIFY(prefetcher.rangesToPrefetch(range).empty());
+    }
+
+    void prefetches_again_after_a_reset()
+    {
+        auto prefetcher = PanPrefetcher {};
+        auto range = DateTimeRange { 0., WIDTH };
+        prefetcher.rangesToPrefetch(range);
+        range = shifted(range, WIDTH / 10.);
+        QVERIFY(!prefetcher.rangesToPrefetch(range).empty());
+
+        // The range following a reset isn't a pan, the next one is
+        prefetcher.reset();
+        range = shifted(range, WIDTH / 10.);
+        QVERIFY(prefetcher.rangesToPrefetch(range).empty());
+        range = shifted(range, WIDTH / 10.);
+        QVERIFY(!prefetcher.rangesToPrefetch(range).empty());
+    }
+};
+
+QTEST_GUILESS_MAIN(A_PanPrefetcher)
+
+#include "main.moc"
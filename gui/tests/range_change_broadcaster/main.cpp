@@ -0,0 +1,153 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Data/IDataProvider.h>
+#include <Data/ScalarTimeSerie.h>
+#include <SqpApplication.h>
+#include <Variable/Variable2.h>
+#include <Variable/VariableController2.h>
+#include <Visualization/RangeChangeBroadcaster.h>
+
+#include <GUITestUtils.h>
+
+#include <QUuid>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace
+{
+
+/// Provider that counts the requests made to it and its clones
+class CountingProvider : public IDataProvider
+{
+public:
+    explicit CountingProvider(std::shared_ptr<std::atomic_int> requestCount)
+            : m_RequestCount { std::move(requestCount) }
+    {
+    }
+
+    std::shared_ptr<IDataProvider> clone() const override
+    {
+        return std::make_shared<CountingProvider>(m_RequestCount);
+    }
+
+    TimeSeries::ITimeSerie* getData(const DataProviderParameters& parameters) override
+    {
+        ++*m_RequestCount;
+
+        // Ten samples over the range
+        const auto& range = parameters.m_Range;
+        auto serie = new ScalarTimeSerie(10);
+        std::generate(std::begin(*serie), std::end(*serie), [&range, i = 0]() mutable {
+            auto time = range.m_TStart + i * (range.m_TEnd - range.m_TStart) / 9.;
+            ++i;
+            return std::pair<double, double> { time, 0. };
+        });
+        return serie;
+    }
+
+private:
+    std::shared_ptr<std::atomic_int> m_RequestCount;
+};
+
+const auto INITIAL_RANGE = DateTimeRange::fromDateTime(
+    QDate(2018, 8, 7), QTime(14, 00), QDate(2018, 8, 7), QTime(16, 00));
+
+DateTimeRange shifted(double shift)
+{
+    return DateTimeRange { INITIAL_RANGE.m_TStart + shift, INITIAL_RANGE.m_TEnd + shift };
+}
+
+std::shared_ptr<Variable2> createVariable(std::shared_ptr<std::atomic_int> requestCount)
+{
+    auto provider = std::make_shared<CountingProvider>(std::move(requestCount));
+    auto var = static_cast<SqpApplication*>(qApp)->variableController().createVariable(
+        "V1", { { "", "scalar" } }, provider, INITIAL_RANGE);
+    waitForVar(var);
+    return var;
+}
+
+RangeChangeBroadcaster& broadcaster()
+{
+    return static_cast<SqpApplication*>(qApp)->rangeChangeBroadcaster();
+}
+
+} // namespace
+
+class A_RangeChangeBroadcaster : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_RangeChangeBroadcaster(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void gives_a_variable_the_last_range_asked_whatever_the_group()
+    {
+        auto var = createVariable(std::make_shared<std::atomic_int>(0));
+        auto group = QUuid::createUuid();
+        auto otherGroup = QUuid::createUuid();
+
+        // Both orders of the groups are checked, as the groups are issued in the order of their id
+        broadcaster().changeRange(group, var, shifted(3600.));
+        broadcaster().changeRange(otherGroup, var, shifted(7200.));
+        waitForVar(var);
+        QTRY_VERIFY(var->range() == shifted(7200.));
+
+        broadcaster().changeRange(otherGroup, var, shifted(10800.));
+        broadcaster().changeRange(group, var, shifted(14400.));
+        waitForVar(var);
+        QTRY_VERIFY(var->range() == shifted(14400.));
+    }
+
+    void ignores_null_variables()
+    {
+        auto var = createVariable(std::make_shared<std::atomic_int>(0));
+        broadcaster().changeRange(QUuid {}, nullptr, shifted(3600.));
+        broadcaster().changeRange(QUuid {}, var, shifted(3600.));
+        waitForVar(var);
+        QTRY_VERIFY(var->range() == shifted(3600.));
+    }
+
+    void requests_merged_changes_as_a_single_change()
+    {
+        auto singleRequestCount = std::make_shared<std::atomic_int>(0);
+        auto singleVar = createVariable(singleRequestCount);
+        auto mergedRequestCount = std::make_shared<std::atomic_int>(0);
+        auto mergedVar = createVariable(mergedRequestCount);
+        *singleRequestCount = 0;
+        *mergedRequestCount = 0;
+
+        auto group = QUuid::createUuid();
+        broadcaster().changeRange(group, singleVar, shifted(36000.));
+        waitForVar(singleVar);
+        QTRY_VERIFY(singleVar->range() == shifted(36000.));
+
+        // Changes of synchronized graphs, moved several times during an iteration
+        broadcaster().changeRange(group, mergedVar, shifted(3600.));
+        broadcaster().changeRange(QUuid::createUuid(), mergedVar, shifted(7200.));
+        broadcaster().changeRange(group, mergedVar, shifted(36000.));
+        waitForVar(mergedVar);
+        QTRY_VERIFY(mergedVar->range() == shifted(36000.));
+
+        QVERIFY(*singleRequestCount > 0);
+        QCOMPARE(mergedRequestCount->load(), singleRequestCount->load());
+    }
+};
+
+QT_BEGIN_NAMESPACE
+QTEST_ADD_GPU_BLACKLIST_SUPPORT_DEFS
+QT_END_NAMESPACE
+int main(int argc, char* argv[])
+{
+    SqpApplication app { argc, argv };
+    app.setAttribute(Qt::AA_Use96Dpi, true);
+    QTEST_DISABLE_KEYPAD_NAVIGATION;
+    QTEST_ADD_GPU_BLACKLIST_SUPPORT;
+    A_RangeChangeBroadcaster tc;
+    QTEST_SET_MAIN_SOURCE_PATH;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "main.moc"
@@ -0,0 +1,112 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Visualization/RangeStatistics.h>
+
+#include <GraphTestUtils.h>
+
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+const auto NaN = std::numeric_limits<double>::quiet_NaN();
+
+/// Generates a vector serie of one sample per second, whose components are (t, -t, 10 t)
+std::shared_ptr<GraphTestBuffers> generate(std::size_t size)
+{
+    return generateGraphBuffers(size, 3, [](auto index) { return static_cast<double>(index); },
+        [](auto index, auto component) {
+            auto value = static_cast<double>(index);
+            return component == 0 ? value : component == 1 ? -value : 10. * value;
+        });
+}
+
+/// Returns a view on a component of the serie
+TimeSeriesGraphData view(const std::shared_ptr<GraphTestBuffers>& buffers, std::size_t component)
+{
+    return graphDataView(buffers, component);
+}
+
+} // namespace
+
+class A_RangeStatistics : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_RangeStatistics(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void locates_the_samples_of_a_range_with_bounds_included()
+    {
+        auto buffers = generate(100);
+        auto data = view(buffers, 0);
+        QCOMPARE(RangeStatistics::indexRange(data, 10., 20.),
+            (std::pair<std::size_t, std::size_t> { 10, 21 }));
+        QCOMPARE(RangeStatistics::indexRange(data, 10.5, 20.5),
+            (std::pair<std::size_t, std::size_t> { 11, 21 }));
+        QCOMPARE(RangeStatistics::indexRange(data, -10., 1000.),
+            (std::pair<std::size_t, std::size_t> { 0, 100 }));
+    }
+
+    void gives_an_empty_index_range_outside_of_the_data()
+    {
+        auto buffers = generate(100);
+        auto data = view(buffers, 0);
+        auto [first, last] = RangeStatistics::indexRange(data, 200., 300.);
+        QCOMPARE(first, last);
+        std::tie(first, last) = RangeStatistics::indexRange(data, 20.5, 20.7);
+        QCOMPARE(first, last);
+        std::tie(first, last) = RangeStatistics::indexRange(data, 30., 20.);
+        QCOMPARE(first, last);
+        QVERIFY(!RangeStatistics::valueRange(data, 200., 300.));
+    }
+
+    void gives_the_value_range_of_the_displayed_samples_only()
+    {
+        auto buffers = generate(100);
+        QVERIFY(RangeStatistics::valueRange(view(buffers, 0), 10., 20.) == QCPRange(10., 20.));
+        QVERIFY(RangeStatistics::valueRange(view(buffers, 1), 10., 20.) == QCPRange(-20., -10.));
+        QVERIFY(RangeStatistics::valueRange(view(buffers, 2), 10., 20.) == QCPRange(100., 200.));
+    }
+
+    void gives_the_value_range_of_several_components()
+    {
+        auto buffers = generate(100);
+
+        // The components fill the stride: they are reduced in one pass
+        QVERIFY(RangeStatistics::valueRange(view(buffers, 0), 10., 20., 3)
+            == QCPRange(-20., 200.));
+
+        // Two components of three
+        QVERIFY(RangeStatistics::valueRange(view(buffers, 0), 10., 20., 2) == QCPRange(-20., 20.));
+        QVERIFY(RangeStatistics::valueRange(view(buffers, 1), 10., 20., 2)
+            == QCPRange(-20., 200.));
+    }
+
+    void ignores_data_holes()
+    {
+        auto buffers = generate(100);
+        for (auto index = 15; index <= 20; ++index)
+        {
+            buffers->m_Values[3 * index] = NaN;
+            buffers->m_Values[3 * index + 1] = NaN;
+            buffers->m_Values[3 * index + 2] = NaN;
+        }
+
+        QVERIFY(RangeStatistics::valueRange(view(buffers, 0), 10., 20.) == QCPRange(10., 14.));
+        QVERIFY(RangeStatistics::valueRange(view(buffers, 0), 10., 20., 3)
+            == QCPRange(-14., 140.));
+        QVERIFY(RangeStatistics::valueRange(view(buffers, 0), 10., 20., 2) == QCPRange(-14., 14.));
+        QVERIFY(!RangeStatistics::valueRange(view(buffers, 0), 15., 20.));
+        QVERIFY(!RangeStatistics::valueRange(view(buffers, 0), 15., 20., 3));
+    }
+};
+
+QTEST_GUILESS_MAIN(A_RangeStatistics)
+
+#include "main.moc"
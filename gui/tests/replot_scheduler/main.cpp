@@ -0,0 +1,143 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Visualization/ReplotScheduler.h>
+#include <Visualization/qcustomplot.h>
+
+#include <QElapsedTimer>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+/// Creates a plot that can be replotted without being shown
+std::unique_ptr<QCustomPlot> createPlot()
+{
+    auto plot = std::make_unique<QCustomPlot>();
+    plot->resize(400, 300);
+    return plot;
+}
+
+/// Waits for several frames, so that every frame scheduled is done
+void waitForFrames()
+{
+    QTest::qWait(5 * ReplotScheduler::FRAME_INTERVAL);
+}
+
+} // namespace
+
+class A_ReplotScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_ReplotScheduler(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void replots_a_plot_once_however_many_times_it_is_scheduled()
+    {
+        auto scheduler = ReplotScheduler {};
+        auto plot = createPlot();
+        QSignalSpy replotSpy { plot.get(), &QCustomPlot::afterReplot };
+
+        scheduler.scheduleReplot(*plot);
+        scheduler.scheduleReplot(*plot);
+        scheduler.scheduleReplot(*plot);
+        QCOMPARE(replotSpy.count(), 0);
+        QTRY_COMPARE(replotSpy.count(), 1);
+        waitForFrames();
+        QCOMPARE(replotSpy.count(), 1);
+
+        // Scheduled again once replotted
+        scheduler.scheduleReplot(*plot);
+        QTRY_COMPARE(replotSpy.count(), 2);
+    }
+
+    void ignores_the_plots_destroyed_once_scheduled()
+    {
+        auto scheduler = ReplotScheduler {};
+        auto destroyedPlot = createPlot();
+        auto plot = createPlot();
+        QSignalSpy replotSpy { plot.get(), &QCustomPlot::afterReplot };
+
+        scheduler.scheduleReplot(*destroyedPlot);
+        scheduler.scheduleReplot(*plot);
+        destroyedPlot.reset();
+        QTRY_COMPARE(replotSpy.count(), 1);
+    }
+
+    void postpones_the_plots_over_the_frame_budget_to_the_next_frames()
+    {
+        // Without budget, a frame only replots its first plot
+        auto scheduler = ReplotScheduler {};
+        scheduler.setFrameBudget(0);
+
+        auto plots = std::vector<std::unique_ptr<QCustomPlot> > {};
+        auto replotTimes = std::vector<qint64> {};
+        auto replotOrder = std::vector<QCustomPlot*> {};
+        QElapsedTimer timer {};
+        timer.start();
+        for (auto index = 0; index < 3; ++index)
+        {
+            plots.push_back(createPlot());
+            auto plot = plots.back().get();
+            connect(plot, &QCustomPlot::afterReplot, this, [&, plot]() {
+                replotTimes.push_back(timer.elapsed());
+                replotOrder.push_back(plot);
+            });
+            scheduler.scheduleReplot(*plot);
+        }
+
+        QTRY_COMPARE(replotTimes.size(), std::size_t { 3 });
+        for (auto index = std::size_t { 0 }; index < plots.size(); ++index)
+        {
+            // Plots are replotted in the order they were scheduled, one frame after the other
+            QCOMPARE(replotOrder[index], plots[index].get());
+            if (index > 0)
+            {
+                QVERIFY(replotTimes[index] - replotTimes[index - 1]
+                    >= ReplotScheduler::FRAME_INTERVAL / 2);
+            }
+        }
+    }
+
+    void repaints_a_buffered_layer_without_replotting_its_plot()
+    {
+        auto scheduler = ReplotScheduler {};
+        auto plot = createPlot();
+        auto layer = plot->layer(QStringLiteral("overlay"));
+        QVERIFY(layer != nullptr);
+        QCOMPARE(layer->mode(), QCPLayer::lmBuffered);
+        plot->replot();
+
+        QSignalSpy replotSpy { plot.get(), &QCustomPlot::afterReplot };
+        scheduler.replotLayer(*layer);
+        waitForFrames();
+        QCOMPARE(replotSpy.count(), 0);
+    }
+
+    void replots_the_plot_of_a_layer_that_cant_be_repainted_alone()
+    {
+        auto scheduler = ReplotScheduler {};
+        auto plot = createPlot();
+        plot->replot();
+        QSignalSpy replotSpy { plot.get(), &QCustomPlot::afterReplot };
+
+        // Logical layer
+        auto logicalLayer = plot->layer(QStringLiteral("main"));
+        QCOMPARE(logicalLayer->mode(), QCPLayer::lmLogical);
+        scheduler.replotLayer(*logicalLayer);
+        QTRY_COMPARE(replotSpy.count(), 1);
+
+        // Buffered layer whose paint buffer is invalidated by a graph added to it
+        auto bufferedLayer = plot->layer(QStringLiteral("overlay"));
+        plot->addGraph()->setLayer(bufferedLayer);
+        scheduler.replotLayer(*bufferedLayer);
+        QTRY_COMPARE(replotSpy.count(), 2);
+    }
+};
+
+QTEST_MAIN(A_ReplotScheduler)
+
+#include "main.moc"
@@ -0,0 +1,165 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Visualization/SpectrogramRasterizer.h>
+
+#include <atomic>
+#include <cmath>
+#include <set>
+#include <vector>
+
+namespace
+{
+
+const auto NOT_CANCELED = std::atomic_bool { false };
+
+/**
+ * Creates a spectrogram whose values are the centers of their channel
+ * @param times the times of the lines
+ * @param yAxis the centers of the channels
+ */
+SpectrogramTimeSerie spectrogram(
+    const std::vector<double>& times, const std::vector<double>& yAxis)
+{
+    auto values = std::vector<double> {};
+    for (auto line = std::size_t { 0 }; line < times.size(); ++line)
+    {
+        values.insert(values.end(), yAxis.cbegin(), yAxis.cend());
+    }
+    auto shape = std::vector<std::size_t> { times.size(), yAxis.size() };
+    return SpectrogramTimeSerie { std::vector<double> { times }, std::vector<double> { yAxis },
+        std::move(values), shape, 1., 1., false };
+}
+
+std::vector<double> regularTimes(double start, double end)
+{
+    auto times = std::vector<double> {};
+    for (auto time = start; time <= end; time += 1.)
+    {
+        times.push_back(time);
+    }
+    return times;
+}
+
+/// Returns the center of the channel displayed at a display coordinate: the channel whose center is
+/// the closest, in display scale
+double expectedChannel(const std::vector<double>& yAxis, double coord, bool logScale)
+{
+    auto toScale = [logScale](double value) { return logScale ? std::log10(value) : value; };
+    auto result = yAxis.front();
+    for (auto center : yAxis)
+    {
+        if (std::abs(toScale(center) - coord) < std::abs(toScale(result) - coord))
+        {
+            result = center;
+        }
+    }
+    return result;
+}
+
+/// Checks that each row of a raster displays the channel closest to its center
+void checkRows(const QCPColorMapData& data, const std::vector<double>& yAxis, bool logScale)
+{
+    auto toScale = [logScale](double value) { return logScale ? std::log10(value) : value; };
+    auto lower = toScale(data.valueRange().lower);
+    auto upper = toScale(data.valueRange().upper);
+    auto channels = std::set<double> {};
+    for (auto row = 0; row < data.valueSize(); ++row)
+    {
+        // Rows are evenly spaced in display scale
+        auto coord = lower + row * (upper - lower) / (data.valueSize() - 1);
+        auto expected = expectedChannel(yAxis, coord, logScale);
+        for (auto column = 0; column < data.keySize(); ++column)
+        {
+            QCOMPARE(data.cell(column, row), expected);
+        }
+        channels.insert(expected);
+    }
+
+    // Each channel is displayed
+    QCOMPARE(channels.size(), yAxis.size());
+}
+
+} // namespace
+
+class A_SpectrogramRasterizer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_SpectrogramRasterizer(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void displays_each_channel_on_the_rows_closest_to_its_center()
+    {
+        // Uneven channels, none of them being at equal distance from two rows
+        auto yAxis = std::vector<double> { 1., 2.2, 3.7, 9.1 };
+        auto serie = spectrogram(regularTimes(0., 99.), yAxis);
+        auto raster = SpectrogramRasterizer::rasterize(serie, QCPAxis::stLinear, NOT_CANCELED);
+        QVERIFY(raster.m_Data != nullptr);
+        QVERIFY(raster.m_Data->valueSize() >= static_cast<int>(yAxis.size()));
+        QCOMPARE(raster.m_Data->valueRange().lower, 1.);
+        QCOMPARE(raster.m_Data->valueRange().upper, 9.1);
+        checkRows(*raster.m_Data, yAxis, false);
+    }
+
+    void computes_channel_bounds_in_log_scale_for_a_logarithmic_axis()
+    {
+        auto yAxis = std::vector<double> { 1., 7., 30., 1000. };
+        auto serie = spectrogram(regularTimes(0., 99.), yAxis);
+        auto raster = SpectrogramRasterizer::rasterize(serie, QCPAxis::stLogarithmic, NOT_CANCELED);
+        QVERIFY(raster.m_Data != nullptr);
+        checkRows(*raster.m_Data, yAxis, true);
+    }
+
+    void ignores_a_logarithmic_axis_for_channels_that_arent_positive()
+    {
+        auto yAxis = std::vector<double> { 0., 1.3, 2.1 };
+        auto serie = spectrogram(regularTimes(0., 99.), yAxis);
+        auto raster = SpectrogramRasterizer::rasterize(serie, QCPAxis::stLogarithmic, NOT_CANCELED);
+        QVERIFY(raster.m_Data != nullptr);
+        checkRows(*raster.m_Data, yAxis, false);
+    }
+
+    void leaves_the_columns_in_the_gaps_of_the_serie_empty()
+    {
+        auto times = regularTimes(0., 49.);
+        auto otherTimes = regularTimes(100., 149.);
+        times.insert(times.end(), otherTimes.cbegin(), otherTimes.cend());
+        auto serie = spectrogram(times, { 1., 2., 3., 4. });
+        auto raster = SpectrogramRasterizer::rasterize(serie, QCPAxis::stLinear, NOT_CANCELED);
+        QVERIFY(raster.m_Data != nullptr);
+
+        auto cellValue = [&raster](double key, double value) {
+            auto column = 0;
+            auto row = 0;
+            raster.m_Data->coordToCell(key, value, &column, &row);
+            return raster.m_Data->cell(column, row);
+        };
+        QCOMPARE(cellValue(25., 2.), 2.);
+        QCOMPARE(cellValue(125., 2.), 2.);
+        QVERIFY(std::isnan(cellValue(75., 2.)));
+
+        // The range of the values excludes the empty columns
+        QVERIFY(raster.m_DataRange == QCPRange(1., 4.));
+    }
+
+    void gives_no_data_when_canceled()
+    {
+        auto serie = spectrogram(regularTimes(0., 99.), { 1., 2. });
+        auto canceled = std::atomic_bool { true };
+        auto raster = SpectrogramRasterizer::rasterize(serie, QCPAxis::stLinear, canceled);
+        QVERIFY(raster.m_Data == nullptr);
+        QVERIFY(!raster.m_DataRange);
+    }
+
+    void gives_no_data_for_two_lines_or_less()
+    {
+        auto serie = spectrogram({ 0., 1. }, { 1., 2. });
+        auto raster = SpectrogramRasterizer::rasterize(serie, QCPAxis::stLinear, NOT_CANCELED);
+        QVERIFY(raster.m_Data == nullptr);
+    }
+};
+
+QTEST_GUILESS_MAIN(A_SpectrogramRasterizer)
+
+#include "main.moc"
@@ -0,0 +1,277 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Data/ScalarTimeSerie.h>
+#include <Data/SpectrogramTimeSerie.h>
+#include <Data/VectorTimeSerie.h>
+#include <DataSource/TimeSeriesCache.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+const auto KEY = QStringLiteral("product");
+
+/// Creates a scalar serie of one sample per second over a range, whose values are the times
+std::shared_ptr<ScalarTimeSerie> scalarSerie(const DateTimeRange& range)
+{
+    auto size = static_cast<std::size_t>(range.m_TEnd - range.m_TStart) + 1;
+    auto serie = std::make_shared<ScalarTimeSerie>(size);
+    std::generate(std::begin(*serie), std::end(*serie), [&range, i = 0.]() mutable {
+        auto sample = std::pair<double, double> { range.m_TStart + i, range.m_TStart + i };
+        ++i;
+        return sample;
+    });
+    return serie;
+}
+
+/// Creates a spectrogram of one line per second over a range, whose values are the times
+std::shared_ptr<SpectrogramTimeSerie> spectrogram(
+    const DateTimeRange& range, const std::vector<double>& yAxis)
+{
+    auto times = std::vector<double> {};
+    auto values = std::vector<double> {};
+    for (auto time = range.m_TStart; time <= range.m_TEnd; time += 1.)
+    {
+        times.push_back(time);
+        values.insert(values.end(), yAxis.size(), time);
+    }
+    auto shape = std::vector<std::size_t> { times.size(), yAxis.size() };
+    return std::make_shared<SpectrogramTimeSerie>(std::move(times), std::vector<double> { yAxis },
+        std::move(values), shape, 1., 1., false);
+}
+
+TimeSeriesCache::Slice slice(const DateTimeRange& range)
+{
+    return TimeSeriesCache::Slice { range, scalarSerie(range) };
+}
+
+/// Returns the times of a scalar serie
+std::vector<double> times(const TimeSeries::ITimeSerie& serie)
+{
+    auto& scalars = dynamic_cast<const ScalarTimeSerie&>(serie);
+    auto result = std::vector<double> {};
+    for (const auto& sample : scalars)
+    {
+        result.push_back(sample.t());
+    }
+    return result;
+}
+
+std::vector<double> expectedTimes(double start, double end)
+{
+    auto result = std::vector<double> {};
+    for (auto time = start; time <= end; time += 1.)
+    {
+        result.push_back(time);
+    }
+    return result;
+}
+
+bool isSame(const std::vector<DateTimeRange>& ranges, const std::vector<DateTimeRange>& expected)
+{
+    return std::equal(std::cbegin(ranges), std::cend(ranges), std::cbegin(expected),
+        std::cend(expected), [](const auto& range, const auto& other) {
+            return range.m_TStart == other.m_TStart && range.m_TEnd == other.m_TEnd;
+        });
+}
+
+/// Returns a cache with a budget large enough for the slices of the tests
+std::unique_ptr<TimeSeriesCache> createCache()
+{
+    auto cache = std::make_unique<TimeSeriesCache>();
+    cache->setMemoryBudget(std::size_t { 64 } << 20);
+    return cache;
+}
+
+} // namespace
+
+class A_TimeSeriesCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_TimeSeriesCache(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void identifies_products_whatever_the_order_of_their_metadata()
+    {
+        auto metaData = QVariantHash { { "a", 1 }, { "b", "x" }, { "c", 2.5 } };
+        auto otherMetaData = QVariantHash {};
+        otherMetaData.insert("c", 2.5);
+        otherMetaData.insert("a", 1);
+        otherMetaData.insert("b", "x");
+        QCOMPARE(TimeSeriesCache::key("provider", metaData),
+            TimeSeriesCache::key("provider", otherMetaData));
+        QVERIFY(TimeSeriesCache::key("provider", metaData)
+            != TimeSeriesCache::key("other", metaData));
+        otherMetaData.insert("b", "y");
+        QVERIFY(TimeSeriesCache::key("provider", metaData)
+            != TimeSeriesCache::key("provider", otherMetaData));
+    }
+
+    void stores_scalar_vector_and_spectrogram_series()
+    {
+        QVERIFY(TimeSeriesCache::isCacheable(*scalarSerie({ 0., 10. })));
+        QVERIFY(TimeSeriesCache::isCacheable(*std::make_shared<VectorTimeSerie>(10)));
+        QVERIFY(TimeSeriesCache::isCacheable(*spectrogram({ 0., 10. }, { 1., 2. })));
+    }
+
+    void misses_unknown_products()
+    {
+        auto cache = createCache();
+        auto lookup = cache->lookup(KEY, { 0., 100. });
+        QVERIFY(lookup.m_Slices.empty());
+        QVERIFY(isSame(lookup.m_MissingRanges, { { 0., 100. } }));
+    }
+
+    void serves_a_range_covered_by_contiguous_slices()
+    {
+        auto cache = createCache();
+        cache->insert(KEY, slice({ 0., 100. }));
+        cache->insert(KEY, slice({ 100., 200. }));
+
+        auto lookup = cache->lookup(KEY, { 50., 150. });
+        QCOMPARE(lookup.m_Slices.size(), std::size_t { 2 });
+        QVERIFY(lookup.m_MissingRanges.empty());
+
+        auto merged = std::unique_ptr<TimeSeries::ITimeSerie> { TimeSeriesCache::merge(
+            std::move(lookup.m_Slices), { 50., 150. }) };
+        QVERIFY(merged != nullptr);
+        QVERIFY(times(*merged) == expectedTimes(50., 150.));
+    }
+
+    void gives_the_parts_of_a_range_that_arent_covered()
+    {
+        auto cache = createCache();
+        cache->insert(KEY, slice({ 100., 200. }));
+        cache->insert(KEY, slice({ 300., 400. }));
+
+        auto lookup = cache->lookup(KEY, { 0., 500. });
+        QCOMPARE(lookup.m_Slices.size(), std::size_t { 2 });
+        QVERIFY(isSame(lookup.m_MissingRanges, { { 0., 100. }, { 200., 300. }, { 400., 500. } }));
+
+        // Other products aren't served
+        QVERIFY(cache->lookup("other", { 0., 500. }).m_Slices.empty());
+    }
+
+    void replaces_the_slices_covered_by_a_new_slice()
+    {
+        auto cache = createCache();
+        cache->insert(KEY, slice({ 100., 200. }));
+        cache->insert(KEY, slice({ 300., 400. }));
+        cache->insert(KEY, slice({ 0., 500. }));
+
+        auto lookup = cache->lookup(KEY, { 0., 500. });
+        QCOMPARE(lookup.m_Slices.size(), std::size_t { 1 });
+        QVERIFY(lookup.m_MissingRanges.empty());
+    }
+
+    void only_stores_what_overlapped_slices_dont_cover()
+    {
+        auto cache = createCache();
+        cache->insert(KEY, slice({ 0., 100. }));
+        cache->insert(KEY, slice({ 200., 300. }));
+        cache->insert(KEY, slice({ 50., 250. }));
+
+        // The new slice keeps its data, its range being reduced to [100, 200]
+        auto lookup = cache->lookup(KEY, { 0., 300. });
+        QCOMPARE(lookup.m_Slices.size(), std::size_t { 3 });
+        QVERIFY(lookup.m_MissingRanges.empty());
+        QCOMPARE(lookup.m_Slices[1].m_Range.m_TStart, 100.);
+        QCOMPARE(lookup.m_Slices[1].m_Range.m_TEnd, 200.);
+
+        // Samples of overlapping slices are merged once
+        auto merged = std::unique_ptr<TimeSeries::ITimeSerie> { TimeSeriesCache::merge(
+            std::move(lookup.m_Slices), { 0., 300. }) };
+        QVERIFY(times(*merged) == expectedTimes(0., 300.));
+
+        // A slice inside a stored slice brings nothing
+        cache->insert(KEY, slice({ 10., 20. }));
+        QCOMPARE(cache->lookup(KEY, { 0., 300. }).m_Slices.size(), std::size_t { 3 });
+    }
+
+    void merges_spectrograms()
+    {
+        auto cache = createCache();
+        auto yAxis = std::vector<double> { 10., 20., 30. };
+        cache->insert(KEY, { { 0., 100. }, spectrogram({ 0., 100. }, yAxis) });
+        cache->insert(KEY, { { 100., 200. }, spectrogram({ 100., 200. }, yAxis) });
+
+        auto lookup = cache->lookup(KEY, { 50., 150. });
+        QVERIFY(lookup.m_MissingRanges.empty());
+        auto merged = std::unique_ptr<TimeSeries::ITimeSerie> { TimeSeriesCache::merge(
+            std::move(lookup.m_Slices), { 50., 150. }) };
+        auto mergedSpectrogram = dynamic_cast<SpectrogramTimeSerie*>(merged.get());
+        QVERIFY(mergedSpectrogram != nullptr);
+        QVERIFY(mergedSpectrogram->axis(0) == expectedTimes(50., 150.));
+        QVERIFY(mergedSpectrogram->axis(1) == yAxis);
+
+        auto line = std::begin(*mergedSpectrogram);
+        for (auto time : mergedSpectrogram->axis(0))
+        {
+            for (const auto& item : *line)
+            {
+                QCOMPARE(item.v(), time);
+            }
+            ++line;
+        }
+    }
+
+    void evicts_the_least_recently_used_slices_over_its_budget()
+    {
+        auto cache = createCache();
+        auto sliceSize = 2 * 101 * sizeof(double);
+        cache->setMemoryBudget(3 * sliceSize);
+        cache->insert(KEY, slice({ 0., 100. }));
+        cache->insert(KEY, slice({ 200., 300. }));
+        cache->insert(KEY, slice({ 400., 500. }));
+
+        // The first slice is used again, the second one is evicted
+        QCOMPARE(cache->lookup(KEY, { 0., 100. }).m_Slices.size(), std::size_t { 1 });
+        cache->insert(KEY, slice({ 600., 700. }));
+
+        QCOMPARE(cache->lookup(KEY, { 0., 100. }).m_Slices.size(), std::size_t { 1 });
+        QVERIFY(cache->lookup(KEY, { 200., 300. }).m_Slices.empty());
+        QCOMPARE(cache->lookup(KEY, { 400., 500. }).m_Slices.size(), std::size_t { 1 });
+        QCOMPARE(cache->lookup(KEY, { 600., 700. }).m_Slices.size(), std::size_t { 1 });
+
+        // Reducing the budget evicts slices
+        cache->setMemoryBudget(sliceSize);
+        QCOMPARE(cache->lookup(KEY, { 0., 700. }).m_Slices.size(), std::size_t { 1 });
+    }
+
+    void doesnt_store_slices_larger_than_its_budget()
+    {
+        auto cache = createCache();
+        cache->setMemoryBudget(2 * 101 * sizeof(double));
+        cache->insert(KEY, slice({ 0., 100. }));
+        cache->insert(KEY, slice({ 200., 1000. }));
+
+        QCOMPARE(cache->lookup(KEY, { 0., 100. }).m_Slices.size(), std::size_t { 1 });
+        QVERIFY(cache->lookup(KEY, { 200., 1000. }).m_Slices.empty());
+    }
+
+    void stores_nothing_without_budget()
+    {
+        auto cache = createCache();
+        cache->setMemoryBudget(0);
+        QVERIFY(!cache->isEnabled());
+        cache->insert(KEY, slice({ 0., 100. }));
+        QVERIFY(cache->lookup(KEY, { 0., 100. }).m_Slices.empty());
+    }
+
+    void removes_its_data_when_cleared()
+    {
+        auto cache = createCache();
+        cache->insert(KEY, slice({ 0., 100. }));
+        cache->clear();
+        QVERIFY(cache->lookup(KEY, { 0., 100. }).m_Slices.empty());
+    }
+};
+
+QTEST_GUILESS_MAIN(A_TimeSeriesCache)
+
+#include "main.moc"
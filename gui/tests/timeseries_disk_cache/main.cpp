@@ -0,0 +1,321 @@
+#include <QObject>
+#include <QtTest>
+
+#include <Data/ScalarTimeSerie.h>
+#include <Data/SpectrogramTimeSerie.h>
+#include <Data/VectorTimeSerie.h>
+#include <DataSource/TimeSeriesDiskCache.h>
+
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+const auto KEY = QStringLiteral("product");
+
+/// Budget large enough for the slices of the tests
+const auto DISK_BUDGET = std::size_t { 64 } << 20;
+
+/// Size of the file of a scalar slice of 101 samples: header, then times and values
+const auto SCALAR_SLICE_FILE_SIZE = std::size_t { 64 } + 2 * 101 * sizeof(double);
+
+/// Creates a scalar serie of one sample per second over a range, whose values are the times
+std::shared_ptr<ScalarTimeSerie> scalarSerie(const DateTimeRange& range)
+{
+    auto size = static_cast<std::size_t>(range.m_TEnd - range.m_TStart) + 1;
+    auto serie = std::make_shared<ScalarTimeSerie>(size);
+    std::generate(std::begin(*serie), std::end(*serie), [&range, i = 0.]() mutable {
+        auto sample = std::pair<double, double> { range.m_TStart + i, range.m_TStart + i };
+        ++i;
+        return sample;
+    });
+    return serie;
+}
+
+TimeSeriesCache::Slice slice(const DateTimeRange& range)
+{
+    return TimeSeriesCache::Slice { range, scalarSerie(range) };
+}
+
+/// Creates a cache in a directory, with a budget large enough for the slices of the tests
+std::unique_ptr<TimeSeriesDiskCache> createCache(const QTemporaryDir& directory)
+{
+    auto cache = std::make_unique<TimeSeriesDiskCache>(directory.path());
+    cache->setDiskBudget(DISK_BUDGET);
+    return cache;
+}
+
+/// Returns the slice files stored in a directory
+QStringList sliceFiles(const QTemporaryDir& directory)
+{
+    return QDir { directory.path() }.entryList({ QStringLiteral("*.ts") }, QDir::Files);
+}
+
+/// Waits for the clock to change, last uses of the slices being in ms
+void waitForNextUse()
+{
+    QThread::msleep(2);
+}
+
+} // namespace
+
+class A_TimeSeriesDiskCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit A_TimeSeriesDiskCache(QObject* parent = Q_NULLPTR) : QObject(parent) {}
+
+private slots:
+    void gives_back_scalar_series_from_one_session_to_another()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        createCache(directory)->insert(KEY, slice({ 0., 100. }));
+
+        auto lookup = createCache(directory)->lookup(KEY, { 0., 200. });
+        QCOMPARE(lookup.m_Slices.size(), std::size_t { 1 });
+        QCOMPARE(lookup.m_MissingRanges.size(), std::size_t { 1 });
+        QCOMPARE(lookup.m_MissingRanges.front().m_TStart, 100.);
+        QCOMPARE(lookup.m_MissingRanges.front().m_TEnd, 200.);
+
+        auto serie = std::dynamic_pointer_cast<ScalarTimeSerie>(lookup.m_Slices.front().m_Data);
+        QVERIFY(serie != nullptr);
+        QCOMPARE(serie->size(), std::size_t { 101 });
+        auto time = 0.;
+        for (const auto& sample : *serie)
+        {
+            QCOMPARE(sample.t(), time);
+            QCOMPARE(sample.v(), time);
+            time += 1.;
+        }
+    }
+
+    void gives_back_vector_series()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        auto serie = std::make_shared<VectorTimeSerie>(50);
+        std::generate(std::begin(*serie), std::end(*serie), [i = 0.]() mutable {
+            auto sample
+                = std::pair<double, VectorTimeSerie::raw_value_type> { i, { i, -i, 10. * i } };
+            ++i;
+            return sample;
+        });
+        createCache(directory)->insert(KEY, { { 0., 49. }, serie });
+
+        auto lookup = createCache(directory)->lookup(KEY, { 0., 49. });
+        QCOMPARE(lookup.m_Slices.size(), std::size_t { 1 });
+        auto readSerie
+            = std::dynamic_pointer_cast<VectorTimeSerie>(lookup.m_Slices.front().m_Data);
+        QVERIFY(readSerie != nullptr);
+        QCOMPARE(readSerie->size(), std::size_t { 50 });
+        auto time = 0.;
+        for (const auto& sample : *readSerie)
+        {
+            QCOMPARE(sample.t(), time);
+            QCOMPARE(sample.v().x, time);
+            QCOMPARE(sample.v().y, -time);
+            QCOMPARE(sample.v().z, 10. * time);
+            time += 1.;
+        }
+    }
+
+    void gives_back_spectrograms_with_their_y_axis_and_samplings()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        auto times = std::vector<double> { 0., 1., 2., 3. };
+        auto yAxis = std::vector<double> { 10., 100., 1000. };
+        auto values = std::vector<double> {};
+        for (auto index = 0; index < 12; ++index)
+        {
+            values.push_back(index);
+        }
+        auto shape = std::vector<std::size_t> { times.size(), yAxis.size() };
+        auto spectrogram = std::make_shared<SpectrogramTimeSerie>(std::vector<double> { times },
+            std::vector<double> { yAxis }, std::move(values), shape, 1., 2., true);
+        createCache(directory)->insert(KEY, { { 0., 3. }, spectrogram });
+
+        auto lookup = createCache(directory)->lookup(KEY, { 0., 3. });
+        QCOMPARE(lookup.m_Slices.size(), std::size_t { 1 });
+        auto readSerie
+            = std::dynamic_pointer_cast<SpectrogramTimeSerie>(lookup.m_Slices.front().m_Data);
+        QVERIFY(readSerie != nullptr);
+        QVERIFY(readSerie->axis(0) == times);
+        QVERIFY(readSerie->axis(1) == yAxis);
+        QCOMPARE(readSerie->min_sampling, 1.);
+        QCOMPARE(readSerie->max_sampling, 2.);
+        QVERIFY(readSerie->y_is_log);
+
+        auto value = 0.;
+        for (auto&& line : *readSerie)
+        {
+            for (const auto& item : line)
+            {
+                QCOMPARE(item.v(), value);
+                value += 1.;
+            }
+        }
+        QCOMPARE(value, 12.);
+    }
+
+    void doesnt_store_empty_series()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        auto cache = createCache(directory);
+        cache->insert(KEY, { { 0., 100. }, std::make_shared<ScalarTimeSerie>(0) });
+        QVERIFY(cache->lookup(KEY, { 0., 100. }).m_Slices.empty());
+        QVERIFY(sliceFiles(directory).isEmpty());
+    }
+
+    void merges_its_journal_in_the_index_when_opened()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        auto journalPath = QDir { directory.path() }.absoluteFilePath("index.journal");
+        {
+            auto cache = createCache(directory);
+            cache->insert(KEY, slice({ 0., 100. }));
+            cache->insert(KEY, slice({ 200., 300. }));
+        }
+        QVERIFY(QFile::exists(journalPath));
+
+        auto lookup = createCache(directory)->lookup(KEY, { 0., 300. });
+        QCOMPARE(lookup.m_Slices.size(), std::size_t { 2 });
+        QVERIFY(!QFile::exists(journalPath));
+
+        // The slices are now read from the index file only
+        QCOMPARE(createCache(directory)->lookup(KEY, { 0., 300. }).m_Slices.size(),
+            std::size_t { 2 });
+    }
+
+    void removes_the_files_missing_from_its_index()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        createCache(directory)->insert(KEY, slice({ 0., 100. }));
+        QCOMPARE(sliceFiles(directory).size(), 1);
+
+        QFile orphanFile { QDir { directory.path() }.absoluteFilePath("orphan.ts") };
+        QVERIFY(orphanFile.open(QFile::WriteOnly));
+        orphanFile.close();
+        QFile otherFile { QDir { directory.path() }.absoluteFilePath("other.txt") };
+        QVERIFY(otherFile.open(QFile::WriteOnly));
+        otherFile.close();
+
+        QCOMPARE(createCache(directory)->lookup(KEY, { 0., 100. }).m_Slices.size(),
+            std::size_t { 1 });
+        QCOMPARE(sliceFiles(directory).size(), 1);
+        QVERIFY(!orphanFile.exists());
+        QVERIFY(otherFile.exists());
+    }
+
+    void is_reset_by_an_index_of_another_version()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        createCache(directory)->insert(KEY, slice({ 0., 100. }));
+
+        QFile indexFile { QDir { directory.path() }.absoluteFilePath("index.json") };
+        QVERIFY(indexFile.open(QFile::WriteOnly));
+        indexFile.write(QJsonDocument { QJsonObject { { "version", 1 } } }.toJson());
+        indexFile.close();
+
+        auto cache = std::make_unique<TimeSeriesDiskCache>(directory.path());
+        QVERIFY(cache->lookup(KEY, { 0., 100. }).m_Slices.empty());
+        QVERIFY(sliceFiles(directory).isEmpty());
+    }
+
+    void removes_the_least_recently_used_slices_over_its_budget()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        auto cache = createCache(directory);
+        cache->setDiskBudget(2 * SCALAR_SLICE_FILE_SIZE);
+        cache->insert(KEY, slice({ 0., 100. }));
+        waitForNextUse();
+        cache->insert(KEY, slice({ 200., 300. }));
+        waitForNextUse();
+
+        // The first slice is used again, the second one is removed
+        QCOMPARE(cache->lookup(KEY, { 0., 100. }).m_Slices.size(), std::size_t { 1 });
+        waitForNextUse();
+        cache->insert(KEY, slice({ 400., 500. }));
+
+        QCOMPARE(sliceFiles(directory).size(), 2);
+        QCOMPARE(cache->lookup(KEY, { 0., 100. }).m_Slices.size(), std::size_t { 1 });
+        QVERIFY(cache->lookup(KEY, { 200., 300. }).m_Slices.empty());
+        QCOMPARE(cache->lookup(KEY, { 400., 500. }).m_Slices.size(), std::size_t { 1 });
+
+        // The removals are kept from one session to another
+        cache.reset();
+        QCOMPARE(createCache(directory)->lookup(KEY, { 0., 500. }).m_Slices.size(),
+            std::size_t { 2 });
+    }
+
+    void replaces_the_slices_covered_by_a_new_one()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        auto cache = createCache(directory);
+        cache->insert(KEY, slice({ 0., 100. }));
+        cache->insert(KEY, slice({ 150., 200. }));
+        cache->insert(KEY, slice({ 250., 400. }));
+
+        // The last slice is only partly covered
+        cache->insert(KEY, slice({ 0., 300. }));
+        QCOMPARE(sliceFiles(directory).size(), 2);
+
+        auto lookup = cache->lookup(KEY, { 0., 400. });
+        QCOMPARE(lookup.m_Slices.size(), std::size_t { 2 });
+        QVERIFY(lookup.m_MissingRanges.empty());
+        QCOMPARE(lookup.m_Slices.front().m_Range.m_TEnd, 300.);
+
+        // The replacements are kept from one session to another
+        cache.reset();
+        QCOMPARE(createCache(directory)->lookup(KEY, { 0., 400. }).m_Slices.size(),
+            std::size_t { 2 });
+    }
+
+    void stores_nothing_without_budget()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        auto cache = createCache(directory);
+        cache->setDiskBudget(0);
+        QVERIFY(!cache->isEnabled());
+        cache->insert(KEY, slice({ 0., 100. }));
+        QVERIFY(cache->lookup(KEY, { 0., 100. }).m_Slices.empty());
+        QVERIFY(sliceFiles(directory).isEmpty());
+    }
+
+    void removes_its_files_when_cleared()
+    {
+        QTemporaryDir directory {};
+        QVERIFY(directory.isValid());
+        auto cache = createCache(directory);
+        cache->insert(KEY, slice({ 0., 100. }));
+        cache->insert(QStringLiteral("other"), slice({ 0., 100. }));
+        QCOMPARE(sliceFiles(directory).size(), 2);
+
+        cache->clear();
+        QVERIFY(sliceFiles(directory).isEmpty());
+        QVERIFY(cache->lookup(KEY, { 0., 100. }).m_Slices.empty());
+        cache.reset();
+        QVERIFY(createCache(directory)->lookup(KEY, { 0., 100. }).m_Slices.empty());
+    }
+};
+
+QTEST_GUILESS_MAIN(A_TimeSeriesDiskCache)
+
+#include "main.moc"
@@ -0,0 +1,215 @@
+#include "AmdaParser.h"
+#include "AmdaProductIndex.h"
+#include "AmdaResultParser.h"
+
+#include <DataSource/DataSourceItem.h>
+#include <TimeSeries.h>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+
+namespace {
+
+/// Path of the fixtures of the result parser tests, whose headers are reused by the benchmarks
+const auto TESTS_RESOURCES_PATH
+    = QFileInfo{QString{AMDA_TESTS_RESOURCES_DIR}, "TestAmdaResultParser"}.absoluteFilePath();
+
+/// Format of the times written in the generated files
+const auto TIME_FORMAT = QStringLiteral("yyyy-MM-ddThh:mm:ss.zzz");
+
+/// Sizes of the generated files: 1 MB, 100 MB and 1 GB
+const auto FILE_SIZES = {1 << 20, 100 << 20, 1 << 30};
+
+/// Fixture from which a file of any size is generated: its header is kept and its data lines are
+/// replaced by lines starting at the time of its first line, one every @a m_Step seconds
+struct Fixture {
+    QString m_FileName;
+    DataSeriesType m_Type;
+    int m_ComponentCount;
+    int m_Step;
+};
+
+const auto SCALAR_FIXTURE = Fixture{"ValidScalar1.txt", DataSeriesType::SCALAR, 1, 60};
+const auto VECTOR_FIXTURE = Fixture{"ValidVector1.txt", DataSeriesType::VECTOR, 3, 16};
+const auto SPECTROGRAM_FIXTURE
+    = Fixture{"spectro/ValidSpectrogram1.txt", DataSeriesType::SPECTROGRAM, 3, 96};
+
+/**
+ * Generates an AMDA file from a fixture
+ * @param fixture the fixture
+ * @param size the min size of the file, in bytes
+ * @param lineCount set to the number of data lines generated
+ * @return the content of the file, empty if the fixture can't be read
+ */
+QByteArray generateFile(const Fixture &fixture, int size, int &lineCount)
+{
+    QFile file{QFileInfo{TESTS_RESOURCES_PATH, fixture.m_FileName}.absoluteFilePath()};
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        return QByteArray{};
+    }
+
+    auto result = QByteArray{};
+    result.reserve(size + 1024);
+
+    auto start = QDateTime{};
+    while (!file.atEnd() && !start.isValid()) {
+        auto line = file.readLine();
+        if (line.startsWith('#')) {
+            result += line;
+        }
+        else {
+            start = QDateTime::fromString(QString{line.left(23)}, TIME_FORMAT);
+            start.setTimeSpec(Qt::UTC);
+        }
+    }
+
+    lineCount = 0;
+    while (result.size() < size) {
+        result += start.addSecs(static_cast<qint64>(lineCount) * fixture.m_Step)
+                      .toString(TIME_FORMAT)
+                      .toLatin1();
+        for (auto component = 0; component < fixture.m_ComponentCount; ++component) {
+            result += "     " + QByteArray::number(std::cos(lineCount * 0.01 + component), 'f', 5);
+        }
+        result += '\n';
+        ++lineCount;
+    }
+    return result;
+}
+
+/// Counts the items of a tree, including its root
+int itemCount(const DataSourceItem &item)
+{
+    auto result = 1;
+    for (auto i = 0; i < item.childCount(); ++i) {
+        result += itemCount(*item.child(i));
+    }
+    return result;
+}
+
+/// Sets the throughputs reported for a benchmark, in bytes and points read per second
+void setThroughputs(benchmark::State &state, int64_t bytes, int64_t points)
+{
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * bytes);
+    state.counters["points"]
+        = benchmark::Counter{static_cast<double>(state.iterations() * points),
+                             benchmark::Counter::kIsRate};
+}
+
+void BM_ReadTxt(benchmark::State &state, const Fixture &fixture)
+{
+    auto lineCount = 0;
+    auto data = generateFile(fixture, static_cast<int>(state.range(0)), lineCount);
+    if (data.isEmpty()) {
+        state.SkipWithError("Fixture can't be read");
+        return;
+    }
+
+    for (auto _ : state) {
+        auto results = std::unique_ptr<TimeSeries::ITimeSerie>{
+            AmdaResultParser::readTxt(data, fixture.m_Type)};
+        if (!results) {
+            state.SkipWithError("File can't be parsed");
+            break;
+        }
+        benchmark::DoNotOptimize(results.get());
+    }
+
+    // A point is a value read, times excluded
+    setThroughputs(state, data.size(), static_cast<int64_t>(lineCount) * fixture.m_ComponentCount);
+}
+
+void BM_ReadJson(benchmark::State &state)
+{
+    auto filePath = QString{AMDA_TREE_FILE_PATH};
+    auto count = 0;
+    for (auto _ : state) {
+        auto item = AmdaParser::readJson(filePath);
+        if (!item) {
+            state.SkipWithError("Product tree can't be parsed");
+            break;
+        }
+        count = itemCount(*item);
+    }
+
+    // A point is an item of the tree
+    setThroughputs(state, QFileInfo{filePath}.size(), count);
+}
+
+void BM_IndexFromJson(benchmark::State &state)
+{
+    QFile file{QString{AMDA_TREE_FILE_PATH}};
+    if (!file.open(QFile::ReadOnly)) {
+        state.SkipWithError("Product tree can't be read");
+        return;
+    }
+    auto json = file.readAll();
+
+    auto count = 0;
+    for (auto _ : state) {
+        auto index = AmdaProductIndex::fromJson(json);
+        if (!index) {
+            state.SkipWithError("Product tree can't be parsed");
+            break;
+        }
+        count = index->size();
+    }
+
+    // A point is a node of the tree
+    setThroughputs(state, json.size(), count);
+}
+
+void BM_ReadIndex(benchmark::State &state)
+{
+    QFile file{QString{AMDA_TREE_FILE_PATH}};
+    auto index = file.open(QFile::ReadOnly) ? AmdaProductIndex::fromJson(file.readAll()) : nullptr;
+    if (!index) {
+        state.SkipWithError("Product tree can't be parsed");
+        return;
+    }
+
+    // The index is read from memory, as it would be from the cache file
+    auto data = QByteArray{};
+    {
+        QDataStream stream{&data, QIODevice::WriteOnly};
+        index->write(stream);
+    }
+
+    for (auto _ : state) {
+        QDataStream stream{data};
+        auto readIndex = AmdaProductIndex::read(stream);
+        if (!readIndex) {
+            state.SkipWithError("Index can't be read");
+            break;
+        }
+        benchmark::DoNotOptimize(readIndex.get());
+    }
+
+    setThroughputs(state, data.size(), index->size());
+}
+
+void fileSizes(benchmark::internal::Benchmark *bench)
+{
+    for (auto size : FILE_SIZES) {
+        bench->Arg(size);
+    }
+    bench->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_ReadTxt, scalar, SCALAR_FIXTURE)->Apply(fileSizes);
+BENCHMARK_CAPTURE(BM_ReadTxt, vector, VECTOR_FIXTURE)->Apply(fileSizes);
+BENCHMARK_CAPTURE(BM_ReadTxt, spectrogram, SPECTROGRAM_FIXTURE)->Apply(fileSizes);
+BENCHMARK(BM_ReadJson)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IndexFromJson)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReadIndex)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
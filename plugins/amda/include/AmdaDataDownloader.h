@@ -0,0 +1,47 @@
+#ifndef SCIQLOP_AMDADATADOWNLOADER_H
+#define SCIQLOP_AMDADATADOWNLOADER_H
+
+#include "AmdaGlobal.h"
+
+#include <QtCore/QLoggingCategory>
+
+#include <QtCore/QByteArray>
+
+#include <cstddef>
+#include <optional>
+
+Q_DECLARE_LOGGING_CATEGORY(LOG_AmdaDataDownloader)
+
+class AmdaResultStreamParser;
+class QUrl;
+
+/**
+ * @brief The AmdaDataDownloader struct sends the requests to AMDA and downloads the data files it
+ * generates, which are read while they are downloaded.
+ *
+ * Files compressed with gzip are decompressed on the fly, before being read: neither the file nor
+ * its decompressed bytes are stored.
+ *
+ * @sa AmdaResultStreamParser
+ * @sa GzipStreamDecoder
+ */
+struct SCIQLOP_AMDA_EXPORT AmdaDataDownloader {
+    /**
+     * Downloads a small file (token, description of the files generated...) in memory
+     * @param url the url of the file
+     * @return the content of the file, or nothing if it couldn't be downloaded
+     */
+    static std::optional<QByteArray> download(const QUrl &url) noexcept;
+
+    /**
+     * Downloads a data file and has it read by a parser as its bytes arrive
+     * @param url the url of the file
+     * @param parser the parser reading the file
+     * @param bufferSize the maximum number of bytes downloaded but not read yet
+     * @return true if the file was downloaded and read successfully
+     */
+    static bool downloadAndRead(const QUrl &url, AmdaResultStreamParser &parser,
+                                std::size_t bufferSize) noexcept;
+};
+
+#endif // SCIQLOP_AMDADATADOWNLOADER_H
@@ -13,6 +13,21 @@ extern const QString AMDA_DATA_TYPE_KEY;
 extern const QString AMDA_PRODUCT_KEY;
 extern const QString AMDA_SERVER_KEY;
 extern const QString AMDA_ROOT_KEY;
+extern const QString AMDA_SAMPLING_KEY;
+/// Time format of the data files of a product, when it differs from the one in the settings
+extern const QString AMDA_TIME_FORMAT_KEY;
 extern const QString AMDA_XML_ID_KEY;
 
+// Time formats of the data files: ISO 8601 dates or seconds since epoch
+extern const QString AMDA_TIME_FORMAT_ISO8601;
+extern const QString AMDA_TIME_FORMAT_UNIXTIME;
+
+// ///////////// //
+// AMDA settings //
+// ///////////// //
+
+/// Time format of the data files requested to AMDA
+extern const QString AMDA_TIME_FORMAT_SETTINGS_KEY;
+extern const QString AMDA_TIME_FORMAT_DEFAULT_VALUE;
+
 #endif // SCIQLOP_AMDADEFS_H
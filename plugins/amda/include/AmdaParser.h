@@ -9,6 +9,7 @@
 
 Q_DECLARE_LOGGING_CATEGORY(LOG_AmdaParser)
 
+class AmdaProductIndex;
 class DataSourceItem;
 
 struct SCIQLOP_AMDA_EXPORT AmdaParser {
@@ -18,6 +19,18 @@ struct SCIQLOP_AMDA_EXPORT AmdaParser {
      * @return the root of the created data source tree, nullptr if the file couldn't be parsed
      */
     static std::unique_ptr<DataSourceItem> readJson(const QString &filePath) noexcept;
+
+    /**
+     * Creates the index of a data source tree from a JSON file, from which the items of the tree
+     * can be created on demand. The index is cached in a file, which is read instead of the JSON
+     * file as long as the JSON file doesn't change
+     * @param filePath the path of the JSON file to read
+     * @param cacheFilePath the path of the file caching the index. If empty, no cache is used
+     * @return the index, nullptr if the JSON file couldn't be parsed
+     * @sa AmdaProductIndex
+     */
+    static std::unique_ptr<AmdaProductIndex> readIndex(const QString &filePath,
+                                                       const QString &cacheFilePath) noexcept;
 };
 
 #endif // SCIQLOP_AMDAPARSER_H
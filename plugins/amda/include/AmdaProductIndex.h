@@ -0,0 +1,114 @@
+#ifndef SCIQLOP_AMDAPRODUCTINDEX_H
+#define SCIQLOP_AMDAPRODUCTINDEX_H
+
+#include "AmdaGlobal.h"
+
+#include <QtCore/QLoggingCategory>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+Q_DECLARE_LOGGING_CATEGORY(LOG_AmdaProductIndex)
+
+class DataSourceItem;
+class QDataStream;
+
+/**
+ * @brief The AmdaProductIndex class is a compact representation of the AMDA product tree, from
+ * which the items of the tree are created on demand.
+ *
+ * The index is built from the JSON file of the tree in a single pass, without building a JSON
+ * document. Nodes and their properties are stored in flat arrays, and the strings of the file
+ * (keys and values) are stored once. The index can be written to a stream and read back, which is
+ * much faster than parsing the JSON file again.
+ *
+ * Items created from the index are the same as those created by AmdaParser::readJson(), except
+ * that they don't have children.
+ *
+ * @sa AmdaParser
+ */
+class SCIQLOP_AMDA_EXPORT AmdaProductIndex {
+public:
+    /// Identifier of a node that doesn't exist (parent of the root, end of the children...)
+    static const int NO_NODE = -1;
+
+    /**
+     * Builds an index from the content of a JSON file
+     * @param json the content of the file
+     * @return the index, nullptr if the content couldn't be parsed
+     */
+    static std::unique_ptr<AmdaProductIndex> fromJson(const QByteArray &json) noexcept;
+
+    /// Reads an index written by write(). @return the index, nullptr if it couldn't be read
+    static std::unique_ptr<AmdaProductIndex> read(QDataStream &stream) noexcept;
+
+    /// @return the hash of the content of a JSON file, used to identify the file of an index
+    static QByteArray sourceHash(const QByteArray &json) noexcept;
+
+    /// @return the hash of the content of the file of the index
+    QByteArray sourceHash() const noexcept { return m_SourceHash; }
+
+    /// Writes the index to a stream
+    void write(QDataStream &stream) const;
+
+    /// @return the root node of the tree, whose data is the one of the root element of the file
+    int root() const noexcept { return 0; }
+
+    /// @return the number of nodes of the tree
+    int size() const noexcept { return m_Nodes.size(); }
+
+    int parent(int node) const noexcept;
+    int childCount(int node) const noexcept;
+
+    /// @return the children of a node, in the order of readJson()
+    std::vector<int> children(int node) const;
+
+    /// @return the value of a property of a node, an invalid variant if the node doesn't have it
+    QVariant value(int node, const QString &key) const;
+
+    /// Creates the item of a node, with its data but without its children
+    std::unique_ptr<DataSourceItem> createItem(int node) const;
+
+    /// @return the nodes having a property value validating a filter, in increasing order
+    std::vector<int> find(const std::function<bool(const QVariant &value)> &filter) const;
+
+private:
+    friend class AmdaProductIndexBuilder;
+
+    /// Type of a property value, as in the JSON file
+    enum class ValueKind : quint8 { STRING, NUMBER, BOOL, NULL_VALUE };
+
+    struct Node {
+        quint8 m_Type;
+        qint32 m_Parent;
+        qint32 m_FirstChild;
+        qint32 m_NextSibling;
+        qint32 m_ChildCount;
+        qint32 m_FirstProperty;
+        qint32 m_PropertyCount;
+    };
+
+    /// Property of a node: key and value are indexes in the strings of the index. A property read
+    /// from an array is appended to the values of its key rather than replacing them
+    struct Property {
+        qint32 m_Key;
+        qint32 m_Value;
+        ValueKind m_Kind;
+        bool m_Append;
+    };
+
+    QVariant variant(const Property &property) const;
+
+    QByteArray m_SourceHash;
+    QVector<QString> m_Strings;
+    std::vector<Node> m_Nodes;
+    std::vector<Property> m_Properties;
+};
+
+#endif // SCIQLOP_AMDAPRODUCTINDEX_H
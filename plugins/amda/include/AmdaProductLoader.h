@@ -0,0 +1,49 @@
+#ifndef SCIQLOP_AMDAPRODUCTLOADER_H
+#define SCIQLOP_AMDAPRODUCTLOADER_H
+
+#include "AmdaGlobal.h"
+
+#include <DataSource/DataSourceItemLoader.h>
+
+#include <QUuid>
+
+#include <memory>
+
+class AmdaProductIndex;
+
+/**
+ * @brief The AmdaProductLoader class creates on demand the items of the AMDA product tree, from
+ * the index of the tree.
+ *
+ * Items get the actions and the metadata that the provider needs: products and components can be
+ * loaded, and the sampling of their dataset is passed down to them.
+ *
+ * @sa AmdaProductIndex
+ */
+class SCIQLOP_AMDA_EXPORT AmdaProductLoader : public DataSourceItemLoader {
+public:
+    /// Name under which the loader is registered
+    static const QString NAME;
+
+    explicit AmdaProductLoader(std::shared_ptr<AmdaProductIndex> index, const QUuid &dataSourceUid);
+
+    /// Creates the root item of the tree, without its children
+    std::unique_ptr<DataSourceItem> createRootItem() const;
+
+    bool canLoadChildren(const DataSourceItem &item) const override;
+    void loadChildren(DataSourceItem &item) override;
+    void loadMatchingItems(DataSourceItem &item, const FilterFunction &filter,
+                           int maxCount) override;
+
+private:
+    /// @return the node of an item, AmdaProductIndex::NO_NODE if it isn't an item of the index
+    int node(const DataSourceItem &item) const noexcept;
+
+    /// Creates the item of a node, without its children
+    std::unique_ptr<DataSourceItem> createItem(int node) const;
+
+    std::shared_ptr<AmdaProductIndex> m_Index;
+    QUuid m_DataSourceUid;
+};
+
+#endif // SCIQLOP_AMDAPRODUCTLOADER_H
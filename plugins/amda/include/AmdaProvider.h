@@ -21,10 +21,15 @@ class SCIQLOP_AMDA_EXPORT AmdaProvider : public IDataProvider
 {
     Q_OBJECT
 public:
-    explicit AmdaProvider();
+    /// @param serverUrl the url of the AMDA server to request. If empty, the url is the one of the
+    /// server of the application (@sa AmdaServer)
+    explicit AmdaProvider(const QString& serverUrl = {});
     std::shared_ptr<IDataProvider> clone() const override;
 
     virtual TimeSeries::ITimeSerie* getData(const DataProviderParameters& parameters) override;
+
+private:
+    QString m_ServerUrl;
 };
 
 #endif // SCIQLOP_AMDAPROVIDER_H
@@ -9,15 +9,22 @@
 
 #include <memory>
 
-class IDataSeries;
+class QByteArray;
+class QTextStream;
+
+namespace TimeSeries {
+class ITimeSerie;
+}
 
 Q_DECLARE_LOGGING_CATEGORY(LOG_AmdaResultParser)
 
 struct SCIQLOP_AMDA_EXPORT AmdaResultParser {
-    static std::shared_ptr<IDataSeries> readTxt(const QString &filePath,
-                                                DataSeriesType valueType) noexcept;
-    static IDataSeries* readTxt(QTextStream stream,
-                                                DataSeriesType type)noexcept;
+    static std::shared_ptr<TimeSeries::ITimeSerie> readTxt(const QString &filePath,
+                                                           DataSeriesType valueType) noexcept;
+    static TimeSeries::ITimeSerie *readTxt(QTextStream stream, DataSeriesType type) noexcept;
+    /// Reads AMDA results from bytes, in a single pass and without copying them. The bytes can be
+    /// those of a file mapped in memory
+    static TimeSeries::ITimeSerie *readTxt(const QByteArray &data, DataSeriesType type) noexcept;
 };
 
 #endif // SCIQLOP_AMDARESULTPARSER_H
@@ -46,34 +46,42 @@ extern const QString VALUES_UNIT_PROPERTY;
 /// ... - Units : m/s - ...
 extern const QRegularExpression DEFAULT_X_AXIS_UNIT_REGEX;
 
-/// Alternative regex to find x-axis unit in a line
-extern const QRegularExpression ALTERNATIVE_X_AXIS_UNIT_REGEX;
+// /////////////// //
+// Header keywords //
+// /////////////// //
 
-/// Regex to find end time of data in a line for a spectrogram
-extern const QRegularExpression SPECTROGRAM_END_TIME_REGEX;
+// Keywords of the header lines of the form "# KEYWORD : value". Examples of valid lines:
+// # PARAMETER_UNITS : nT
+// #       PARAMETER_TABLE_UNITS[0]:eV
 
-/// Regex to find fill value used in a line for a spectrogram
-extern const QRegularExpression SPECTROGRAM_FILL_VALUE_REGEX;
+/// Keyword of the x-axis unit, alternative to the regex
+extern const QString X_AXIS_UNIT_KEYWORD;
 
-/// Regex to find max bands in a line for a spectrogram
-extern const QRegularExpression SPECTROGRAM_MAX_BANDS_REGEX;
+/// Keyword of the end time of data for a spectrogram
+extern const QString SPECTROGRAM_END_TIME_KEYWORD;
 
-/// Regex to find min bands in a line for a spectrogram
-extern const QRegularExpression SPECTROGRAM_MIN_BANDS_REGEX;
+/// Keyword of the fill value for a spectrogram
+extern const QString SPECTROGRAM_FILL_VALUE_KEYWORD;
 
-/// Regex to find max x-axis sampling in a line for a spectrogram
-extern const QRegularExpression SPECTROGRAM_MAX_SAMPLING_REGEX;
+/// Keyword of the max bands for a spectrogram
+extern const QString SPECTROGRAM_MAX_BANDS_KEYWORD;
 
-/// Regex to find min x-axis sampling in a line for a spectrogram
-extern const QRegularExpression SPECTROGRAM_MIN_SAMPLING_REGEX;
+/// Keyword of the min bands for a spectrogram
+extern const QString SPECTROGRAM_MIN_BANDS_KEYWORD;
 
-/// Regex to find start time of data in a line for a spectrogram
-extern const QRegularExpression SPECTROGRAM_START_TIME_REGEX;
+/// Keyword of the max x-axis sampling for a spectrogram
+extern const QString SPECTROGRAM_MAX_SAMPLING_KEYWORD;
 
-/// Regex to find y-axis unit in a line for a spectrogram
-extern const QRegularExpression SPECTROGRAM_Y_AXIS_UNIT_REGEX;
+/// Keyword of the min x-axis sampling for a spectrogram
+extern const QString SPECTROGRAM_MIN_SAMPLING_KEYWORD;
 
-/// Regex to find values unit in a line for a spectrogram
-extern const QRegularExpression SPECTROGRAM_VALUES_UNIT_REGEX;
+/// Keyword of the start time of data for a spectrogram
+extern const QString SPECTROGRAM_START_TIME_KEYWORD;
+
+/// Keyword of the y-axis unit for a spectrogram
+extern const QString SPECTROGRAM_Y_AXIS_UNIT_KEYWORD;
+
+/// Keyword of the values unit for a spectrogram
+extern const QString SPECTROGRAM_VALUES_UNIT_KEYWORD;
 
 #endif // SCIQLOP_AMDARESULTPARSERDEFS_H
@@ -3,23 +3,49 @@
 
 #include "AmdaResultParserDefs.h"
 
+#include <Data/DataSeriesType.h>
+
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QString>
 
+#include <limits>
 #include <memory>
+#include <vector>
 
-class IDataSeries;
+namespace TimeSeries {
+class ITimeSerie;
+}
 
 Q_DECLARE_LOGGING_CATEGORY(LOG_AmdaResultParserHelper)
 
+/// Values read from the data section of an AMDA file
+struct AmdaResults {
+    std::vector<double> m_XAxisData{};
+    /// Values of the samples, one sample after another
+    std::vector<double> m_ValuesData{};
+
+    // Properties of spectrograms read in the header, needed to create the serie from the values
+    /// Centers of the bands, sorted
+    std::vector<double> m_YAxisData{};
+    double m_MinSampling{std::numeric_limits<double>::quiet_NaN()};
+    double m_MaxSampling{std::numeric_limits<double>::quiet_NaN()};
+};
+
 /**
- * Helper used to interpret the data of an AMDA result file and generate the corresponding data
- * series.
+ * Creates a time serie from values read in an AMDA file
+ * @param type the type of the values (scalars, vectors or spectrograms)
+ * @return the serie created, nullptr if the type of values isn't supported
+ */
+TimeSeries::ITimeSerie *createTimeSerie(DataSeriesType type, AmdaResults results);
+
+/**
+ * Helper used to interpret the data of an AMDA result file and generate the corresponding time
+ * serie.
  *
- * It proposes methods allowing to read line by line an AMDA file and to extract the properties
- * (from the header) and the values corresponding to the data series
+ * It proposes methods allowing to read an AMDA file and to extract the properties (line by line,
+ * from the header) and the values corresponding to the time serie (from the data section)
  *
- * @sa DataSeries
+ * @sa TimeSeries::ITimeSerie
  */
 struct IAmdaResultParserHelper {
     virtual ~IAmdaResultParserHelper() noexcept = default;
@@ -29,20 +55,34 @@ struct IAmdaResultParserHelper {
     /// @return true if the properties are well formed, false otherwise
     virtual bool checkProperties() = 0;
 
-    /// Creates the data series from the properties and values extracted from the AMDA file.
-    /// @warning as the data are moved in the data series, the helper shouldn't be used after
+    /// Creates the time serie from the properties and values extracted from the AMDA file.
+    /// @warning as the data are moved in the time serie, the helper shouldn't be used after
     /// calling this method
-    /// @return the data series created
-    virtual IDataSeries* createSeries() = 0;
+    /// @return the time serie created
+    virtual TimeSeries::ITimeSerie* createSeries() = 0;
 
     /// Reads a line from the AMDA file to extract a property that will be used to generate the data
     /// series
     /// @param line tahe line to interpret
     virtual void readPropertyLine(const QString &line) = 0;
 
-    /// Reads a line from the AMDA file to extract a value that will be set in the data series
-    /// @param line the line to interpret
-    virtual void readResultLine(const QString &line) = 0;
+    /// Reserves memory for the values of a number of result lines, before reading them
+    virtual void reserve(std::size_t lineCount) = 0;
+
+    /// Reads the result lines of the AMDA file to extract the values that will be set in the data
+    /// series. Large data sections are split in chunks read concurrently
+    /// @param begin the beginning of the first result line
+    /// @param end the end of the data section
+    virtual void readResults(const char *begin, const char *end) = 0;
+
+    /// Moves out the values read so far, so that the data section can be read in several parts
+    /// whose values are used as they come
+    /// @note no line of fill values is inserted in the data holes of spectrograms: the holes are
+    /// found from the times and the max sampling (@sa DataGaps)
+    virtual AmdaResults takeResults() = 0;
+
+    /// @return the properties read in the header of the AMDA file (units, samplings...)
+    virtual const Properties &properties() const = 0;
 };
 
 /**
@@ -51,13 +91,16 @@ struct IAmdaResultParserHelper {
 class ScalarParserHelper : public IAmdaResultParserHelper {
 public:
     bool checkProperties() override;
-    IDataSeries* createSeries() override;
+    TimeSeries::ITimeSerie* createSeries() override;
     void readPropertyLine(const QString &line) override;
-    void readResultLine(const QString &line) override;
+    void reserve(std::size_t lineCount) override;
+    void readResults(const char *begin, const char *end) override;
+    AmdaResults takeResults() override;
+    const Properties &properties() const override;
 
 private:
     /// @return the reading order of the "value" columns for a result line of the AMDA file
-    std::vector<int> valuesIndexes() const;
+    const std::vector<int> &valuesIndexes() const;
 
     Properties m_Properties{};
     std::vector<double> m_XAxisData{};
@@ -70,13 +113,14 @@ private:
 class SpectrogramParserHelper : public IAmdaResultParserHelper {
 public:
     bool checkProperties() override;
-    IDataSeries* createSeries() override;
+    TimeSeries::ITimeSerie* createSeries() override;
     void readPropertyLine(const QString &line) override;
-    void readResultLine(const QString &line) override;
+    void reserve(std::size_t lineCount) override;
+    void readResults(const char *begin, const char *end) override;
+    AmdaResults takeResults() override;
+    const Properties &properties() const override;
 
 private:
-    void handleDataHoles();
-
     Properties m_Properties{};
     std::vector<double> m_XAxisData{};
     std::vector<double> m_YAxisData{};
@@ -91,13 +135,16 @@ private:
 class VectorParserHelper : public IAmdaResultParserHelper {
 public:
     bool checkProperties() override;
-    IDataSeries* createSeries() override;
+    TimeSeries::ITimeSerie* createSeries() override;
     void readPropertyLine(const QString &line) override;
-    void readResultLine(const QString &line) override;
+    void reserve(std::size_t lineCount) override;
+    void readResults(const char *begin, const char *end) override;
+    AmdaResults takeResults() override;
+    const Properties &properties() const override;
 
 private:
     /// @return the reading order of the "value" columns for a result line of the AMDA file
-    std::vector<int> valuesIndexes() const;
+    const std::vector<int> &valuesIndexes() const;
 
     Properties m_Properties{};
     std::vector<double> m_XAxisData{};
@@ -0,0 +1,89 @@
+#ifndef SCIQLOP_AMDARESULTSTREAMPARSER_H
+#define SCIQLOP_AMDARESULTSTREAMPARSER_H
+
+#include "AmdaGlobal.h"
+#include "AmdaResultParserHelper.h"
+
+#include <Data/DataSeriesType.h>
+
+#include <QtCore/QByteArray>
+
+#include <functional>
+#include <memory>
+
+/**
+ * @brief The AmdaResultStreamParser class reads an AMDA result file as its bytes arrive, for
+ * example while it is downloaded.
+ *
+ * The header is read first, line by line. Once the first result line is reached, the properties
+ * are checked and the results are read each time enough complete lines have arrived. Only the last
+ * incomplete line and the lines not yet read are kept in memory.
+ *
+ * If a function is passed to the parser, the values of each part of the data section are moved to
+ * it as soon as they are read. Otherwise, they are accumulated to create the time serie at the
+ * end.
+ *
+ * @sa AmdaResultParser
+ */
+class SCIQLOP_AMDA_EXPORT AmdaResultStreamParser
+{
+public:
+    /// Function called with the values of a part of the data section, in the order of the file
+    using ResultsReadFun = std::function<void(AmdaResults results)>;
+
+    /**
+     * Ctor
+     * @param type the type of values expected in the file (scalars, vectors, spectrograms...)
+     * @param chunkSize the minimum number of bytes of result lines read at once. If null, the
+     * results are read as soon as they arrive
+     * @param resultsReadFun the function to which the values read are moved. If null, the values
+     * are kept to create the time serie
+     */
+    explicit AmdaResultStreamParser(DataSeriesType type, std::size_t chunkSize = 0,
+        ResultsReadFun resultsReadFun = nullptr);
+    ~AmdaResultStreamParser() noexcept;
+
+    /// Reads the bytes that arrived
+    /// @return false if the file is invalid (not found on server, wrong properties...), in which
+    /// case the next bytes can be discarded
+    bool feed(const char* begin, const char* end);
+    bool feed(const QByteArray& bytes);
+
+    /// Reads the bytes not read yet, once all the bytes of the file have arrived
+    /// @return false if the file is invalid
+    bool finish();
+
+    /// Creates the time serie from the values accumulated. Must be called after finish()
+    /// @return the time serie created, nullptr if the file is invalid
+    TimeSeries::ITimeSerie* createSeries();
+
+    /// Returns the properties read in the header of the file (units, samplings...), which time
+    /// series don't carry. Properties are empty if the type of values isn't supported
+    Properties properties() const;
+
+private:
+    enum class State
+    {
+        FIRST_LINE,
+        HEADER,
+        RESULTS,
+        INVALID
+    };
+
+    /// Reads the bytes available. If they are not the last bytes of the file, the last line is
+    /// considered incomplete
+    /// @return the first byte that hasn't been read, and must be read with the next bytes
+    const char* read(const char* begin, const char* end, bool isLast);
+
+    std::unique_ptr<IAmdaResultParserHelper> m_Helper;
+    std::size_t m_ChunkSize;
+    ResultsReadFun m_ResultsReadFun;
+    State m_State;
+    /// Length of the first result line, used to estimate the number of results in the next bytes
+    std::size_t m_LineLength { 1 };
+    bool m_HasReadResults { false };
+    /// Bytes arrived but not read yet
+    QByteArray m_Buffer {};
+};
+
+#endif // SCIQLOP_AMDARESULTSTREAMPARSER_H
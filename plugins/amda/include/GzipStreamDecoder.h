@@ -0,0 +1,65 @@
+#ifndef SCIQLOP_GZIPSTREAMDECODER_H
+#define SCIQLOP_GZIPSTREAMDECODER_H
+
+#include "AmdaGlobal.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QLoggingCategory>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+Q_DECLARE_LOGGING_CATEGORY(LOG_GzipStreamDecoder)
+
+struct z_stream_s;
+
+/**
+ * @brief The GzipStreamDecoder class decompresses gzip data as its bytes arrive, and passes the
+ * decompressed bytes to a function block after block, without keeping the whole data in memory.
+ *
+ * The data is detected as compressed from its first bytes (gzip magic number). Data that isn't
+ * compressed is passed as is, so that the decoder can be used whether the server compressed the
+ * data or not. Data made of several gzip members (concatenated gzip files) is supported.
+ */
+class SCIQLOP_AMDA_EXPORT GzipStreamDecoder
+{
+public:
+    /// Function called with each block of decompressed bytes
+    /// @return false to stop the decoding (for example, if the bytes are invalid)
+    using OutputFun = std::function<bool(const char* begin, const char* end)>;
+
+    explicit GzipStreamDecoder(OutputFun outputFun);
+    ~GzipStreamDecoder() noexcept;
+
+    /// Decodes the bytes that arrived
+    /// @return false if the bytes are corrupted or if the output function stopped the decoding
+    bool feed(const char* begin, const char* end);
+    bool feed(const QByteArray& bytes);
+
+    /// Checks that all the data was decoded, once all the bytes have arrived
+    /// @return false if the compressed data is truncated or invalid
+    bool finish();
+
+private:
+    enum class State
+    {
+        DETECTING,
+        PLAIN,
+        GZIP,
+        INVALID
+    };
+
+    bool inflate(const char* begin, const char* end);
+
+    OutputFun m_OutputFun;
+    State m_State { State::DETECTING };
+    /// First bytes arrived, kept until there are enough of them to detect the compression
+    QByteArray m_FirstBytes {};
+    std::unique_ptr<z_stream_s> m_Stream;
+    /// A gzip member has been fully decoded, and no byte arrived after it
+    bool m_IsMemberEnded { false };
+    std::vector<char> m_OutputBuffer;
+};
+
+#endif // SCIQLOP_GZIPSTREAMDECODER_H
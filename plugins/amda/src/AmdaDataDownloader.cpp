@@ -0,0 +1,88 @@
+#include "AmdaDataDownloader.h"
+#include "AmdaResultStreamParser.h"
+#include "GzipStreamDecoder.h"
+
+#include <QEventLoop>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QUrl>
+
+Q_LOGGING_CATEGORY(LOG_AmdaDataDownloader, "AmdaDataDownloader")
+
+namespace
+{
+
+/**
+ * Sends a GET request and waits for its reply, passing the bytes received to a function as they
+ * arrive
+ * @param url the url of the request
+ * @param bufferSize the maximum number of bytes received but not read yet. If null, the buffer is
+ * unbounded
+ * @param readFun the function reading the bytes. If it returns false, the request is aborted
+ * @return true if all the bytes were received and read successfully
+ */
+template <typename ReadFun>
+bool get(const QUrl& url, std::size_t bufferSize, ReadFun readFun)
+{
+    QNetworkAccessManager networkManager {};
+    auto request = QNetworkRequest { url };
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+
+    // The reply stops receiving bytes when its buffer is full, until they are read
+    auto reply = networkManager.get(request);
+    reply->setReadBufferSize(static_cast<qint64>(bufferSize));
+
+    auto readOk = true;
+    QEventLoop eventLoop {};
+    QObject::connect(reply, &QNetworkReply::readyRead, [&]() {
+        if (!readFun(reply->readAll()))
+        {
+            readOk = false;
+            reply->abort();
+        }
+    });
+    QObject::connect(reply, &QNetworkReply::finished, &eventLoop, &QEventLoop::quit);
+    eventLoop.exec();
+
+    if (!readOk)
+    {
+        return false;
+    }
+    if (reply->error() != QNetworkReply::NoError)
+    {
+        qCWarning(LOG_AmdaDataDownloader())
+            << QObject::tr("Can't download %1: %2").arg(url.toString(), reply->errorString());
+        return false;
+    }
+
+    return readFun(reply->readAll());
+}
+
+} // namespace
+
+std::optional<QByteArray> AmdaDataDownloader::download(const QUrl& url) noexcept
+{
+    auto result = QByteArray {};
+    if (!get(url, 0, [&result](const QByteArray& bytes) {
+            result += bytes;
+            return true;
+        }))
+    {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+bool AmdaDataDownloader::downloadAndRead(
+    const QUrl& url, AmdaResultStreamParser& parser, std::size_t bufferSize) noexcept
+{
+    // Bytes are decompressed (if needed) then read as they arrive. If the file is invalid, the
+    // download is stopped
+    GzipStreamDecoder decoder { [&parser](const char* begin, const char* end) {
+        return parser.feed(begin, end);
+    } };
+
+    return get(url, bufferSize, [&decoder](const QByteArray& bytes) { return decoder.feed(bytes); })
+        && decoder.finish() && parser.finish();
+}
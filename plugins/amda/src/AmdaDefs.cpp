@@ -5,4 +5,12 @@ const QString AMDA_DATA_TYPE_KEY = QStringLiteral("dataType");
 const QString AMDA_PRODUCT_KEY = QStringLiteral("parameter");
 const QString AMDA_SERVER_KEY = QStringLiteral("server");
 const QString AMDA_ROOT_KEY = QStringLiteral("dataCenter");
+const QString AMDA_SAMPLING_KEY = QStringLiteral("sampling");
+const QString AMDA_TIME_FORMAT_KEY = QStringLiteral("timeFormat");
 const QString AMDA_XML_ID_KEY = QStringLiteral("xml:id");
+
+const QString AMDA_TIME_FORMAT_ISO8601 = QStringLiteral("ISO8601");
+const QString AMDA_TIME_FORMAT_UNIXTIME = QStringLiteral("UNIXTIME");
+
+const QString AMDA_TIME_FORMAT_SETTINGS_KEY = QStringLiteral("Amda/timeFormat");
+const QString AMDA_TIME_FORMAT_DEFAULT_VALUE = AMDA_TIME_FORMAT_UNIXTIME;
@@ -1,12 +1,17 @@
 #include "AmdaParser.h"
 #include "AmdaDefs.h"
+#include "AmdaProductIndex.h"
 
 #include <DataSource/DataSourceItem.h>
 
+#include <QDataStream>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QSaveFile>
 
 Q_LOGGING_CATEGORY(LOG_AmdaParser, "AmdaParser")
 
@@ -123,3 +128,51 @@ std::unique_ptr<DataSourceItem> AmdaParser::readJson(const QString &filePath) no
 
     return rootItem;
 }
+
+std::unique_ptr<AmdaProductIndex> AmdaParser::readIndex(const QString &filePath,
+                                                       const QString &cacheFilePath) noexcept
+{
+    QFile jsonFile{filePath};
+    if (!jsonFile.open(QIODevice::ReadOnly)) {
+        qCCritical(LOG_AmdaParser())
+            << QObject::tr("Can't retrieve data source tree from file %1: %2")
+                   .arg(filePath, jsonFile.errorString());
+        return nullptr;
+    }
+    auto json = jsonFile.readAll();
+
+    // The cached index is used if it was built from the same file
+    QFile cacheFile{cacheFilePath};
+    if (!cacheFilePath.isEmpty() && cacheFile.open(QIODevice::ReadOnly)) {
+        QDataStream stream{&cacheFile};
+        auto index = AmdaProductIndex::read(stream);
+        if (index && index->sourceHash() == AmdaProductIndex::sourceHash(json)) {
+            return index;
+        }
+        cacheFile.close();
+    }
+
+    auto index = AmdaProductIndex::fromJson(json);
+    if (!index) {
+        qCCritical(LOG_AmdaParser())
+            << QObject::tr("Can't retrieve data source tree from file %1").arg(filePath);
+        return nullptr;
+    }
+
+    if (!cacheFilePath.isEmpty()) {
+        QSaveFile saveFile{cacheFilePath};
+        if (QDir{}.mkpath(QFileInfo{cacheFilePath}.absolutePath())
+            && saveFile.open(QIODevice::WriteOnly)) {
+            QDataStream stream{&saveFile};
+            index->write(stream);
+            if (stream.status() == QDataStream::Ok && saveFile.commit()) {
+                return index;
+            }
+        }
+        qCWarning(LOG_AmdaParser())
+            << QObject::tr("Can't cache the index of the data source tree in file %1: %2")
+                   .arg(cacheFilePath, saveFile.errorString());
+    }
+
+    return index;
+}
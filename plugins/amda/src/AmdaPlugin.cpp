@@ -1,15 +1,19 @@
 #include "AmdaPlugin.h"
-#include "AmdaDefs.h"
 #include "AmdaParser.h"
+#include "AmdaProductIndex.h"
+#include "AmdaProductLoader.h"
 #include "AmdaProvider.h"
 #include "AmdaServer.h"
 
+#include <DataSource/CachedDataProvider.h>
 #include <DataSource/DataSourceController.h>
 #include <DataSource/DataSourceItem.h>
-#include <DataSource/DataSourceItemAction.h>
 
 #include <SqpApplication.h>
 
+#include <QDir>
+#include <QStandardPaths>
+
 Q_LOGGING_CATEGORY(LOG_AmdaPlugin, "AmdaPlugin")
 
 namespace {
@@ -17,36 +21,9 @@ namespace {
 /// Path of the file used to generate the data source item for AMDA
 const auto JSON_FILE_PATH = QStringLiteral(":/samples/amda_tree.json");
 
-void associateActions(DataSourceItem &item, const QUuid &dataSourceUid)
-{
-    auto addLoadAction = [&item, dataSourceUid](const QString &label) {
-        item.addAction(
-            std::make_unique<DataSourceItemAction>(label, [dataSourceUid](DataSourceItem &item) {
-                if (auto app = sqpApp) {
-                    app->dataSourceController().loadProductItem(dataSourceUid, item);
-                }
-            }));
-    };
-
-    const auto itemType = item.type();
-    if (itemType == DataSourceItemType::PRODUCT || itemType == DataSourceItemType::COMPONENT) {
-        // Adds plugin name to item metadata
-        item.setData(DataSourceItem::PLUGIN_DATA_KEY, AmdaServer::instance().name());
-
-        // Adds load action
-        auto actionLabel = QObject::tr(
-            itemType == DataSourceItemType::PRODUCT ? "Load %1 product" : "Load %1 component");
-        addLoadAction(actionLabel.arg(item.name()));
-        item.setData(DataSourceItem::ID_DATA_KEY, item.data(AMDA_XML_ID_KEY));
-    }
-
-    auto count = item.childCount();
-    for (auto i = 0; i < count; ++i) {
-        if (auto child = item.child(i)) {
-            associateActions(*child, dataSourceUid);
-        }
-    }
-}
+/// Name of the file caching the index of the AMDA product tree, in the cache location of the
+/// application
+const auto INDEX_CACHE_FILE_NAME = QStringLiteral("amda/product_index.bin");
 
 } // namespace
 
@@ -59,19 +36,25 @@ void AmdaPlugin::initialize()
         auto &dataSourceController = app->dataSourceController();
         auto dataSourceUid = dataSourceController.registerDataSource(dataSourceName);
 
-        // Sets data source tree
-        if (auto dataSourceItem = AmdaParser::readJson(JSON_FILE_PATH)) {
-            dataSourceItem->setData(DataSourceItem::NAME_DATA_KEY, dataSourceName);
+        // Sets data source tree. Only its root is created: the other items are created from the
+        // index of the tree when they are displayed
+        auto cacheFilePath = QDir{QStandardPaths::writableLocation(QStandardPaths::CacheLocation)}
+                                 .absoluteFilePath(INDEX_CACHE_FILE_NAME);
+        if (auto index = AmdaParser::readIndex(JSON_FILE_PATH, cacheFilePath)) {
+            auto loader = std::make_shared<AmdaProductLoader>(std::move(index), dataSourceUid);
+            DataSourceItemLoader::registerLoader(AmdaProductLoader::NAME, loader);
 
-            associateActions(*dataSourceItem, dataSourceUid);
+            auto dataSourceItem = loader->createRootItem();
+            dataSourceItem->setData(DataSourceItem::NAME_DATA_KEY, dataSourceName);
             dataSourceController.setDataSourceItem(dataSourceUid, std::move(dataSourceItem));
         }
         else {
             qCCritical(LOG_AmdaPlugin()) << tr("No data source item could be generated for AMDA");
         }
 
-        // Sets data provider
-        dataSourceController.setDataProvider(dataSourceUid, std::make_unique<AmdaProvider>());
+        // Sets data provider, whose data is kept in the application cache
+        dataSourceController.setDataProvider(dataSourceUid,
+            std::make_unique<CachedDataProvider>(dataSourceName, std::make_shared<AmdaProvider>()));
     }
     else {
         qCWarning(LOG_AmdaPlugin()) << tr("Can't access to SciQlop application");
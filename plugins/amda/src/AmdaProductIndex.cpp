@@ -0,0 +1,705 @@
+#include "AmdaProductIndex.h"
+#include "AmdaDefs.h"
+
+#include <DataSource/DataSourceItem.h>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QHash>
+
+#include <algorithm>
+#include <cctype>
+
+Q_LOGGING_CATEGORY(LOG_AmdaProductIndex, "AmdaProductIndex")
+
+namespace
+{
+
+/// Magic at the beginning of a serialized index
+const quint32 INDEX_MAGIC = 0x41504958;
+
+/// Version of the layout of a serialized index. Indexes of another version are ignored
+const quint32 FORMAT_VERSION = 1;
+
+/// Max depth of the JSON file, beyond which it is considered malformed
+const auto MAX_DEPTH = 64;
+
+/// Returns the correct item type according to the key of an object (same as AmdaParser)
+DataSourceItemType itemType(const QString& key) noexcept
+{
+    if (key == AMDA_PRODUCT_KEY)
+    {
+        return DataSourceItemType::PRODUCT;
+    }
+    else if (key == AMDA_COMPONENT_KEY)
+    {
+        return DataSourceItemType::COMPONENT;
+    }
+    else
+    {
+        return DataSourceItemType::NODE;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief The AmdaProductIndexBuilder class reads a JSON file token by token and builds the index
+ * of the AMDA product tree as it goes.
+ *
+ * The tree is built as AmdaParser::readJson() does: an object is a node whose type depends on its
+ * key, the values of an array are the entries of their key, and simple values are properties.
+ */
+class AmdaProductIndexBuilder
+{
+public:
+    /// Reasons why an index can't be built
+    enum class Error
+    {
+        NONE,
+        MALFORMED_FILE,
+        ROOT_NOT_FOUND,
+        WRONG_ROOT_TYPE
+    };
+
+    explicit AmdaProductIndexBuilder(const QByteArray& json, AmdaProductIndex& index)
+            : m_It { json.constData() }, m_End { json.constData() + json.size() }, m_Index { index }
+    {
+    }
+
+    Error build()
+    {
+        // The file must be a single object, whose entry for the root key is the root node
+        if (peek() != '{')
+        {
+            return Error::MALFORMED_FILE;
+        }
+        ++m_It;
+
+        auto rootFound = false;
+        if (!consume('}'))
+        {
+            do
+            {
+                auto key = QString {};
+                if (!readKey(key))
+                {
+                    return Error::MALFORMED_FILE;
+                }
+
+                if (key == AMDA_ROOT_KEY && !rootFound)
+                {
+                    rootFound = true;
+                    if (peek() != '{')
+                    {
+                        return skipValue(1) ? Error::WRONG_ROOT_TYPE : Error::MALFORMED_FILE;
+                    }
+                    auto root = newNode(DataSourceItemType::NODE, AmdaProductIndex::NO_NODE);
+                    if (!readObject(root, 1))
+                    {
+                        return Error::MALFORMED_FILE;
+                    }
+                }
+                else if (!skipValue(1))
+                {
+                    return Error::MALFORMED_FILE;
+                }
+            } while (consume(','));
+
+            if (!consume('}'))
+            {
+                return Error::MALFORMED_FILE;
+            }
+        }
+
+        if (peek() != '\0' || m_It != m_End)
+        {
+            return Error::MALFORMED_FILE;
+        }
+        return rootFound ? Error::NONE : Error::ROOT_NOT_FOUND;
+    }
+
+private:
+    /// Entries of an object not stored in the index yet, as they are stored node by node
+    struct PendingEntries
+    {
+        std::vector<AmdaProductIndex::Property> m_Properties;
+        std::vector<std::pair<QString, int>> m_Children;
+    };
+
+    /// Skips the whitespaces. @return the next character, '\0' at the end of the file
+    char peek() noexcept
+    {
+        while (m_It != m_End && (*m_It == ' ' || *m_It == '\n' || *m_It == '\r' || *m_It == '\t'))
+        {
+            ++m_It;
+        }
+        return m_It != m_End ? *m_It : '\0';
+    }
+
+    /// Reads a character if it is the next one
+    bool consume(char c) noexcept
+    {
+        if (peek() == c)
+        {
+            ++m_It;
+            return true;
+        }
+        return false;
+    }
+
+    bool readString(QString& result)
+    {
+        if (peek() != '"')
+        {
+            return false;
+        }
+        ++m_It;
+
+        // Unescaped parts of the string are converted at once
+        result.clear();
+        auto segment = m_It;
+        while (m_It != m_End)
+        {
+            auto c = *m_It;
+            if (c == '"')
+            {
+                result += QString::fromUtf8(segment, static_cast<int>(m_It - segment));
+                ++m_It;
+                return true;
+            }
+            else if (c == '\\')
+            {
+                result += QString::fromUtf8(segment, static_cast<int>(m_It - segment));
+                if (++m_It == m_End)
+                {
+                    return false;
+                }
+
+                switch (*m_It++)
+                {
+                    case '"':
+                        result += QLatin1Char { '"' };
+                        break;
+                    case '\\':
+                        result += QLatin1Char { '\\' };
+                        break;
+                    case '/':
+                        result += QLatin1Char { '/' };
+                        break;
+                    case 'b':
+                        result += QLatin1Char { '\b' };
+                        break;
+                    case 'f':
+                        result += QLatin1Char { '\f' };
+                        break;
+                    case 'n':
+                        result += QLatin1Char { '\n' };
+                        break;
+                    case 'r':
+                        result += QLatin1Char { '\r' };
+                        break;
+                    case 't':
+                        result += QLatin1Char { '\t' };
+                        break;
+                    case 'u':
+                    {
+                        // Surrogate pairs are two escaped UTF-16 code units, appended one by one
+                        auto ok = false;
+                        auto code = m_End - m_It >= 4
+                            ? QByteArray::fromRawData(m_It, 4).toUShort(&ok, 16)
+                            : ushort { 0 };
+                        if (!ok)
+                        {
+                            return false;
+                        }
+                        result += QChar { code };
+                        m_It += 4;
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+                segment = m_It;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                return false;
+            }
+            else
+            {
+                ++m_It;
+            }
+        }
+        return false;
+    }
+
+    /// Reads the key of an entry and the separator following it
+    bool readKey(QString& key) { return readString(key) && consume(':'); }
+
+    /// Reads a simple value (string, number, boolean or null), as written in the file
+    bool readSimpleValue(AmdaProductIndex::ValueKind& kind, QString& text)
+    {
+        auto c = peek();
+        if (c == '"')
+        {
+            kind = AmdaProductIndex::ValueKind::STRING;
+            return readString(text);
+        }
+
+        auto start = m_It;
+        while (m_It != m_End
+            && (std::isalnum(static_cast<unsigned char>(*m_It)) || *m_It == '-' || *m_It == '+'
+                || *m_It == '.'))
+        {
+            ++m_It;
+        }
+        auto token = QByteArray::fromRawData(start, static_cast<int>(m_It - start));
+        text = QString::fromLatin1(token);
+
+        if (token == "true" || token == "false")
+        {
+            kind = AmdaProductIndex::ValueKind::BOOL;
+            return true;
+        }
+        if (token == "null")
+        {
+            kind = AmdaProductIndex::ValueKind::NULL_VALUE;
+            return true;
+        }
+
+        auto ok = false;
+        token.toDouble(&ok);
+        kind = AmdaProductIndex::ValueKind::NUMBER;
+        return ok && (c == '-' || std::isdigit(static_cast<unsigned char>(c)));
+    }
+
+    /// Reads a value without storing it
+    bool skipValue(int depth)
+    {
+        if (depth > MAX_DEPTH)
+        {
+            return false;
+        }
+
+        switch (peek())
+        {
+            case '{':
+            {
+                ++m_It;
+                if (consume('}'))
+                {
+                    return true;
+                }
+                auto key = QString {};
+                do
+                {
+                    if (!readKey(key) || !skipValue(depth + 1))
+                    {
+                        return false;
+                    }
+                } while (consume(','));
+                return consume('}');
+            }
+            case '[':
+            {
+                ++m_It;
+                if (consume(']'))
+                {
+                    return true;
+                }
+                do
+                {
+                    if (!skipValue(depth + 1))
+                    {
+                        return false;
+                    }
+                } while (consume(','));
+                return consume(']');
+            }
+            default:
+            {
+                auto kind = AmdaProductIndex::ValueKind {};
+                auto text = QString {};
+                return readSimpleValue(kind, text);
+            }
+        }
+    }
+
+    /// Reads an object into a node
+    bool readObject(int node, int depth)
+    {
+        if (depth > MAX_DEPTH || !consume('{'))
+        {
+            return false;
+        }
+
+        auto entries = PendingEntries {};
+        if (!consume('}'))
+        {
+            auto key = QString {};
+            do
+            {
+                if (!readKey(key) || !readEntry(key, node, false, entries, depth))
+                {
+                    return false;
+                }
+            } while (consume(','));
+
+            if (!consume('}'))
+            {
+                return false;
+            }
+        }
+
+        storeEntries(node, entries);
+        return true;
+    }
+
+    /**
+     * Reads the value of an entry of an object
+     * @param key the key of the entry
+     * @param node the node of the object
+     * @param isArrayEntry true if the value is in an array, in which case it is appended to the
+     * values of the key
+     * @param entries the entries of the object read so far
+     */
+    bool readEntry(const QString& key, int node, bool isArrayEntry, PendingEntries& entries,
+        int depth)
+    {
+        switch (peek())
+        {
+            case '{':
+            {
+                auto child = newNode(itemType(key), node);
+                if (!readObject(child, depth + 1))
+                {
+                    return false;
+                }
+                entries.m_Children.emplace_back(key, child);
+                return true;
+            }
+            case '[':
+            {
+                ++m_It;
+                if (consume(']'))
+                {
+                    return true;
+                }
+                do
+                {
+                    if (!readEntry(key, node, true, entries, depth + 1))
+                    {
+                        return false;
+                    }
+                } while (consume(','));
+                return consume(']');
+            }
+            default:
+            {
+                auto kind = AmdaProductIndex::ValueKind {};
+                auto text = QString {};
+                if (!readSimpleValue(kind, text))
+                {
+                    return false;
+                }
+                entries.m_Properties.push_back({ intern(key), intern(text), kind, isArrayEntry });
+                return true;
+            }
+        }
+    }
+
+    int newNode(DataSourceItemType type, int parent)
+    {
+        m_Index.m_Nodes.push_back({ static_cast<quint8>(type), parent, AmdaProductIndex::NO_NODE,
+            AmdaProductIndex::NO_NODE, 0, 0, 0 });
+        return static_cast<int>(m_Index.m_Nodes.size()) - 1;
+    }
+
+    /// Stores the entries of an object in its node, once all its descendants have been read
+    void storeEntries(int node, PendingEntries& entries)
+    {
+        auto& indexNode = m_Index.m_Nodes[node];
+        indexNode.m_FirstProperty = static_cast<qint32>(m_Index.m_Properties.size());
+        indexNode.m_PropertyCount = static_cast<qint32>(entries.m_Properties.size());
+        m_Index.m_Properties.insert(m_Index.m_Properties.cend(),
+            entries.m_Properties.cbegin(), entries.m_Properties.cend());
+
+        // Children are ordered as the entries of a QJsonObject, which are sorted by key
+        std::stable_sort(entries.m_Children.begin(), entries.m_Children.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        indexNode.m_ChildCount = static_cast<qint32>(entries.m_Children.size());
+        auto previous = AmdaProductIndex::NO_NODE;
+        for (const auto& child : entries.m_Children)
+        {
+            if (previous == AmdaProductIndex::NO_NODE)
+            {
+                indexNode.m_FirstChild = child.second;
+            }
+            else
+            {
+                m_Index.m_Nodes[previous].m_NextSibling = child.second;
+            }
+            previous = child.second;
+        }
+    }
+
+    /// @return the index of a string in the strings of the index, which is added if needed
+    qint32 intern(const QString& string)
+    {
+        auto it = m_StringIndexes.find(string);
+        if (it == m_StringIndexes.end())
+        {
+            it = m_StringIndexes.insert(string, m_Index.m_Strings.size());
+            m_Index.m_Strings.push_back(string);
+        }
+        return it.value();
+    }
+
+    const char* m_It;
+    const char* m_End;
+    AmdaProductIndex& m_Index;
+    QHash<QString, qint32> m_StringIndexes;
+};
+
+std::unique_ptr<AmdaProductIndex> AmdaProductIndex::fromJson(const QByteArray& json) noexcept
+{
+    auto index = std::make_unique<AmdaProductIndex>();
+    switch (AmdaProductIndexBuilder { json, *index }.build())
+    {
+        case AmdaProductIndexBuilder::Error::NONE:
+            index->m_SourceHash = sourceHash(json);
+            return index;
+        case AmdaProductIndexBuilder::Error::MALFORMED_FILE:
+            qCCritical(LOG_AmdaProductIndex())
+                << QObject::tr("Can't build AMDA product index: the file is malformed");
+            break;
+        case AmdaProductIndexBuilder::Error::ROOT_NOT_FOUND:
+            qCCritical(LOG_AmdaProductIndex())
+                << QObject::tr("Can't build AMDA product index: the key for the root element "
+                               "was not found (%1)")
+                       .arg(AMDA_ROOT_KEY);
+            break;
+        case AmdaProductIndexBuilder::Error::WRONG_ROOT_TYPE:
+            qCCritical(LOG_AmdaProductIndex())
+                << QObject::tr("Can't build AMDA product index: the root element is of the "
+                               "wrong type");
+            break;
+    }
+    return nullptr;
+}
+
+std::unique_ptr<AmdaProductIndex> AmdaProductIndex::read(QDataStream& stream) noexcept
+{
+    stream.setVersion(QDataStream::Qt_5_6);
+
+    auto magic = quint32 { 0 };
+    auto version = quint32 { 0 };
+    stream >> magic >> version;
+    if (magic != INDEX_MAGIC || version != FORMAT_VERSION)
+    {
+        return nullptr;
+    }
+
+    auto index = std::make_unique<AmdaProductIndex>();
+    auto nodeCount = quint32 { 0 };
+    stream >> index->m_SourceHash >> index->m_Strings >> nodeCount;
+    if (stream.status() != QDataStream::Ok)
+    {
+        return nullptr;
+    }
+
+    for (auto i = quint32 { 0 }; i < nodeCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        auto node = Node {};
+        stream >> node.m_Type >> node.m_Parent >> node.m_FirstChild >> node.m_NextSibling
+            >> node.m_ChildCount >> node.m_FirstProperty >> node.m_PropertyCount;
+        index->m_Nodes.push_back(node);
+    }
+
+    auto propertyCount = quint32 { 0 };
+    stream >> propertyCount;
+    for (auto i = quint32 { 0 }; i < propertyCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        auto property = Property {};
+        auto kind = quint8 { 0 };
+        stream >> property.m_Key >> property.m_Value >> kind >> property.m_Append;
+        property.m_Kind = static_cast<ValueKind>(kind);
+        index->m_Properties.push_back(property);
+    }
+
+    if (stream.status() != QDataStream::Ok || index->m_Nodes.empty())
+    {
+        return nullptr;
+    }
+
+    // The index may come from a damaged file, so it is checked before being used
+    auto nodeOk = [&index](qint32 node) { return node >= NO_NODE && node < index->size(); };
+    auto nodesOk = std::all_of(
+        index->m_Nodes.cbegin(), index->m_Nodes.cend(), [&index, &nodeOk](const auto& node) {
+            return nodeOk(node.m_Parent) && nodeOk(node.m_FirstChild)
+                && nodeOk(node.m_NextSibling) && node.m_FirstProperty >= 0
+                && node.m_PropertyCount >= 0
+                && static_cast<std::size_t>(node.m_FirstProperty) + node.m_PropertyCount
+                <= index->m_Properties.size();
+        });
+    auto propertiesOk = std::all_of(index->m_Properties.cbegin(), index->m_Properties.cend(),
+        [stringCount = index->m_Strings.size()](const auto& property) {
+            return property.m_Key >= 0 && property.m_Key < stringCount && property.m_Value >= 0
+                && property.m_Value < stringCount && property.m_Kind <= ValueKind::NULL_VALUE;
+        });
+    if (!nodesOk || !propertiesOk)
+    {
+        return nullptr;
+    }
+    return index;
+}
+
+QByteArray AmdaProductIndex::sourceHash(const QByteArray& json) noexcept
+{
+    return QCryptographicHash::hash(json, QCryptographicHash::Sha1);
+}
+
+void AmdaProductIndex::write(QDataStream& stream) const
+{
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << INDEX_MAGIC << FORMAT_VERSION << m_SourceHash << m_Strings
+           << static_cast<quint32>(m_Nodes.size());
+    for (const auto& node : m_Nodes)
+    {
+        stream << node.m_Type << node.m_Parent << node.m_FirstChild << node.m_NextSibling
+               << node.m_ChildCount << node.m_FirstProperty << node.m_PropertyCount;
+    }
+
+    stream << static_cast<quint32>(m_Properties.size());
+    for (const auto& property : m_Properties)
+    {
+        stream << property.m_Key << property.m_Value << static_cast<quint8>(property.m_Kind)
+               << property.m_Append;
+    }
+}
+
+int AmdaProductIndex::parent(int node) const noexcept
+{
+    return node >= 0 && node < size() ? m_Nodes[node].m_Parent : NO_NODE;
+}
+
+int AmdaProductIndex::childCount(int node) const noexcept
+{
+    return node >= 0 && node < size() ? m_Nodes[node].m_ChildCount : 0;
+}
+
+std::vector<int> AmdaProductIndex::children(int node) const
+{
+    auto result = std::vector<int> {};
+    if (node >= 0 && node < size())
+    {
+        result.reserve(m_Nodes[node].m_ChildCount);
+        for (auto child = m_Nodes[node].m_FirstChild; child != NO_NODE;
+             child = m_Nodes[child].m_NextSibling)
+        {
+            result.push_back(child);
+        }
+    }
+    return result;
+}
+
+QVariant AmdaProductIndex::value(int node, const QString& key) const
+{
+    auto result = QVariant {};
+    if (node < 0 || node >= size())
+    {
+        return result;
+    }
+
+    const auto& indexNode = m_Nodes[node];
+    auto first = m_Properties.cbegin() + indexNode.m_FirstProperty;
+    for (auto it = first, end = first + indexNode.m_PropertyCount; it != end; ++it)
+    {
+        if (m_Strings[it->m_Key] == key)
+        {
+            if (it->m_Append)
+            {
+                auto values = result.isValid() ? result.toList() : QVariantList {};
+                values.append(variant(*it));
+                result = values;
+            }
+            else
+            {
+                result = variant(*it);
+            }
+        }
+    }
+    return result;
+}
+
+std::unique_ptr<DataSourceItem> AmdaProductIndex::createItem(int node) const
+{
+    if (node < 0 || node >= size())
+    {
+        return nullptr;
+    }
+
+    const auto& indexNode = m_Nodes[node];
+    auto item = std::make_unique<DataSourceItem>(static_cast<DataSourceItemType>(indexNode.m_Type));
+    auto first = m_Properties.cbegin() + indexNode.m_FirstProperty;
+    for (auto it = first, end = first + indexNode.m_PropertyCount; it != end; ++it)
+    {
+        item->setData(m_Strings[it->m_Key], variant(*it), it->m_Append);
+    }
+    return item;
+}
+
+std::vector<int> AmdaProductIndex::find(
+    const std::function<bool(const QVariant& value)>& filter) const
+{
+    // Values are mostly strings shared by many nodes, so the filter is applied once per string
+    enum class Match : qint8
+    {
+        UNKNOWN,
+        NO,
+        YES
+    };
+    auto stringMatches = std::vector<Match>(m_Strings.size(), Match::UNKNOWN);
+    auto matches = [&](const Property& property) {
+        if (property.m_Kind != ValueKind::STRING)
+        {
+            return filter(variant(property));
+        }
+        auto& match = stringMatches[property.m_Value];
+        if (match == Match::UNKNOWN)
+        {
+            match = filter(variant(property)) ? Match::YES : Match::NO;
+        }
+        return match == Match::YES;
+    };
+
+    auto result = std::vector<int> {};
+    for (auto node = 0; node < size(); ++node)
+    {
+        auto first = m_Properties.cbegin() + m_Nodes[node].m_FirstProperty;
+        if (std::any_of(first, first + m_Nodes[node].m_PropertyCount, matches))
+        {
+            result.push_back(node);
+        }
+    }
+    return result;
+}
+
+QVariant AmdaProductIndex::variant(const Property& property) const
+{
+    const auto& text = m_Strings[property.m_Value];
+    switch (property.m_Kind)
+    {
+        case ValueKind::STRING:
+            return text;
+        case ValueKind::NUMBER:
+            return text.toDouble();
+        case ValueKind::BOOL:
+            return text == QLatin1String { "true" };
+        case ValueKind::NULL_VALUE:
+            return QVariant {};
+    }
+    return QVariant {};
+}
@@ -0,0 +1,189 @@
+#include "AmdaProductLoader.h"
+#include "AmdaDefs.h"
+#include "AmdaProductIndex.h"
+#include "AmdaServer.h"
+
+#include <DataSource/DataSourceController.h>
+#include <DataSource/DataSourceItem.h>
+#include <DataSource/DataSourceItemAction.h>
+
+#include <SqpApplication.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+const QString AmdaProductLoader::NAME = QStringLiteral("AmdaProductLoader");
+
+namespace
+{
+
+/// @return the sampling of a node, which is the one of its closest ancestor having one
+QVariant sampling(const AmdaProductIndex& index, int node)
+{
+    for (; node != AmdaProductIndex::NO_NODE; node = index.parent(node))
+    {
+        auto value = index.value(node, AMDA_SAMPLING_KEY);
+        if (value.isValid())
+        {
+            return value;
+        }
+    }
+    return QVariant {};
+}
+
+} // namespace
+
+AmdaProductLoader::AmdaProductLoader(
+    std::shared_ptr<AmdaProductIndex> index, const QUuid& dataSourceUid)
+        : m_Index { std::move(index) }, m_DataSourceUid { dataSourceUid }
+{
+}
+
+std::unique_ptr<DataSourceItem> AmdaProductLoader::createRootItem() const
+{
+    return createItem(m_Index->root());
+}
+
+bool AmdaProductLoader::canLoadChildren(const DataSourceItem& item) const
+{
+    auto itemNode = node(item);
+    return itemNode != AmdaProductIndex::NO_NODE
+        && item.childCount() < m_Index->childCount(itemNode);
+}
+
+void AmdaProductLoader::loadChildren(DataSourceItem& item)
+{
+    auto itemNode = node(item);
+    if (itemNode == AmdaProductIndex::NO_NODE)
+    {
+        return;
+    }
+
+    // Some children may have been created when searching items
+    auto createdNodes = std::unordered_set<int> {};
+    for (auto i = 0, count = item.childCount(); i < count; ++i)
+    {
+        createdNodes.insert(node(*item.child(i)));
+    }
+
+    for (auto child : m_Index->children(itemNode))
+    {
+        if (createdNodes.find(child) == createdNodes.cend())
+        {
+            item.appendChild(createItem(child));
+        }
+    }
+}
+
+void AmdaProductLoader::loadMatchingItems(
+    DataSourceItem& item, const FilterFunction& filter, int maxCount)
+{
+    auto itemNode = node(item);
+    if (itemNode == AmdaProductIndex::NO_NODE)
+    {
+        return;
+    }
+
+    // Items of the nodes, filled with the children of an item the first time one of them is needed
+    auto items = std::unordered_map<int, DataSourceItem*> { { itemNode, &item } };
+    auto listedItems = std::unordered_set<const DataSourceItem*> {};
+    auto findOrCreateItem = [&](int node, const auto& findOrCreateParent) -> DataSourceItem* {
+        auto it = items.find(node);
+        if (it != items.cend())
+        {
+            return it->second;
+        }
+
+        auto parentNode = m_Index->parent(node);
+        if (parentNode == AmdaProductIndex::NO_NODE)
+        {
+            // The node isn't a descendant of the item
+            return nullptr;
+        }
+        auto parentItem = findOrCreateParent(parentNode, findOrCreateParent);
+        if (!parentItem)
+        {
+            return nullptr;
+        }
+
+        if (listedItems.insert(parentItem).second)
+        {
+            for (auto i = 0, count = parentItem->childCount(); i < count; ++i)
+            {
+                auto child = parentItem->child(i);
+                items.emplace(this->node(*child), child);
+            }
+            it = items.find(node);
+            if (it != items.cend())
+            {
+                return it->second;
+            }
+        }
+
+        parentItem->appendChild(createItem(node));
+        auto child = parentItem->child(parentItem->childCount() - 1);
+        items.emplace(node, child);
+        return child;
+    };
+
+    auto matchCount = 0;
+    for (auto matchingNode : m_Index->find(filter))
+    {
+        if (matchCount >= maxCount)
+        {
+            break;
+        }
+        if (findOrCreateItem(matchingNode, findOrCreateItem))
+        {
+            ++matchCount;
+        }
+    }
+}
+
+int AmdaProductLoader::node(const DataSourceItem& item) const noexcept
+{
+    if (item.data(LOADER_DATA_KEY).toString() != NAME)
+    {
+        return AmdaProductIndex::NO_NODE;
+    }
+
+    auto ok = false;
+    auto result = item.data(NODE_DATA_KEY).toInt(&ok);
+    return ok && result >= 0 && result < m_Index->size() ? result : AmdaProductIndex::NO_NODE;
+}
+
+std::unique_ptr<DataSourceItem> AmdaProductLoader::createItem(int node) const
+{
+    auto item = m_Index->createItem(node);
+    item->setData(LOADER_DATA_KEY, NAME);
+    item->setData(NODE_DATA_KEY, node);
+
+    const auto itemType = item->type();
+    if (itemType == DataSourceItemType::PRODUCT || itemType == DataSourceItemType::COMPONENT)
+    {
+        // Adds plugin name to item metadata
+        item->setData(DataSourceItem::PLUGIN_DATA_KEY, AmdaServer::instance().name());
+
+        // Adds load action
+        auto actionLabel = QObject::tr(
+            itemType == DataSourceItemType::PRODUCT ? "Load %1 product" : "Load %1 component");
+        item->addAction(std::make_unique<DataSourceItemAction>(actionLabel.arg(item->name()),
+            [dataSourceUid = m_DataSourceUid](DataSourceItem& item) {
+                if (auto app = sqpApp)
+                {
+                    app->dataSourceController().loadProductItem(dataSourceUid, item);
+                }
+            }));
+        item->setData(DataSourceItem::ID_DATA_KEY, item->data(AMDA_XML_ID_KEY));
+
+        // Sampling of datasets is passed down to their products and components, as it is used by
+        // the provider to split the requests
+        auto itemSampling = sampling(*m_Index, node);
+        if (itemSampling.isValid())
+        {
+            item->setData(AMDA_SAMPLING_KEY, itemSampling);
+        }
+    }
+
+    return item;
+}
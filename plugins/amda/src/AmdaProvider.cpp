@@ -1,19 +1,24 @@
 #include "AmdaProvider.h"
+#include "AmdaDataDownloader.h"
 #include "AmdaDefs.h"
 #include "AmdaResultParser.h"
+#include "AmdaResultStreamParser.h"
 #include "AmdaServer.h"
 
 #include <Common/DateUtils.h>
 #include <Data/DataProviderParameters.h>
-#include <Network/NetworkController.h>
-#include <SqpApplication.h>
 
-#include <Network/Downloader.h>
 #include <QJsonDocument>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QTemporaryFile>
-#include <QThread>
+#include <QRegularExpression>
+#include <QSettings>
+#include <QThreadPool>
+#include <QUrl>
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <optional>
 
 Q_LOGGING_CATEGORY(LOG_AmdaProvider, "AmdaProvider")
 
@@ -25,22 +30,39 @@ namespace
 /// - %2: start date
 /// - %3: end date
 /// - %4: parameter id
+/// - %5: time format (ISO8601 or UNIXTIME)
 /// AMDA V2: http://amdatest.irap.omp.eu/php/rest/
 const auto AMDA_URL_FORMAT = QStringLiteral(
     "http://%1/php/rest/"
     "getParameter.php?startTime=%2&stopTime=%3&parameterID=%4&outputFormat=ASCII&"
-    "timeFormat=ISO8601&gzip=0");
+    "timeFormat=%5&gzip=1");
 
 const auto AMDA_URL_FORMAT_WITH_TOKEN = QStringLiteral(
     "http://%1/php/rest/"
     "getParameter.php?startTime=%2&stopTime=%3&parameterID=%4&outputFormat=ASCII&"
-    "timeFormat=ISO8601&gzip=0&"
-    "token=%5");
+    "timeFormat=%5&gzip=1&"
+    "token=%6");
 
 const auto AMDA_TOKEN_URL_FORMAT = QStringLiteral(
     "http://%1/php/rest/"
     "auth.php");
 
+/// Number of bytes of the data file read at once while it is downloaded. It bounds the memory used
+/// by the bytes of the file
+const auto DATA_FILE_CHUNK_SIZE = std::size_t { 1024 * 1024 };
+
+/// Maximum number of requests to AMDA in flight at once
+const auto MAX_CONCURRENT_REQUESTS = 4;
+
+/// Number of samples requested at once. The duration of the requests is the one of this number of
+/// samples, rounded up to a multiple of the minimum duration. It only sets where a range is split:
+/// the requests of the bounds of the range don't extend beyond it
+const auto SAMPLES_PER_REQUEST = 100000.;
+const auto MIN_REQUEST_DURATION = 3600.;
+
+/// Duration of the requests for a product whose sampling is unknown
+const auto DEFAULT_REQUEST_DURATION = 86400.;
+
 /// Dates format passed in the URL (e.g 2013-09-23T09:00)
 const auto AMDA_TIME_FORMAT = QStringLiteral("yyyy-MM-ddThh:mm:ss");
 
@@ -51,15 +73,170 @@ QString dateFormat(double sqpRange) noexcept
     return dateTime.toString(AMDA_TIME_FORMAT);
 }
 
+/// Appends results to others. Samples that don't follow the last sample of the results (samples
+/// at the boundary of two ranges, returned by the requests of both ranges) are skipped
+void appendResults(AmdaResults& results, const AmdaResults& otherResults)
+{
+    // Bands and samplings of a spectrogram are the same for all the results
+    if (results.m_YAxisData.empty())
+    {
+        results.m_YAxisData = otherResults.m_YAxisData;
+        results.m_MinSampling = otherResults.m_MinSampling;
+        results.m_MaxSampling = otherResults.m_MaxSampling;
+    }
+
+    const auto& otherXAxisData = otherResults.m_XAxisData;
+    if (otherXAxisData.empty())
+    {
+        return;
+    }
+
+    auto valuesPerSample = otherResults.m_ValuesData.size() / otherXAxisData.size();
+    auto first = results.m_XAxisData.empty()
+        ? otherXAxisData.cbegin()
+        : std::upper_bound(
+            otherXAxisData.cbegin(), otherXAxisData.cend(), results.m_XAxisData.back());
+    auto firstIndex = static_cast<std::size_t>(first - otherXAxisData.cbegin());
+
+    results.m_XAxisData.insert(results.m_XAxisData.end(), first, otherXAxisData.cend());
+    results.m_ValuesData.insert(results.m_ValuesData.end(),
+        otherResults.m_ValuesData.cbegin() + firstIndex * valuesPerSample,
+        otherResults.m_ValuesData.cend());
+}
+
+/// Removes the samples of results that are outside a range. The range is inclusive, as the data
+/// files of AMDA contain the samples at the bounds of the requests
+void trimResults(AmdaResults& results, const DateTimeRange& range)
+{
+    auto& xAxisData = results.m_XAxisData;
+    if (xAxisData.empty())
+    {
+        return;
+    }
+
+    auto valuesPerSample = results.m_ValuesData.size() / xAxisData.size();
+    auto first = std::lower_bound(xAxisData.cbegin(), xAxisData.cend(), range.m_TStart);
+    auto last = std::upper_bound(first, xAxisData.cend(), range.m_TEnd);
+    auto firstIndex = static_cast<std::size_t>(first - xAxisData.cbegin());
+    auto lastIndex = static_cast<std::size_t>(last - xAxisData.cbegin());
+
+    results.m_ValuesData.erase(
+        results.m_ValuesData.cbegin() + lastIndex * valuesPerSample, results.m_ValuesData.cend());
+    results.m_ValuesData.erase(results.m_ValuesData.cbegin(),
+        results.m_ValuesData.cbegin() + firstIndex * valuesPerSample);
+    xAxisData.erase(last, xAxisData.cend());
+    xAxisData.erase(xAxisData.cbegin(), xAxisData.cbegin() + firstIndex);
+}
+
+/// Returns the duration of the data requested at once for a product, in seconds
+double requestDuration(const QVariant& sampling) noexcept
+{
+    // Sampling in the tree is a duration followed by its unit (e.g. 4S, 1.92S, 20M, 1H)
+    static const auto SAMPLING_REGEX
+        = QRegularExpression { QStringLiteral("^\\s*(\\d+(?:\\.\\d+)?)\\s*([SMHD])\\s*$") };
+    static const auto UNIT_DURATIONS
+        = std::map<QString, double> { { "S", 1. }, { "M", 60. }, { "H", 3600. }, { "D", 86400. } };
+
+    auto match = SAMPLING_REGEX.match(sampling.toString().toUpper());
+    if (!match.hasMatch())
+    {
+        return DEFAULT_REQUEST_DURATION;
+    }
+
+    auto samplingDuration = match.captured(1).toDouble() * UNIT_DURATIONS.at(match.captured(2));
+    return std::max(
+        std::ceil(samplingDuration * SAMPLES_PER_REQUEST / MIN_REQUEST_DURATION)
+            * MIN_REQUEST_DURATION,
+        MIN_REQUEST_DURATION);
+}
+
+/// Returns the time format of the data files requested for a product: the one of the product if
+/// it has one, the one of the settings otherwise
+QString dataFileTimeFormat(const QVariant& productTimeFormat)
+{
+    auto result = productTimeFormat.isValid()
+        ? productTimeFormat.toString()
+        : QSettings {}
+              .value(AMDA_TIME_FORMAT_SETTINGS_KEY, AMDA_TIME_FORMAT_DEFAULT_VALUE)
+              .toString();
+
+    if (result != AMDA_TIME_FORMAT_ISO8601 && result != AMDA_TIME_FORMAT_UNIXTIME)
+    {
+        qCWarning(LOG_AmdaProvider())
+            << QObject::tr("Unknown AMDA time format %1: %2 is used instead")
+                   .arg(result, AMDA_TIME_FORMAT_DEFAULT_VALUE);
+        return AMDA_TIME_FORMAT_DEFAULT_VALUE;
+    }
+    return result;
+}
+
+/// Splits a range in ranges whose bounds inside the range are aligned on multiples of a duration
+/// (since epoch), so that the same requests are sent for the inside of overlapping ranges. The
+/// first and last ranges are clamped to the range, so that nothing outside of it is requested
+std::vector<DateTimeRange> splitRange(const DateTimeRange& range, double duration)
+{
+    auto result = std::vector<DateTimeRange> {};
+    auto start = range.m_TStart;
+    for (auto i = std::floor(range.m_TStart / duration) + 1.; i * duration < range.m_TEnd; ++i)
+    {
+        result.push_back({ start, i * duration });
+        start = i * duration;
+    }
+    result.push_back({ start, range.m_TEnd });
+    return result;
+}
+
+/// Pool running the requests to AMDA. It is shared by all the providers, so that the number of
+/// requests in flight is bounded for the whole application
+QThreadPool& requestThreadPool()
+{
+    static auto pool = []() {
+        auto pool = std::make_unique<QThreadPool>();
+        pool->setMaxThreadCount(MAX_CONCURRENT_REQUESTS);
+        return pool;
+    }();
+    return *pool;
+}
+
+/**
+ * Fetches the data of a product on a range: asks AMDA to generate the data file, then reads it
+ * while it is downloaded, so that only the bytes of the part being read are kept in memory
+ * @return the values read, nothing if the data couldn't be fetched
+ */
+std::optional<AmdaResults> fetchData(const QString& serverUrl, const QString& token,
+    const QString& productId, DataSeriesType productValueType, const QString& timeFormat,
+    const DateTimeRange& range)
+{
+    auto url = QString { AMDA_URL_FORMAT_WITH_TOKEN }.arg(serverUrl, dateFormat(range.m_TStart),
+        dateFormat(range.m_TEnd), productId, timeFormat, token);
+    auto response = AmdaDataDownloader::download(QUrl { url });
+    if (!response)
+    {
+        return std::nullopt;
+    }
+    auto dataFileUrl = QJsonDocument::fromJson(*response)["dataFileURLs"].toString();
+
+    // The data file is decompressed and read while it is downloaded
+    auto results = AmdaResults {};
+    AmdaResultStreamParser parser { productValueType, DATA_FILE_CHUNK_SIZE,
+        [&results](AmdaResults partialResults) { appendResults(results, partialResults); } };
+
+    if (!AmdaDataDownloader::downloadAndRead(
+            QUrl { dataFileUrl }, parser, DATA_FILE_CHUNK_SIZE))
+    {
+        return std::nullopt;
+    }
+    return results;
+}
 
 } // namespace
 
-AmdaProvider::AmdaProvider() {}
+AmdaProvider::AmdaProvider(const QString& serverUrl) : m_ServerUrl { serverUrl } {}
 
 std::shared_ptr<IDataProvider> AmdaProvider::clone() const
 {
     // No copy is made in the clone
-    return std::make_shared<AmdaProvider>();
+    return std::make_shared<AmdaProvider>(m_ServerUrl);
 }
 
 TimeSeries::ITimeSerie* AmdaProvider::getData(const DataProviderParameters& parameters)
@@ -69,17 +246,67 @@ TimeSeries::ITimeSerie* AmdaProvider::getData(const DataProviderParameters& para
     auto productId = metaData.value(AMDA_XML_ID_KEY).toString();
     auto productValueType
         = DataSeriesTypeUtils::fromString(metaData.value(AMDA_DATA_TYPE_KEY).toString());
-    auto startDate = dateFormat(range.m_TStart);
-    auto endDate = dateFormat(range.m_TEnd);
     QVariantHash urlProperties { { AMDA_SERVER_KEY, metaData.value(AMDA_SERVER_KEY) } };
-    auto token_url
-        = QString { AMDA_TOKEN_URL_FORMAT }.arg(AmdaServer::instance().url(urlProperties));
-    auto response = Downloader::get(token_url);
-    auto url = QString { AMDA_URL_FORMAT_WITH_TOKEN }.arg(AmdaServer::instance().url(urlProperties),
-        startDate, endDate, productId, QString(response.data()));
-    response = Downloader::get(url);
-    auto test = QJsonDocument::fromJson(response.data());
-    url = test["dataFileURLs"].toString();
-    response = Downloader::get(url);
-    return nullptr; // AmdaResultParser::readTxt(QTextStream { response.data() }, productValueType);
+    auto serverUrl
+        = m_ServerUrl.isEmpty() ? AmdaServer::instance().url(urlProperties) : m_ServerUrl;
+
+    auto token = AmdaDataDownloader::download(
+        QUrl { QString { AMDA_TOKEN_URL_FORMAT }.arg(serverUrl) });
+    if (!token)
+    {
+        return nullptr;
+    }
+
+    auto fetchRange = [serverUrl, token = QString::fromUtf8(*token), productId, productValueType,
+                          timeFormat = dataFileTimeFormat(metaData.value(AMDA_TIME_FORMAT_KEY))](
+                          const DateTimeRange& subRange) {
+        return fetchData(serverUrl, token, productId, productValueType, timeFormat, subRange);
+    };
+
+    // The range is split in ranges sized by the sampling of the product, which are fetched
+    // concurrently. Their values are then stitched in time order and trimmed to the range
+    auto subRanges = splitRange(range, requestDuration(metaData.value(AMDA_SAMPLING_KEY)));
+    auto futures = std::vector<QFuture<std::optional<AmdaResults>>> {};
+    if (subRanges.size() > 1)
+    {
+        for (const auto& subRange : subRanges)
+        {
+            futures.push_back(QtConcurrent::run(&requestThreadPool(), fetchRange, subRange));
+        }
+    }
+
+    // No data is returned if a range can't be fetched: data with a hole would be taken as the
+    // data of the whole range, and cached as such
+    auto results = AmdaResults {};
+    auto failed = false;
+    for (auto i = std::size_t { 0 }; i < subRanges.size(); ++i)
+    {
+        auto subResults = futures.empty() ? fetchRange(subRanges[i]) : futures[i].result();
+        if (!subResults)
+        {
+            qCWarning(LOG_AmdaProvider())
+                << QObject::tr("Can't fetch AMDA data of product %1 from %2 to %3")
+                       .arg(productId, dateFormat(subRanges[i].m_TStart),
+                           dateFormat(subRanges[i].m_TEnd));
+            failed = true;
+        }
+        else if (!failed)
+        {
+            appendResults(results, *subResults);
+        }
+    }
+
+    if (failed)
+    {
+        return nullptr;
+    }
+    trimResults(results, range);
+
+    auto data = createTimeSerie(productValueType, std::move(results));
+    if (!data)
+    {
+        qCWarning(LOG_AmdaProvider())
+            << QObject::tr("Can't create AMDA data of product %1: unsupported type").arg(productId);
+    }
+    return data;
 }
@@ -11,39 +11,16 @@ const QString X_AXIS_UNIT_PROPERTY = QStringLiteral("xAxisUnit");
 const QString Y_AXIS_UNIT_PROPERTY = QStringLiteral("yAxisUnit");
 const QString VALUES_UNIT_PROPERTY = QStringLiteral("valuesUnit");
 
-namespace {
-
-const auto PARAMETER_UNITS_REGEX
-    = QRegularExpression{QStringLiteral("\\s*PARAMETER_UNITS\\s*:\\s*(.*)")};
-}
-
 const QRegularExpression DEFAULT_X_AXIS_UNIT_REGEX
     = QRegularExpression{QStringLiteral("-\\s*Units\\s*:\\s*(.+?)\\s*-")};
 
-const QRegularExpression ALTERNATIVE_X_AXIS_UNIT_REGEX = PARAMETER_UNITS_REGEX;
-
-const QRegularExpression SPECTROGRAM_END_TIME_REGEX
-    = QRegularExpression{QStringLiteral("\\s*INTERVAL_STOP\\s*:\\s*(.*)")};
-
-const QRegularExpression SPECTROGRAM_FILL_VALUE_REGEX
-    = QRegularExpression{QStringLiteral("\\s*PARAMETER_FILL_VALUE\\s*:\\s*(.*)")};
-
-const QRegularExpression SPECTROGRAM_MAX_BANDS_REGEX
-    = QRegularExpression{QStringLiteral("\\s*PARAMETER_TABLE_MAX_VALUES\\[0\\]\\s*:\\s*(.*)")};
-
-const QRegularExpression SPECTROGRAM_MIN_BANDS_REGEX
-    = QRegularExpression{QStringLiteral("\\s*PARAMETER_TABLE_MIN_VALUES\\[0\\]\\s*:\\s*(.*)")};
-
-const QRegularExpression SPECTROGRAM_MAX_SAMPLING_REGEX
-    = QRegularExpression{QStringLiteral("\\s*DATASET_MAX_SAMPLING\\s*:\\s*(.*)")};
-
-const QRegularExpression SPECTROGRAM_MIN_SAMPLING_REGEX
-    = QRegularExpression{QStringLiteral("\\s*DATASET_MIN_SAMPLING\\s*:\\s*(.*)")};
-
-const QRegularExpression SPECTROGRAM_START_TIME_REGEX
-    = QRegularExpression{QStringLiteral("\\s*INTERVAL_START\\s*:\\s*(.*)")};
-
-const QRegularExpression SPECTROGRAM_Y_AXIS_UNIT_REGEX
-    = QRegularExpression{QStringLiteral("\\s*PARAMETER_TABLE_UNITS\\[0\\]\\s*:\\s*(.*)")};
-
-const QRegularExpression SPECTROGRAM_VALUES_UNIT_REGEX = PARAMETER_UNITS_REGEX;
+const QString X_AXIS_UNIT_KEYWORD = QStringLiteral("PARAMETER_UNITS");
+const QString SPECTROGRAM_END_TIME_KEYWORD = QStringLiteral("INTERVAL_STOP");
+const QString SPECTROGRAM_FILL_VALUE_KEYWORD = QStringLiteral("PARAMETER_FILL_VALUE");
+const QString SPECTROGRAM_MAX_BANDS_KEYWORD = QStringLiteral("PARAMETER_TABLE_MAX_VALUES[0]");
+const QString SPECTROGRAM_MIN_BANDS_KEYWORD = QStringLiteral("PARAMETER_TABLE_MIN_VALUES[0]");
+const QString SPECTROGRAM_MAX_SAMPLING_KEYWORD = QStringLiteral("DATASET_MAX_SAMPLING");
+const QString SPECTROGRAM_MIN_SAMPLING_KEYWORD = QStringLiteral("DATASET_MIN_SAMPLING");
+const QString SPECTROGRAM_START_TIME_KEYWORD = QStringLiteral("INTERVAL_START");
+const QString SPECTROGRAM_Y_AXIS_UNIT_KEYWORD = QStringLiteral("PARAMETER_TABLE_UNITS[0]");
+const QString SPECTROGRAM_VALUES_UNIT_KEYWORD = X_AXIS_UNIT_KEYWORD;
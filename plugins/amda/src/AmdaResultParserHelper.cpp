@@ -1,18 +1,23 @@
 #include "AmdaResultParserHelper.h"
 
 #include <Common/DateUtils.h>
-#include <Common/SortUtils.h>
 
-#include <Data/DataSeriesUtils.h>
-#include <Data/ScalarSeries.h>
-#include <Data/SpectrogramSeries.h>
-#include <Data/Unit.h>
-#include <Data/VectorSeries.h>
+#include <Data/ScalarTimeSerie.h>
+#include <Data/SpectrogramTimeSerie.h>
+#include <Data/VectorTimeSerie.h>
 
+#include <QtCore/QByteArray>
 #include <QtCore/QDateTime>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QThread>
+#include <QtConcurrent/QtConcurrent>
 
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <numeric>
 
 Q_LOGGING_CATEGORY(LOG_AmdaResultParserHelper, "AmdaResultParserHelper")
 
@@ -22,8 +27,8 @@ namespace {
 // Constants //
 // ///////// //
 
-/// Separator between values in a result line
-const auto RESULT_LINE_SEPARATOR = QRegularExpression{QStringLiteral("\\s+")};
+/// Minimum size of the data section, in bytes, handled by each thread when reading results
+const auto MIN_CHUNK_SIZE = std::ptrdiff_t{4 * 1024 * 1024};
 
 /// Format for dates in result files
 const auto DATE_FORMAT = QStringLiteral("yyyy-MM-ddThh:mm:ss.zzz");
@@ -32,22 +37,48 @@ const auto DATE_FORMAT = QStringLiteral("yyyy-MM-ddThh:mm:ss.zzz");
 // Methods //
 // /////// //
 
-/**
- * Checks that the properties contain a specific unit and that this unit is valid
- * @param properties the properties map in which to search unit
- * @param key the key to search for the unit in the properties
- * @param errorMessage the error message to log in case the unit is invalid
- * @return true if the unit is valid, false it it's invalid or was not found in the properties
- */
-bool checkUnit(const Properties &properties, const QString &key, const QString &errorMessage)
+/// @return the double property of a key, NaN if the properties don't contain it
+double doubleProperty(const Properties &properties, const QString &key)
 {
-    auto unit = properties.value(key).value<Unit>();
-    if (unit.m_Name.isEmpty()) {
-        qCWarning(LOG_AmdaResultParserHelper()) << errorMessage;
-        return false;
-    }
+    auto value = properties.value(key);
+    return value.isValid() ? value.value<double>() : std::numeric_limits<double>::quiet_NaN();
+}
 
-    return true;
+/// Creates a serie of scalars from the times and the values read
+ScalarTimeSerie *createScalarSerie(const std::vector<double> &xAxisData,
+                                   const std::vector<double> &valuesData)
+{
+    auto serie = new ScalarTimeSerie(xAxisData.size());
+    std::generate(std::begin(*serie), std::end(*serie), [&, i = std::size_t{0}]() mutable {
+        auto sample = std::pair<double, double>{xAxisData[i], valuesData[i]};
+        ++i;
+        return sample;
+    });
+    return serie;
+}
+
+/// Creates a serie of vectors from the times and the values read, three components per time
+VectorTimeSerie *createVectorSerie(const std::vector<double> &xAxisData,
+                                   const std::vector<double> &valuesData)
+{
+    auto serie = new VectorTimeSerie(xAxisData.size());
+    std::generate(std::begin(*serie), std::end(*serie), [&, i = std::size_t{0}]() mutable {
+        auto sample = std::pair<double, VectorTimeSerie::raw_value_type>{
+            xAxisData[i], {valuesData[3 * i], valuesData[3 * i + 1], valuesData[3 * i + 2]}};
+        ++i;
+        return sample;
+    });
+    return serie;
+}
+
+/// @return the permutation that sorts values in ascending order, equal values keeping their order
+std::vector<int> sortPermutation(const std::vector<double> &values)
+{
+    auto result = std::vector<int>(values.size());
+    std::iota(result.begin(), result.end(), 0);
+    std::stable_sort(result.begin(), result.end(),
+                     [&values](int lhs, int rhs) { return values[lhs] < values[rhs]; });
+    return result;
 }
 
 QDateTime dateTimeFromString(const QString &stringDate) noexcept
@@ -70,11 +101,183 @@ double doubleDate(const QString &stringDate) noexcept
                               : std::numeric_limits<double>::quiet_NaN();
 }
 
+/// Checks if a character separates two columns of a result line
+inline bool isSeparator(char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/// Reads @p count digits from @p it, and advances it
+/// @return false if there are less than @p count digits
+inline bool readDigits(const char *&it, const char *end, int count, int &value) noexcept
+{
+    if (end - it < count) {
+        return false;
+    }
+
+    value = 0;
+    for (auto i = 0; i < count; ++i, ++it) {
+        if (*it < '0' || *it > '9') {
+            return false;
+        }
+        value = value * 10 + (*it - '0');
+    }
+    return true;
+}
+
+/// Reads the character @p c from @p it, and advances it
+/// @return false if @p it doesn't point to @p c
+inline bool readChar(const char *&it, const char *end, char c) noexcept
+{
+    if (it == end || *it != c) {
+        return false;
+    }
+    ++it;
+    return true;
+}
+
+constexpr bool isLeapYear(int year) noexcept
+{
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+int daysInMonth(int year, int month) noexcept
+{
+    static const int DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : DAYS_IN_MONTH[month - 1];
+}
+
+/// Returns the number of days between 1970-01-01 and a date of the gregorian calendar
+/// @sa http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+constexpr std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) noexcept
+{
+    year -= month <= 2;
+    const auto era = (year >= 0 ? year : year - 399) / 400;
+    const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+    const auto dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+}
+
+/**
+ * Converts an ISO 8601 date to a double date, without going through QDateTime.
+ * Format: yyyy-MM-ddThh:mm:ss[.z...][Z|(+|-)hh[:]mm]
+ * @return the date in seconds since epoch, NaN if the date can't be converted
+ */
+double doubleDate(const char *begin, const char *end) noexcept
+{
+    const auto invalid = std::numeric_limits<double>::quiet_NaN();
+
+    auto it = begin;
+    int year, month, day, hours, minutes, seconds;
+    if (!readDigits(it, end, 4, year) || !readChar(it, end, '-') || !readDigits(it, end, 2, month)
+        || !readChar(it, end, '-') || !readDigits(it, end, 2, day) || !readChar(it, end, 'T')
+        || !readDigits(it, end, 2, hours) || !readChar(it, end, ':')
+        || !readDigits(it, end, 2, minutes) || !readChar(it, end, ':')
+        || !readDigits(it, end, 2, seconds)) {
+        return invalid;
+    }
+
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || hours > 23
+        || minutes > 59 || seconds > 59) {
+        return invalid;
+    }
+
+    // Milliseconds are kept as an integer as QDateTime does, so that dates are converted to the
+    // same doubles. Digits beyond are added as a fraction of millisecond
+    auto milliseconds = std::int64_t{0};
+    auto subMilliseconds = 0.;
+    if (readChar(it, end, '.')) {
+        auto digitCount = 0;
+        auto scale = 1.;
+        for (; it != end && *it >= '0' && *it <= '9'; ++it, ++digitCount) {
+            if (digitCount < 3) {
+                milliseconds = milliseconds * 10 + (*it - '0');
+            }
+            else {
+                scale /= 10.;
+                subMilliseconds += (*it - '0') * scale;
+            }
+        }
+        if (digitCount == 0) {
+            return invalid;
+        }
+        for (; digitCount < 3; ++digitCount) {
+            milliseconds *= 10;
+        }
+    }
+
+    auto offset = 0;
+    if (it != end && (*it == '+' || *it == '-')) {
+        auto sign = *it++ == '+' ? 1 : -1;
+        int offsetHours, offsetMinutes;
+        if (!readDigits(it, end, 2, offsetHours)) {
+            return invalid;
+        }
+        readChar(it, end, ':');
+        if (!readDigits(it, end, 2, offsetMinutes)) {
+            return invalid;
+        }
+        offset = sign * (offsetHours * 3600 + offsetMinutes * 60);
+    }
+    else {
+        readChar(it, end, 'Z');
+    }
+
+    if (it != end) {
+        return invalid;
+    }
+
+    auto secondsSinceEpoch = daysFromCivil(year, month, day) * 86400 + hours * 3600 + minutes * 60
+                             + seconds - offset;
+    return (secondsSinceEpoch * 1000 + milliseconds + subMilliseconds) / 1000.;
+}
+
+/**
+ * Converts a column of a result line to a double, independently of the locale
+ * @return true if the whole column could be converted
+ */
+bool readDouble(const char *begin, const char *end, double &value) noexcept
+{
+    // std::from_chars doesn't accept explicit positive sign
+    if (begin != end && *begin == '+') {
+        ++begin;
+    }
+
+#if defined(__cpp_lib_to_chars)
+    auto result = std::from_chars(begin, end, value);
+    return result.ec == std::errc{} && result.ptr == end;
+#else
+    // Conversion of doubles by std::from_chars is not supported by the standard library
+    bool ok;
+    value = QByteArray::fromRawData(begin, static_cast<int>(end - begin)).toDouble(&ok);
+    return ok;
+#endif
+}
+
+/**
+ * Converts the time column of a result line to a double date. AMDA writes times either as ISO 8601
+ * dates or as seconds since epoch (UNIXTIME format), the latter being read without any calendar
+ * computation
+ * @return the date in seconds since epoch, NaN if the time can't be converted
+ */
+inline double readTime(const char *begin, const char *end) noexcept
+{
+    // An ISO 8601 date is the only format with a '-' after its four first characters
+    if (end - begin > 4 && begin[4] == '-') {
+        return doubleDate(begin, end);
+    }
+
+    double value;
+    return readDouble(begin, end, value) ? value : std::numeric_limits<double>::quiet_NaN();
+}
+
 /**
  * Reads a line from the AMDA file and tries to extract a x-axis data and value data from it
  * @param xAxisData the vector in which to store the x-axis data extracted
  * @param valuesData the vector in which to store the value extracted
- * @param line the line to read to extract the property
+ * @param begin the beginning of the line to read, without its end of line
+ * @param end the end of the line to read
  * @param valuesIndexes indexes of insertion of read values. For example, if the line contains three
  * columns of values, and valuesIndexes are {2, 0, 1}, the value of the third column will be read
  * and inserted first, then the value of the first column, and finally the value of the second
@@ -83,15 +286,26 @@ double doubleDate(const QString &stringDate) noexcept
  * value is -1, then this value is considered as invalid and converted to NaN
  */
 void tryReadResult(std::vector<double> &xAxisData, std::vector<double> &valuesData,
-                   const QString &line, const std::vector<int> &valuesIndexes,
-                   double fillValue = std::numeric_limits<double>::quiet_NaN())
+                   const char *begin, const char *end, const std::vector<int> &valuesIndexes,
+                   double fillValue)
 {
-    auto lineData = line.split(RESULT_LINE_SEPARATOR, QString::SkipEmptyParts);
+    // Splits the line in columns. The buffer of columns is reused from a line to another
+    thread_local auto columns = std::vector<std::pair<const char *, const char *> >{};
+    columns.clear();
+    for (auto it = begin; it != end;) {
+        auto columnEnd = std::find_if(it, end, isSeparator);
+        if (columnEnd != it) {
+            columns.emplace_back(it, columnEnd);
+        }
+        it = std::find_if_not(columnEnd, end, isSeparator);
+    }
+
+    auto line = [begin, end]() { return QString::fromUtf8(begin, static_cast<int>(end - begin)); };
 
     // Checks that the line contains expected number of values + x-axis value
-    if (static_cast<size_t>(lineData.size()) == valuesIndexes.size() + 1) {
-        // X : the data is converted from date to double (in secs)
-        auto x = doubleDate(lineData.at(0));
+    if (columns.size() == valuesIndexes.size() + 1) {
+        // X : the data is converted from date or epoch time to double (in secs)
+        auto x = readTime(columns.front().first, columns.front().second);
 
         // Adds result only if x is valid. Then, if value is invalid, it is set to NaN
         if (!std::isnan(x)) {
@@ -99,16 +313,17 @@ void tryReadResult(std::vector<double> &xAxisData, std::vector<double> &valuesDa
 
             // Values
             for (auto valueIndex : valuesIndexes) {
-                bool valueOk;
                 // we use valueIndex + 1 to skip column 0 (x-axis value)
-                auto value = lineData.at(valueIndex + 1).toDouble(&valueOk);
+                const auto &column = columns[valueIndex + 1];
 
-                if (!valueOk) {
+                double value;
+                if (!readDouble(column.first, column.second, value)) {
                     qCWarning(LOG_AmdaResultParserHelper())
                         << QObject::tr(
                                "Value from (line %1, column %2) is invalid and will be "
                                "converted to NaN")
-                               .arg(line, valueIndex);
+                               .arg(line())
+                               .arg(valueIndex);
                     value = std::numeric_limits<double>::quiet_NaN();
                 }
 
@@ -122,158 +337,321 @@ void tryReadResult(std::vector<double> &xAxisData, std::vector<double> &valuesDa
         }
         else {
             qCWarning(LOG_AmdaResultParserHelper())
-                << QObject::tr("Can't retrieve results from line %1: x is invalid").arg(line);
+                << QObject::tr("Can't retrieve results from line %1: x is invalid").arg(line());
         }
     }
     else {
         qCWarning(LOG_AmdaResultParserHelper())
-            << QObject::tr("Can't retrieve results from line %1: invalid line").arg(line);
+            << QObject::tr("Can't retrieve results from line %1: invalid line").arg(line());
     }
 }
 
 /**
- * Reads a line from the AMDA file and tries to extract a property from it
- * @param properties the properties map in which to put the property extracted from the line
- * @param key the key to which the property is added in the properties map
- * @param line the line to read to extract the property
- * @param regexes the expected regexes to extract the property. If the line matches one regex, the
- * property is generated
- * @param fun the function used to generate the property
- * @return true if the property could be generated, false if the line does not match the regex, or
- * if a property has already been generated for the key
+ * Reads the result lines of a part of the data section, skipping blank and comment lines
+ * @sa tryReadResult()
  */
-template <typename GeneratePropertyFun>
-bool tryReadProperty(Properties &properties, const QString &key, const QString &line,
-                     const std::vector<QRegularExpression> &regexes, GeneratePropertyFun fun)
+void tryReadResults(std::vector<double> &xAxisData, std::vector<double> &valuesData,
+                    const char *begin, const char *end, const std::vector<int> &valuesIndexes,
+                    double fillValue)
 {
-    if (properties.contains(key)) {
-        return false;
-    }
-
-    // Searches for a match among all possible regexes
-    auto hasMatch = false;
-    for (auto regexIt = regexes.cbegin(), end = regexes.cend(); regexIt != end && !hasMatch;
-         ++regexIt) {
-        auto match = regexIt->match(line);
-        auto hasMatch = match.hasMatch();
-        if (hasMatch) {
-            properties.insert(key, fun(match));
+    for (auto it = begin; it != end;) {
+        auto lineBegin = it;
+        auto lineEnd = static_cast<const char *>(
+            std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+        it = lineEnd ? lineEnd + 1 : end;
+        lineEnd = lineEnd ? lineEnd : end;
+
+        if (lineBegin != lineEnd && *(lineEnd - 1) == '\r') {
+            --lineEnd;
+        }
+        if (std::all_of(lineBegin, lineEnd, isSeparator) || *lineBegin == '#') {
+            continue;
         }
-    }
 
-    return hasMatch;
+        tryReadResult(xAxisData, valuesData, lineBegin, lineEnd, valuesIndexes, fillValue);
+    }
 }
 
+/// Part of the data section read concurrently, with the values read from it
+struct ResultChunk {
+    const char *m_Begin;
+    const char *m_End;
+    std::vector<double> m_XAxisData{};
+    std::vector<double> m_ValuesData{};
+};
+
 /**
- * Reads a line from the AMDA file and tries to extract a data from it. Date is converted to double
- * @sa tryReadProperty()
+ * Reads the result lines of the data section. If the section is large enough, it is split at line
+ * boundaries in chunks that are read on all cores, then the values of the chunks are appended in
+ * order to the vectors
+ * @sa tryReadResult()
  */
-bool tryReadDate(Properties &properties, const QString &key, const QString &line,
-                 const std::vector<QRegularExpression> &regexes, bool timeUnit = false)
+void readResults(std::vector<double> &xAxisData, std::vector<double> &valuesData,
+                 const char *begin, const char *end, const std::vector<int> &valuesIndexes,
+                 double fillValue = std::numeric_limits<double>::quiet_NaN())
 {
-    return tryReadProperty(properties, key, line, regexes, [timeUnit](const auto &match) {
-        return QVariant::fromValue(doubleDate(match.captured(1)));
+    auto chunkCount
+        = std::min<std::ptrdiff_t>(QThread::idealThreadCount(), (end - begin) / MIN_CHUNK_SIZE);
+    if (chunkCount <= 1) {
+        tryReadResults(xAxisData, valuesData, begin, end, valuesIndexes, fillValue);
+        return;
+    }
+
+    auto chunkSize = (end - begin) / chunkCount;
+    auto chunks = std::vector<ResultChunk>{};
+    for (auto it = begin; it != end;) {
+        // A chunk ends at the first end of line after its size
+        auto chunkEnd = end;
+        if (end - it > chunkSize) {
+            auto lineEnd = static_cast<const char *>(
+                std::memchr(it + chunkSize, '\n', static_cast<std::size_t>(end - it - chunkSize)));
+            chunkEnd = lineEnd ? lineEnd + 1 : end;
+        }
+        chunks.push_back(ResultChunk{it, chunkEnd});
+        it = chunkEnd;
+    }
+
+    // Vectors of the chunks are reserved in proportion of what was reserved for the whole section
+    auto linesPerByte
+        = static_cast<double>(xAxisData.capacity() - xAxisData.size()) / (end - begin);
+    QtConcurrent::blockingMap(chunks, [&](ResultChunk &chunk) {
+        auto lineCount = static_cast<std::size_t>(linesPerByte * (chunk.m_End - chunk.m_Begin)) + 1;
+        chunk.m_XAxisData.reserve(lineCount);
+        chunk.m_ValuesData.reserve(lineCount * valuesIndexes.size());
+        tryReadResults(chunk.m_XAxisData, chunk.m_ValuesData, chunk.m_Begin, chunk.m_End,
+                       valuesIndexes, fillValue);
     });
+
+    for (const auto &chunk : chunks) {
+        xAxisData.insert(xAxisData.end(), chunk.m_XAxisData.cbegin(), chunk.m_XAxisData.cend());
+        valuesData.insert(valuesData.end(), chunk.m_ValuesData.cbegin(),
+                          chunk.m_ValuesData.cend());
+    }
 }
 
-/**
- * Reads a line from the AMDA file and tries to extract a double from it
- * @sa tryReadProperty()
- */
-bool tryReadDouble(Properties &properties, const QString &key, const QString &line,
-                   const std::vector<QRegularExpression> &regexes)
+/// Moves out values read, leaving the vectors empty and ready to read further results
+AmdaResults takeValues(std::vector<double> &xAxisData, std::vector<double> &valuesData)
 {
-    return tryReadProperty(properties, key, line, regexes, [](const auto &match) {
-        bool ok;
+    auto result = AmdaResults{std::move(xAxisData), std::move(valuesData)};
+    xAxisData.clear();
+    valuesData.clear();
+    return result;
+}
+
+/// Type of the value of a property read in the header
+enum class PropertyType { DATE, DOUBLE, DOUBLES, UNIT };
+
+/// Property read in the header: key under which it is stored in the properties, and type of its
+/// value
+struct HeaderProperty {
+    QString m_Key;
+    PropertyType m_Type;
+};
+
+/// Converts a string to a double
+/// @return the double, NaN if the string can't be converted
+double toDouble(const QStringRef &value) noexcept
+{
+    bool ok;
+    auto result = value.toDouble(&ok);
+    return ok ? result : std::numeric_limits<double>::quiet_NaN();
+}
 
-        // If the value can't be converted to double, it is set to NaN
-        auto doubleValue = match.captured(1).toDouble(&ok);
-        if (!ok) {
-            doubleValue = std::numeric_limits<double>::quiet_NaN();
+/// Converts the value of a header line to a property of the type passed as parameter
+QVariant propertyValue(PropertyType type, const QString &value)
+{
+    switch (type) {
+        case PropertyType::DATE:
+            return QVariant::fromValue(doubleDate(value));
+        case PropertyType::DOUBLE:
+            return QVariant::fromValue(toDouble(QStringRef{&value}));
+        case PropertyType::DOUBLES: {
+            // Values are separated by commas. Values that can't be converted are set to NaN
+            auto doubleValues = std::vector<double>{};
+            for (const auto &doubleValue : value.splitRef(QLatin1Char{','})) {
+                doubleValues.push_back(toDouble(doubleValue));
+            }
+            return QVariant::fromValue(doubleValues);
         }
+        case PropertyType::UNIT:
+            // Units are kept as read: time series don't carry them
+            return QVariant::fromValue(value);
+    }
 
-        return QVariant::fromValue(doubleValue);
-    });
+    Q_UNREACHABLE();
+    return {};
 }
 
 /**
- * Reads a line from the AMDA file and tries to extract a vector of doubles from it
- * @param sep the separator of double values in the line
- * @sa tryReadProperty()
+ * Splits a header line of the form "# KEYWORD : value"
+ * @param keyword the keyword of the line, without the blanks around it
+ * @param value the value of the line, without the blanks preceding it
+ * @return false if the line isn't of this form
  */
-bool tryReadDoubles(Properties &properties, const QString &key, const QString &line,
-                    const std::vector<QRegularExpression> &regexes,
-                    const QString &sep = QStringLiteral(","))
+bool splitKeywordLine(const QString &line, QStringRef &keyword, QStringRef &value) noexcept
 {
-    return tryReadProperty(properties, key, line, regexes, [sep](const auto &match) {
-        std::vector<double> doubleValues{};
+    auto size = line.size();
+    auto skipBlanks = [&line, size](int i) {
+        while (i < size && line.at(i).isSpace()) {
+            ++i;
+        }
+        return i;
+    };
 
-        // If the value can't be converted to double, it is set to NaN
-        auto values = match.captured(1).split(sep);
-        for (auto value : values) {
-            bool ok;
+    if (size == 0 || line.at(0) != QLatin1Char{'#'}) {
+        return false;
+    }
 
-            auto doubleValue = value.toDouble(&ok);
-            if (!ok) {
-                doubleValue = std::numeric_limits<double>::quiet_NaN();
-            }
+    auto keywordBegin = skipBlanks(1);
+    auto keywordEnd = keywordBegin;
+    while (keywordEnd < size && !line.at(keywordEnd).isSpace()
+           && line.at(keywordEnd) != QLatin1Char{':'}) {
+        ++keywordEnd;
+    }
 
-            doubleValues.push_back(doubleValue);
-        }
+    auto separator = skipBlanks(keywordEnd);
+    if (keywordBegin == keywordEnd || separator == size || line.at(separator) != QLatin1Char{':'}) {
+        return false;
+    }
 
-        return QVariant::fromValue(doubleValues);
-    });
+    keyword = line.midRef(keywordBegin, keywordEnd - keywordBegin);
+    value = line.midRef(skipBlanks(separator + 1));
+    return true;
 }
 
 /**
- * Reads a line from the AMDA file and tries to extract a unit from it
- * @sa tryReadProperty()
+ * Recognizes the properties in the header lines of an AMDA file. A recognizer is built once for
+ * each type of helper.
+ *
+ * Lines of the form "# KEYWORD : value" are dispatched on their keyword, without any regex. The
+ * regexes are only tried on the lines of another form (e.g. "#imf(0) - ... - Units : nT - ...")
  */
-bool tryReadUnit(Properties &properties, const QString &key, const QString &line,
-                 const std::vector<QRegularExpression> &regexes, bool timeUnit = false)
+class HeaderRecognizer {
+public:
+    using Keywords = std::vector<std::pair<QString, HeaderProperty> >;
+    using Regexes = std::vector<std::pair<QRegularExpression, HeaderProperty> >;
+
+    explicit HeaderRecognizer(Keywords keywords, Regexes regexes = {})
+            : m_Keywords{std::move(keywords)}, m_Regexes{std::move(regexes)}
+    {
+    }
+
+    /// Reads a header line and puts the property it contains in the properties. A property that
+    /// was already read isn't replaced
+    void readLine(Properties &properties, const QString &line) const
+    {
+        QStringRef keyword, value;
+        if (splitKeywordLine(line, keyword, value)) {
+            auto it = std::find_if(
+                m_Keywords.cbegin(), m_Keywords.cend(),
+                [&keyword](const auto &entry) { return keyword == entry.first; });
+            if (it != m_Keywords.cend()) {
+                insertProperty(properties, it->second, value.toString());
+            }
+            return;
+        }
+
+        for (const auto &regex : m_Regexes) {
+            auto match = regex.first.match(line);
+            if (match.hasMatch()) {
+                insertProperty(properties, regex.second, match.captured(1));
+                return;
+            }
+        }
+    }
+
+private:
+    static void insertProperty(Properties &properties, const HeaderProperty &property,
+                               const QString &value)
+    {
+        if (!properties.contains(property.m_Key)) {
+            properties.insert(property.m_Key, propertyValue(property.m_Type, value));
+        }
+    }
+
+    Keywords m_Keywords;
+    Regexes m_Regexes;
+};
+
+/// @return the recognizer of the header of scalar and vector files, from which only the x-axis unit
+/// is read
+const HeaderRecognizer &xAxisUnitRecognizer()
 {
-    return tryReadProperty(properties, key, line, regexes, [timeUnit](const auto &match) {
-        return QVariant::fromValue(Unit{match.captured(1), timeUnit});
-    });
+    static const auto result = HeaderRecognizer{
+        {{X_AXIS_UNIT_KEYWORD, {X_AXIS_UNIT_PROPERTY, PropertyType::UNIT}}},
+        {{DEFAULT_X_AXIS_UNIT_REGEX, {X_AXIS_UNIT_PROPERTY, PropertyType::UNIT}}}};
+    return result;
 }
 
 } // namespace
 
+TimeSeries::ITimeSerie *createTimeSerie(DataSeriesType type, AmdaResults results)
+{
+    switch (type) {
+        case DataSeriesType::SCALAR:
+            return createScalarSerie(results.m_XAxisData, results.m_ValuesData);
+        case DataSeriesType::SPECTROGRAM: {
+            auto shape = std::vector<std::size_t>{results.m_XAxisData.size(),
+                                                  results.m_YAxisData.size()};
+            return new SpectrogramTimeSerie(std::move(results.m_XAxisData),
+                                            std::move(results.m_YAxisData),
+                                            std::move(results.m_ValuesData), shape,
+                                            results.m_MinSampling, results.m_MaxSampling);
+        }
+        case DataSeriesType::VECTOR:
+            return createVectorSerie(results.m_XAxisData, results.m_ValuesData);
+        case DataSeriesType::NONE:
+            break;
+    }
+
+    return nullptr;
+}
+
 // ////////////////// //
 // ScalarParserHelper //
 // ////////////////// //
 
 bool ScalarParserHelper::checkProperties()
 {
-    if(auto hasXUnit = checkUnit(m_Properties, X_AXIS_UNIT_PROPERTY, QObject::tr("The x-axis unit could not be found in the file"));!hasXUnit)
-    {
-        m_Properties[X_AXIS_UNIT_PROPERTY] = QVariant::fromValue(Unit{"s",true});
-    }
+    // No property is required to read scalars
     return true;
 }
 
-IDataSeries* ScalarParserHelper::createSeries()
+TimeSeries::ITimeSerie *ScalarParserHelper::createSeries()
 {
-    return new ScalarSeries(std::move(m_XAxisData), std::move(m_ValuesData),
-                                          m_Properties.value(X_AXIS_UNIT_PROPERTY).value<Unit>(),
-                                          m_Properties.value(VALUES_UNIT_PROPERTY).value<Unit>());
+    return createTimeSerie(DataSeriesType::SCALAR, takeResults());
 }
 
 void ScalarParserHelper::readPropertyLine(const QString &line)
 {
-    tryReadUnit(m_Properties, X_AXIS_UNIT_PROPERTY, line,
-                {DEFAULT_X_AXIS_UNIT_REGEX, ALTERNATIVE_X_AXIS_UNIT_REGEX}, true);
+    xAxisUnitRecognizer().readLine(m_Properties, line);
+}
+
+void ScalarParserHelper::reserve(std::size_t lineCount)
+{
+    m_XAxisData.reserve(lineCount);
+    m_ValuesData.reserve(lineCount);
+}
+
+void ScalarParserHelper::readResults(const char *begin, const char *end)
+{
+    ::readResults(m_XAxisData, m_ValuesData, begin, end, valuesIndexes());
+}
+
+AmdaResults ScalarParserHelper::takeResults()
+{
+    return takeValues(m_XAxisData, m_ValuesData);
 }
 
-void ScalarParserHelper::readResultLine(const QString &line)
+const Properties &ScalarParserHelper::properties() const
 {
-    tryReadResult(m_XAxisData, m_ValuesData, line, valuesIndexes());
+    return m_Properties;
 }
 
-std::vector<int> ScalarParserHelper::valuesIndexes() const
+const std::vector<int> &ScalarParserHelper::valuesIndexes() const
 {
     // Only one value to read
-    static auto result = std::vector<int>{0};
+    static const auto result = std::vector<int>{0};
     return result;
 }
 
@@ -299,104 +677,69 @@ bool SpectrogramParserHelper::checkProperties()
 
     // Generates values indexes, i.e. the order in which each value will be retrieved (in ascending
     // order of the associated bands)
-    m_ValuesIndexes = SortUtils::sortPermutation(m_YAxisData, std::less<double>());
+    m_ValuesIndexes = sortPermutation(m_YAxisData);
 
     // Sorts y-axis data accoding to the ascending order
-    m_YAxisData = SortUtils::sort(m_YAxisData, 1, m_ValuesIndexes);
+    auto yAxisData = std::vector<double>{};
+    yAxisData.reserve(m_YAxisData.size());
+    for (auto index : m_ValuesIndexes) {
+        yAxisData.push_back(m_YAxisData[index]);
+    }
+    m_YAxisData = std::move(yAxisData);
 
     // Sets fill value
-    m_FillValue = m_Properties.value(FILL_VALUE_PROPERTY).value<double>();
+    m_FillValue = doubleProperty(m_Properties, FILL_VALUE_PROPERTY);
 
     return true;
 }
 
-IDataSeries* SpectrogramParserHelper::createSeries()
+TimeSeries::ITimeSerie *SpectrogramParserHelper::createSeries()
 {
-    // Before creating the series, we handle its data holes
-    handleDataHoles();
-
-    return new SpectrogramSeries(
-        std::move(m_XAxisData), std::move(m_YAxisData), std::move(m_ValuesData),
-        Unit{"t", true}, // x-axis unit is always a time unit
-        m_Properties.value(Y_AXIS_UNIT_PROPERTY).value<Unit>(),
-        m_Properties.value(VALUES_UNIT_PROPERTY).value<Unit>(),
-        m_Properties.value(MIN_SAMPLING_PROPERTY).value<double>());
+    // Data holes are not filled: the serie keeps the max sampling of the file, from which its gaps
+    // are found as segments when it is displayed (@sa DataGaps)
+    return createTimeSerie(DataSeriesType::SPECTROGRAM, takeResults());
 }
 
 void SpectrogramParserHelper::readPropertyLine(const QString &line)
 {
-    // Set of functions to test on the line to generate a property. If a function is valid (i.e. a
-    // property has been generated for the line), the line is treated as processed and the other
-    // functions are not called
-    std::vector<std::function<bool()> > functions{
-        // values unit
-        [&] {
-            return tryReadUnit(m_Properties, VALUES_UNIT_PROPERTY, line,
-                               {SPECTROGRAM_VALUES_UNIT_REGEX});
-        },
-        // y-axis unit
-        [&] {
-            return tryReadUnit(m_Properties, Y_AXIS_UNIT_PROPERTY, line,
-                               {SPECTROGRAM_Y_AXIS_UNIT_REGEX});
-        },
-        // min sampling
-        [&] {
-            return tryReadDouble(m_Properties, MIN_SAMPLING_PROPERTY, line,
-                                 {SPECTROGRAM_MIN_SAMPLING_REGEX});
-        },
-        // max sampling
-        [&] {
-            return tryReadDouble(m_Properties, MAX_SAMPLING_PROPERTY, line,
-                                 {SPECTROGRAM_MAX_SAMPLING_REGEX});
-        },
-        // fill value
-        [&] {
-            return tryReadDouble(m_Properties, FILL_VALUE_PROPERTY, line,
-                                 {SPECTROGRAM_FILL_VALUE_REGEX});
-        },
-        // min bounds of each band
-        [&] {
-            return tryReadDoubles(m_Properties, MIN_BANDS_PROPERTY, line,
-                                  {SPECTROGRAM_MIN_BANDS_REGEX});
-        },
-        // max bounds of each band
-        [&] {
-            return tryReadDoubles(m_Properties, MAX_BANDS_PROPERTY, line,
-                                  {SPECTROGRAM_MAX_BANDS_REGEX});
-        },
-        // start time of data
-        [&] {
-            return tryReadDate(m_Properties, START_TIME_PROPERTY, line,
-                               {SPECTROGRAM_START_TIME_REGEX});
-        },
-        // end time of data
-        [&] {
-            return tryReadDate(m_Properties, END_TIME_PROPERTY, line, {SPECTROGRAM_END_TIME_REGEX});
-        }};
-
-    for (auto function : functions) {
-        // Stops at the first function that is valid
-        if (function()) {
-            return;
-        }
-    }
+    static const auto recognizer = HeaderRecognizer{{
+        {SPECTROGRAM_VALUES_UNIT_KEYWORD, {VALUES_UNIT_PROPERTY, PropertyType::UNIT}},
+        {SPECTROGRAM_Y_AXIS_UNIT_KEYWORD, {Y_AXIS_UNIT_PROPERTY, PropertyType::UNIT}},
+        {SPECTROGRAM_MIN_SAMPLING_KEYWORD, {MIN_SAMPLING_PROPERTY, PropertyType::DOUBLE}},
+        {SPECTROGRAM_MAX_SAMPLING_KEYWORD, {MAX_SAMPLING_PROPERTY, PropertyType::DOUBLE}},
+        {SPECTROGRAM_FILL_VALUE_KEYWORD, {FILL_VALUE_PROPERTY, PropertyType::DOUBLE}},
+        {SPECTROGRAM_MIN_BANDS_KEYWORD, {MIN_BANDS_PROPERTY, PropertyType::DOUBLES}},
+        {SPECTROGRAM_MAX_BANDS_KEYWORD, {MAX_BANDS_PROPERTY, PropertyType::DOUBLES}},
+        {SPECTROGRAM_START_TIME_KEYWORD, {START_TIME_PROPERTY, PropertyType::DATE}},
+        {SPECTROGRAM_END_TIME_KEYWORD, {END_TIME_PROPERTY, PropertyType::DATE}}}};
+
+    recognizer.readLine(m_Properties, line);
 }
 
-void SpectrogramParserHelper::readResultLine(const QString &line)
+void SpectrogramParserHelper::reserve(std::size_t lineCount)
 {
-    tryReadResult(m_XAxisData, m_ValuesData, line, m_ValuesIndexes, m_FillValue);
+    m_XAxisData.reserve(lineCount);
+    m_ValuesData.reserve(lineCount * m_ValuesIndexes.size());
 }
 
-void SpectrogramParserHelper::handleDataHoles()
+void SpectrogramParserHelper::readResults(const char *begin, const char *end)
 {
-    // Fills data holes according to the max resolution found in the AMDA file
-    auto resolution = m_Properties.value(MAX_SAMPLING_PROPERTY).value<double>();
-    auto fillValue = m_Properties.value(FILL_VALUE_PROPERTY).value<double>();
-    auto minBound = m_Properties.value(START_TIME_PROPERTY).value<double>();
-    auto maxBound = m_Properties.value(END_TIME_PROPERTY).value<double>();
+    ::readResults(m_XAxisData, m_ValuesData, begin, end, m_ValuesIndexes, m_FillValue);
+}
 
-    DataSeriesUtils::fillDataHoles(m_XAxisData, m_ValuesData, resolution, fillValue, minBound,
-                                   maxBound);
+AmdaResults SpectrogramParserHelper::takeResults()
+{
+    // Bands are copied, as they are the same for all the parts of the data section
+    auto result = takeValues(m_XAxisData, m_ValuesData);
+    result.m_YAxisData = m_YAxisData;
+    result.m_MinSampling = doubleProperty(m_Properties, MIN_SAMPLING_PROPERTY);
+    result.m_MaxSampling = doubleProperty(m_Properties, MAX_SAMPLING_PROPERTY);
+    return result;
+}
+
+const Properties &SpectrogramParserHelper::properties() const
+{
+    return m_Properties;
 }
 
 // ////////////////// //
@@ -405,34 +748,44 @@ void SpectrogramParserHelper::handleDataHoles()
 
 bool VectorParserHelper::checkProperties()
 {
-    if(auto hasXUnit = checkUnit(m_Properties, X_AXIS_UNIT_PROPERTY, QObject::tr("The x-axis unit could not be found in the file"));!hasXUnit)
-    {
-        m_Properties[X_AXIS_UNIT_PROPERTY] = QVariant::fromValue(Unit{"s",true});
-    }
+    // No property is required to read vectors
     return true;
 }
 
-IDataSeries* VectorParserHelper::createSeries()
+TimeSeries::ITimeSerie *VectorParserHelper::createSeries()
 {
-    return new VectorSeries(std::move(m_XAxisData), std::move(m_ValuesData),
-                                          m_Properties.value(X_AXIS_UNIT_PROPERTY).value<Unit>(),
-                                          m_Properties.value(VALUES_UNIT_PROPERTY).value<Unit>());
+    return createTimeSerie(DataSeriesType::VECTOR, takeResults());
 }
 
 void VectorParserHelper::readPropertyLine(const QString &line)
 {
-    tryReadUnit(m_Properties, X_AXIS_UNIT_PROPERTY, line,
-                {DEFAULT_X_AXIS_UNIT_REGEX, ALTERNATIVE_X_AXIS_UNIT_REGEX}, true);
+    xAxisUnitRecognizer().readLine(m_Properties, line);
+}
+
+void VectorParserHelper::reserve(std::size_t lineCount)
+{
+    m_XAxisData.reserve(lineCount);
+    m_ValuesData.reserve(lineCount * 3);
+}
+
+void VectorParserHelper::readResults(const char *begin, const char *end)
+{
+    ::readResults(m_XAxisData, m_ValuesData, begin, end, valuesIndexes());
+}
+
+AmdaResults VectorParserHelper::takeResults()
+{
+    return takeValues(m_XAxisData, m_ValuesData);
 }
 
-void VectorParserHelper::readResultLine(const QString &line)
+const Properties &VectorParserHelper::properties() const
 {
-    tryReadResult(m_XAxisData, m_ValuesData, line, valuesIndexes());
+    return m_Properties;
 }
 
-std::vector<int> VectorParserHelper::valuesIndexes() const
+const std::vector<int> &VectorParserHelper::valuesIndexes() const
 {
     // 3 values to read, in order in the file (x, y, z)
-    static auto result = std::vector<int>{0, 1, 2};
+    static const auto result = std::vector<int>{0, 1, 2};
     return result;
 }
@@ -0,0 +1,229 @@
+#include "AmdaResultStreamParser.h"
+#include "AmdaResultParser.h"
+
+#include <QtCore/QLatin1String>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+
+/// Message in result file when the file was not found on server
+const auto FILE_NOT_FOUND_MESSAGE = QStringLiteral("Not Found");
+
+/// UTF-8 byte order mark, that may start the file
+const auto UTF8_BOM = QByteArrayLiteral("\xEF\xBB\xBF");
+
+/// Line of the file, as a range of bytes without the end of line characters
+struct Line
+{
+    const char* m_Begin;
+    const char* m_End;
+};
+
+/// Checks if a line is a comment line
+bool isCommentLine(const Line& line) noexcept
+{
+    return line.m_Begin != line.m_End && *line.m_Begin == '#';
+}
+
+/// Checks if a line contains only blanks
+bool isBlankLine(const Line& line) noexcept
+{
+    return std::all_of(line.m_Begin, line.m_End, [](char c) { return c == ' ' || c == '\t'; });
+}
+
+/**
+ * Creates helper that will be used to read AMDA file, according to the type passed as parameter
+ * @param valueType the type of values expected in the AMDA file (scalars, vectors, spectrograms...)
+ * @return the helper created
+ */
+std::unique_ptr<IAmdaResultParserHelper> createHelper(DataSeriesType valueType)
+{
+    switch (valueType)
+    {
+        case DataSeriesType::SCALAR:
+            return std::make_unique<ScalarParserHelper>();
+        case DataSeriesType::SPECTROGRAM:
+            return std::make_unique<SpectrogramParserHelper>();
+        case DataSeriesType::VECTOR:
+            return std::make_unique<VectorParserHelper>();
+        case DataSeriesType::NONE:
+            // Invalid case
+            break;
+    }
+
+    // Invalid cases
+    qCCritical(LOG_AmdaResultParser())
+        << QObject::tr("Can't create helper to read result file: unsupported type");
+    return nullptr;
+}
+
+} // namespace
+
+AmdaResultStreamParser::AmdaResultStreamParser(
+    DataSeriesType type, std::size_t chunkSize, ResultsReadFun resultsReadFun)
+        : m_Helper { createHelper(type) }
+        , m_ChunkSize { chunkSize }
+        , m_ResultsReadFun { std::move(resultsReadFun) }
+        , m_State { m_Helper ? State::FIRST_LINE : State::INVALID }
+{
+}
+
+AmdaResultStreamParser::~AmdaResultStreamParser() noexcept = default;
+
+bool AmdaResultStreamParser::feed(const char* begin, const char* end)
+{
+    if (m_State == State::INVALID)
+    {
+        return false;
+    }
+
+    // Bytes are read in place, unless bytes of the previous call are left
+    if (m_Buffer.isEmpty())
+    {
+        auto readEnd = read(begin, end, false);
+        m_Buffer.append(readEnd, static_cast<int>(end - readEnd));
+    }
+    else
+    {
+        m_Buffer.append(begin, static_cast<int>(end - begin));
+        auto readEnd = read(m_Buffer.constData(), m_Buffer.constData() + m_Buffer.size(), false);
+        m_Buffer.remove(0, static_cast<int>(readEnd - m_Buffer.constData()));
+    }
+
+    return m_State != State::INVALID;
+}
+
+bool AmdaResultStreamParser::feed(const QByteArray& bytes)
+{
+    return feed(bytes.constData(), bytes.constData() + bytes.size());
+}
+
+bool AmdaResultStreamParser::finish()
+{
+    if (m_State != State::INVALID)
+    {
+        read(m_Buffer.constData(), m_Buffer.constData() + m_Buffer.size(), true);
+        m_Buffer.clear();
+    }
+
+    // File without results: properties haven't been checked yet
+    if ((m_State == State::FIRST_LINE || m_State == State::HEADER) && !m_Helper->checkProperties())
+    {
+        m_State = State::INVALID;
+    }
+
+    return m_State != State::INVALID;
+}
+
+TimeSeries::ITimeSerie* AmdaResultStreamParser::createSeries()
+{
+    return m_State != State::INVALID ? m_Helper->createSeries() : nullptr;
+}
+
+Properties AmdaResultStreamParser::properties() const
+{
+    return m_Helper ? m_Helper->properties() : Properties {};
+}
+
+const char* AmdaResultStreamParser::read(const char* begin, const char* end, bool isLast)
+{
+    auto it = begin;
+
+    // Header is read line by line, until the first result line
+    while (it != end && (m_State == State::FIRST_LINE || m_State == State::HEADER))
+    {
+        auto lineEnd = static_cast<const char*>(
+            std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+        if (!lineEnd && !isLast)
+        {
+            return it;
+        }
+
+        auto next = lineEnd ? lineEnd + 1 : end;
+        auto line = Line { it, lineEnd ? lineEnd : end };
+        if (line.m_End != line.m_Begin && *(line.m_End - 1) == '\r')
+        {
+            --line.m_End;
+        }
+
+        if (m_State == State::FIRST_LINE)
+        {
+            m_State = State::HEADER;
+            if (line.m_End - line.m_Begin >= UTF8_BOM.size()
+                && std::equal(UTF8_BOM.cbegin(), UTF8_BOM.cend(), line.m_Begin))
+            {
+                line.m_Begin += UTF8_BOM.size();
+                it = line.m_Begin;
+            }
+
+            // Checks if the file was found on the server
+            if (QLatin1String { line.m_Begin, static_cast<int>(line.m_End - line.m_Begin) }
+                == FILE_NOT_FOUND_MESSAGE)
+            {
+                m_State = State::INVALID;
+                return end;
+            }
+        }
+
+        if (isCommentLine(line))
+        {
+            m_Helper->readPropertyLine(
+                QString::fromUtf8(line.m_Begin, static_cast<int>(line.m_End - line.m_Begin)));
+            it = next;
+            continue;
+        }
+        if (isBlankLine(line))
+        {
+            it = next;
+            continue;
+        }
+
+        // First result line: properties are complete
+        if (!m_Helper->checkProperties())
+        {
+            m_State = State::INVALID;
+            return end;
+        }
+        m_State = State::RESULTS;
+        m_LineLength = static_cast<std::size_t>(next - it);
+    }
+
+    if (m_State != State::RESULTS)
+    {
+        return m_State == State::INVALID ? end : it;
+    }
+
+    // Results are read up to the last complete line, once there are enough of them
+    auto resultsEnd = end;
+    if (!isLast)
+    {
+        auto lastLineEnd = std::find(std::make_reverse_iterator(end),
+            std::make_reverse_iterator(it), '\n');
+        resultsEnd = lastLineEnd.base();
+    }
+
+    auto resultsSize = static_cast<std::size_t>(resultsEnd - it);
+    if (resultsSize == 0 || (!isLast && resultsSize < m_ChunkSize))
+    {
+        return it;
+    }
+
+    // Values are reserved for the results to read, unless they are accumulated with previous ones
+    if (m_ResultsReadFun || !m_HasReadResults)
+    {
+        m_Helper->reserve(resultsSize / m_LineLength);
+    }
+    m_Helper->readResults(it, resultsEnd);
+    m_HasReadResults = true;
+
+    if (m_ResultsReadFun)
+    {
+        m_ResultsReadFun(m_Helper->takeResults());
+    }
+
+    return resultsEnd;
+}
@@ -0,0 +1,175 @@
+#include "GzipStreamDecoder.h"
+
+#include <zlib.h>
+
+Q_LOGGING_CATEGORY(LOG_GzipStreamDecoder, "GzipStreamDecoder")
+
+namespace
+{
+
+/// Magic number starting gzip data
+const auto GZIP_MAGIC_NUMBER = QByteArrayLiteral("\x1F\x8B");
+
+/// Size of the blocks of decompressed bytes passed to the output function
+const auto OUTPUT_BLOCK_SIZE = std::size_t { 256 * 1024 };
+
+/// Window bits for inflateInit2(), to decode gzip format only
+const auto GZIP_WINDOW_BITS = 16 + MAX_WBITS;
+
+} // namespace
+
+GzipStreamDecoder::GzipStreamDecoder(OutputFun outputFun)
+        : m_OutputFun { std::move(outputFun) }
+        , m_Stream { std::make_unique<z_stream>() }
+        , m_OutputBuffer(OUTPUT_BLOCK_SIZE)
+{
+}
+
+GzipStreamDecoder::~GzipStreamDecoder() noexcept
+{
+    if (m_State == State::GZIP || m_State == State::INVALID)
+    {
+        inflateEnd(m_Stream.get());
+    }
+}
+
+bool GzipStreamDecoder::feed(const char* begin, const char* end)
+{
+    if (m_State == State::DETECTING)
+    {
+        m_FirstBytes.append(begin, static_cast<int>(end - begin));
+        if (m_FirstBytes.size() < GZIP_MAGIC_NUMBER.size())
+        {
+            return true;
+        }
+
+        if (m_FirstBytes.startsWith(GZIP_MAGIC_NUMBER))
+        {
+            if (inflateInit2(m_Stream.get(), GZIP_WINDOW_BITS) != Z_OK)
+            {
+                qCCritical(LOG_GzipStreamDecoder())
+                    << QObject::tr("Can't initialize decompression: %1").arg(m_Stream->msg);
+                return false;
+            }
+            m_State = State::GZIP;
+        }
+        else
+        {
+            m_State = State::PLAIN;
+        }
+
+        // First bytes are decoded as the other ones
+        auto firstBytes = std::move(m_FirstBytes);
+        m_FirstBytes.clear();
+        return feed(firstBytes.constData(), firstBytes.constData() + firstBytes.size());
+    }
+
+    switch (m_State)
+    {
+        case State::PLAIN:
+            return begin == end || m_OutputFun(begin, end);
+        case State::GZIP:
+            return inflate(begin, end);
+        case State::INVALID:
+            return false;
+        case State::DETECTING:
+            break;
+    }
+
+    Q_UNREACHABLE();
+    return false;
+}
+
+bool GzipStreamDecoder::feed(const QByteArray& bytes)
+{
+    return feed(bytes.constData(), bytes.constData() + bytes.size());
+}
+
+bool GzipStreamDecoder::finish()
+{
+    switch (m_State)
+    {
+        case State::DETECTING:
+            // Data too short to be compressed
+            m_State = State::PLAIN;
+            return m_FirstBytes.isEmpty()
+                || m_OutputFun(m_FirstBytes.constData(),
+                       m_FirstBytes.constData() + m_FirstBytes.size());
+        case State::PLAIN:
+            return true;
+        case State::GZIP:
+            if (!m_IsMemberEnded)
+            {
+                qCWarning(LOG_GzipStreamDecoder())
+                    << QObject::tr("Can't decompress data: data is truncated");
+                m_State = State::INVALID;
+            }
+            return m_IsMemberEnded;
+        case State::INVALID:
+            return false;
+    }
+
+    Q_UNREACHABLE();
+    return false;
+}
+
+bool GzipStreamDecoder::inflate(const char* begin, const char* end)
+{
+    if (begin == end)
+    {
+        return true;
+    }
+
+    // Bytes after the end of a member are the beginning of a new member
+    if (m_IsMemberEnded)
+    {
+        inflateReset(m_Stream.get());
+        m_IsMemberEnded = false;
+    }
+
+    auto& stream = *m_Stream;
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(begin));
+    stream.avail_in = static_cast<uInt>(end - begin);
+
+    do
+    {
+        stream.next_out = reinterpret_cast<Bytef*>(m_OutputBuffer.data());
+        stream.avail_out = static_cast<uInt>(m_OutputBuffer.size());
+
+        auto result = ::inflate(&stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+        {
+            qCWarning(LOG_GzipStreamDecoder())
+                << QObject::tr("Can't decompress data: %1")
+                       .arg(QString { stream.msg ? stream.msg : "invalid data" });
+            m_State = State::INVALID;
+            return false;
+        }
+
+        auto outputSize = m_OutputBuffer.size() - stream.avail_out;
+        if (outputSize != 0
+            && !m_OutputFun(m_OutputBuffer.data(), m_OutputBuffer.data() + outputSize))
+        {
+            m_State = State::INVALID;
+            return false;
+        }
+
+        // No progress can be made with the bytes arrived
+        if (result == Z_BUF_ERROR && outputSize == 0)
+        {
+            break;
+        }
+
+        if (result == Z_STREAM_END)
+        {
+            m_IsMemberEnded = true;
+            if (stream.avail_in != 0)
+            {
+                inflateReset(&stream);
+                m_IsMemberEnded = false;
+            }
+        }
+    } while (stream.avail_in != 0 || stream.avail_out == 0);
+
+    return true;
+}
@@ -66,10 +66,10 @@ extern const QString VALIDATION_FREQUENCY_BOUNDS_PROPERTY;
 // Structs //
 // /////// //
 
-class Variable;
+class Variable2;
 struct VariableState
 {
-    std::shared_ptr<Variable> m_Variable { nullptr };
+    std::shared_ptr<Variable2> m_Variable { nullptr };
     DateTimeRange m_Range { INVALID_RANGE };
 };
 
@@ -3,7 +3,7 @@
 
 #include <Data/IDataProvider.h>
 
-#include <Variable/Variable.h>
+#include <Variable/Variable2.h>
 #include <Variable/VariableController2.h>
 
 #include <QUuid>
@@ -38,12 +38,13 @@ struct CreateOperation : public IFuzzingOperation {
         qCInfo(LOG_FuzzingOperations()).noquote() << "Creating variable" << variableName
                                                   << "(metadata:" << variableMetadata << ")...";
 
-        auto newVariable
-            = variableController.createVariable(variableName, variableMetadata, variableProvider, properties.value(INITIAL_RANGE_PROPERTY).value<DateTimeRange>());
+        auto initialRange = properties.value(INITIAL_RANGE_PROPERTY).value<DateTimeRange>();
+        auto newVariable = variableController.createVariable(variableName, variableMetadata,
+                                                             variableProvider, initialRange);
 
         // Updates variable's state
         auto &variableState = fuzzingState.variableState(variableId);
-        variableState.m_Range = properties.value(INITIAL_RANGE_PROPERTY).value<DateTimeRange>();
+        variableState.m_Range = initialRange;
         std::swap(variableState.m_Variable, newVariable);
     }
 };
@@ -136,16 +137,22 @@ struct MoveOperation : public IFuzzingOperation {
         auto delta = RandomGenerator::instance().generateDouble(0, deltaMax);
 
         // Moves variable to its new range
-        auto isSynchronized = !fuzzingState.syncGroupId(variableId).isNull();
         auto newVariableRange = DateTimeRange{m_RangeStartMoveFun(variableRange.m_TStart, delta),
                                          m_RangeEndMoveFun(variableRange.m_TEnd, delta)};
         qCInfo(LOG_FuzzingOperations()).noquote() << "Performing" << m_Label << "on"
                                                   << variable->name() << "(from" << variableRange
                                                   << "to" << newVariableRange << ")...";
-        variableController.changeRange({variable}, newVariableRange);
 
-        // Updates state
+        // Updates state, then moves the variable and all the variables synchronized with it
         fuzzingState.updateRanges(variableId, newVariableRange);
+        auto syncGroupId = fuzzingState.syncGroupId(variableId);
+        auto movedVariables = syncGroupId.isNull()
+                                  ? std::set<VariableId>{variableId}
+                                  : fuzzingState.syncGroup(syncGroupId).m_Variables;
+        for (auto movedVariableId : movedVariables) {
+            variableController.asyncChangeRange(
+                fuzzingState.variableState(movedVariableId).m_Variable, newVariableRange);
+        }
     }
 
     MoveFunction m_RangeStartMoveFun;
@@ -172,12 +179,10 @@ struct SynchronizeOperation : public IFuzzingOperation {
         qCInfo(LOG_FuzzingOperations()).noquote() << "Adding" << variableState.m_Variable->name()
                                                   << "into synchronization group" << syncGroupId
                                                   << "...";
-        //variableController.onAddSynchronized(variableState.m_Variable, syncGroupId);
 
-        // Updates state
+        // Updates state: the variable takes the range of the group, if the group isn't empty
         fuzzingState.synchronizeVariable(variableId, syncGroupId);
-
-        variableController.changeRange({variableState.m_Variable}, variableState.m_Range);
+        variableController.asyncChangeRange(variableState.m_Variable, variableState.m_Range);
     }
 };
 
@@ -189,7 +194,7 @@ struct DesynchronizeOperation : public IFuzzingOperation {
     }
 
     void execute(VariableId variableId, FuzzingState &fuzzingState,
-                 VariableController2 &variableController, const Properties &) const override
+                 VariableController2 &, const Properties &) const override
     {
         auto &variableState = fuzzingState.variableState(variableId);
 
@@ -199,7 +204,6 @@ struct DesynchronizeOperation : public IFuzzingOperation {
         qCInfo(LOG_FuzzingOperations()).noquote() << "Removing" << variableState.m_Variable->name()
                                                   << "from synchronization group" << syncGroupId
                                                   << "...";
-        //variableController.desynchronize(variableState.m_Variable, syncGroupId);
 
         // Updates state
         fuzzingState.desynchronizeVariable(variableId, syncGroupId);
@@ -12,8 +12,6 @@
 
 Q_DECLARE_LOGGING_CATEGORY(LOG_FuzzingOperations)
 
-class VariableController;
-
 /**
  * Enumeration of types of existing fuzzing operations
  */
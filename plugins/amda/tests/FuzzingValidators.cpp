@@ -1,12 +1,16 @@
 #include "FuzzingValidators.h"
 #include "FuzzingDefs.h"
 
-#include <Data/DataSeries.h>
-#include <Variable/Variable.h>
+#include <Common/DateUtils.h>
+#include <Data/VectorTimeSerie.h>
+#include <Variable/Variable2.h>
 
 #include <QTest>
 
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <iterator>
 
 Q_LOGGING_CATEGORY(LOG_FuzzingValidators, "FuzzingValidators")
 
@@ -61,28 +65,33 @@ public:
         auto message = "Checking variable's data...";
         auto toDateString = [](double value) { return DateUtils::dateTime(value).toString(); };
 
-        // Checks that data are defined
-        auto variableDataSeries = variableState.m_Variable->dataSeries();
-        if (variableDataSeries == nullptr && variableState.m_Range != INVALID_RANGE) {
+        // Checks that data are defined. Data of the local server are vectors
+        auto variableData
+            = std::dynamic_pointer_cast<VectorTimeSerie>(variableState.m_Variable->data());
+        if (variableData == nullptr) {
             qCInfo(LOG_FuzzingValidators()).noquote()
                 << message << "FAIL: the variable has no data while a range is defined";
             QFAIL("");
         }
 
-        auto dataIts = variableDataSeries->xAxisRange(variableState.m_Range.m_TStart,
-                                                      variableState.m_Range.m_TEnd);
+        auto dataBegin = std::lower_bound(
+            std::begin(*variableData), std::end(*variableData), variableState.m_Range.m_TStart,
+            [](const auto &sample, double time) { return sample.t() < time; });
+        auto dataEnd = std::upper_bound(
+            dataBegin, std::end(*variableData), variableState.m_Range.m_TEnd,
+            [](double time, const auto &sample) { return time < sample.t(); });
 
         // Checks that the data are well defined in the range:
         // - there is at least one data
         // - the data are consistent (no data holes)
-        if (std::distance(dataIts.first, dataIts.second) == 0) {
+        if (dataBegin == dataEnd) {
             qCInfo(LOG_FuzzingValidators()).noquote() << message
                                                       << "FAIL: the variable has no data";
             QFAIL("");
         }
 
-        auto firstXAxisData = dataIts.first->x();
-        auto lastXAxisData = (dataIts.second - 1)->x();
+        auto firstXAxisData = dataBegin->t();
+        auto lastXAxisData = std::prev(dataEnd)->t();
 
         if (std::abs(firstXAxisData - variableState.m_Range.m_TStart) > LOCALHOST_SERVER_RESOLUTION
             || std::abs(lastXAxisData - variableState.m_Range.m_TEnd)
@@ -94,26 +103,26 @@ public:
         }
 
         auto dataHoleIt = std::adjacent_find(
-            dataIts.first, dataIts.second, [](const auto &it1, const auto &it2) {
+            dataBegin, dataEnd, [](const auto &sample1, const auto &sample2) {
                 /// @todo: validate resolution
-                return std::abs(it1.x() - it2.x()) > 2 * LOCALHOST_SERVER_RESOLUTION;
+                return std::abs(sample1.t() - sample2.t()) > 2 * LOCALHOST_SERVER_RESOLUTION;
             });
 
-        if (dataHoleIt != dataIts.second) {
+        if (dataHoleIt != dataEnd) {
             qCInfo(LOG_FuzzingValidators()).noquote()
                 << message << "FAIL: the data in the defined range are inconsistent (data hole "
                               "found between times "
-                << toDateString(dataHoleIt->x()) << "and " << toDateString((dataHoleIt + 1)->x())
-                << ")";
+                << toDateString(dataHoleIt->t()) << "and "
+                << toDateString(std::next(dataHoleIt)->t()) << ")";
             QFAIL("");
         }
 
         // Checks values
-        auto dataIndex = 0;
-        for (auto dataIt = dataIts.first; dataIt != dataIts.second; ++dataIt, ++dataIndex) {
-            auto xAxisData = dataIt->x();
-            auto valuesData = dataIt->values();
-            for (auto valueIndex = 0, valueEnd = valuesData.size(); valueIndex < valueEnd;
+        for (auto dataIt = dataBegin; dataIt != dataEnd; ++dataIt) {
+            auto xAxisData = dataIt->t();
+            const auto &vector = dataIt->v();
+            auto valuesData = std::array<double, 3>{vector.x, vector.y, vector.z};
+            for (auto valueIndex = 0, valueEnd = int(valuesData.size()); valueIndex < valueEnd;
                  ++valueIndex) {
                 auto value = valuesData.at(valueIndex);
                 auto expectedValue = xAxisData + valueIndex * LOCALHOST_SERVER_RESOLUTION
@@ -163,8 +172,8 @@ DataValidatorHelper &DataValidatorHelper::instance()
  * @param getVariableRangeFun the function to retrieve the range from the variable
  * @remarks if the variable is null, checks that the expected range is the invalid range
  */
-void validateRange(std::shared_ptr<Variable> variable, const DateTimeRange &expectedRange,
-                   std::function<DateTimeRange(const Variable &)> getVariableRangeFun)
+void validateRange(std::shared_ptr<Variable2> variable, const DateTimeRange &expectedRange,
+                   std::function<DateTimeRange(const Variable2 &)> getVariableRangeFun)
 {
     auto compare = [](const auto &range, const auto &expectedRange, const auto &message) {
         if (range == expectedRange) {
@@ -214,7 +223,7 @@ std::unique_ptr<IFuzzingValidator> FuzzingValidatorFactory::create(FuzzingValida
             });
         case FuzzingValidatorType::RANGE:
             return std::make_unique<FuzzingValidator>([](const VariableState &variableState) {
-                auto getVariableRange = [](const Variable &variable) { return variable.range(); };
+                auto getVariableRange = [](const Variable2 &variable) { return variable.range(); };
                 validateRange(variableState.m_Variable, variableState.m_Range, getVariableRange);
             });
         default:
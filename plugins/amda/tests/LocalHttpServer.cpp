@@ -0,0 +1,66 @@
+#include "LocalHttpServer.h"
+
+#include <QTcpSocket>
+
+LocalHttpServer::LocalHttpServer()
+{
+    m_Server.listen(QHostAddress::LocalHost);
+    QObject::connect(&m_Server, &QTcpServer::newConnection, [this]() {
+        while (auto socket = m_Server.nextPendingConnection()) {
+            QObject::connect(socket, &QTcpSocket::readyRead, [this, socket]() { answer(*socket); });
+            QObject::connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
+        }
+    });
+}
+
+void LocalHttpServer::setContent(const QString &path, QByteArray content)
+{
+    setHandler(path, [content](const QUrl &) { return content; });
+}
+
+void LocalHttpServer::setHandler(const QString &path, Handler handler)
+{
+    m_Handlers[path] = std::move(handler);
+}
+
+QUrl LocalHttpServer::url(const QString &path) const
+{
+    return QUrl{QString{"http://%1%2"}.arg(hostAndPort(), path)};
+}
+
+QString LocalHttpServer::hostAndPort() const
+{
+    return QString{"127.0.0.1:%1"}.arg(m_Server.serverPort());
+}
+
+int LocalHttpServer::requestCount(const QString &path) const
+{
+    return m_RequestCounts.value(path);
+}
+
+void LocalHttpServer::answer(QTcpSocket &socket)
+{
+    // Waits for the whole header of the request
+    auto &request = m_Requests[&socket];
+    request += socket.readAll();
+    if (!request.contains("\r\n\r\n")) {
+        return;
+    }
+
+    // Request line: GET <path>?<query> HTTP/1.1
+    auto requestUrl = url(QString::fromLatin1(request.split(' ').value(1)));
+    auto path = requestUrl.path();
+    ++m_RequestCounts[path];
+
+    auto handlerIt = m_Handlers.find(path);
+    auto isFound = handlerIt != m_Handlers.end();
+    auto content = isFound ? (*handlerIt)(requestUrl) : QByteArray{"Not Found"};
+    auto status = isFound ? "200 OK" : "404 Not Found";
+
+    socket.write(QByteArray{"HTTP/1.1 "} + status
+                 + "\r\nContent-Type: application/octet-stream\r\nContent-Length: "
+                 + QByteArray::number(content.size()) + "\r\nConnection: close\r\n\r\n");
+    socket.write(content);
+    socket.disconnectFromHost();
+    m_Requests.remove(&socket);
+}
@@ -0,0 +1,45 @@
+#ifndef SCIQLOP_LOCALHTTPSERVER_H
+#define SCIQLOP_LOCALHTTPSERVER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QTcpServer>
+#include <QUrl>
+
+#include <functional>
+
+class QTcpSocket;
+
+/**
+ * Local HTTP server used in tests to simulate the AMDA server. The content served for a path is
+ * either set once or generated by a handler from the url requested. Other paths are answered with
+ * 404
+ */
+class LocalHttpServer {
+public:
+    /// Function generating the content served for a request
+    using Handler = std::function<QByteArray(const QUrl &url)>;
+
+    explicit LocalHttpServer();
+
+    void setContent(const QString &path, QByteArray content);
+    void setHandler(const QString &path, Handler handler);
+
+    /// @return the url of a path of the server
+    QUrl url(const QString &path) const;
+    /// @return the host and port of the server (e.g. 127.0.0.1:6543)
+    QString hostAndPort() const;
+
+    /// @return the number of requests received for a path
+    int requestCount(const QString &path) const;
+
+private:
+    void answer(QTcpSocket &socket);
+
+    QTcpServer m_Server{};
+    QHash<QString, Handler> m_Handlers{};
+    QHash<QString, int> m_RequestCounts{};
+    QHash<QTcpSocket *, QByteArray> m_Requests{};
+};
+
+#endif // SCIQLOP_LOCALHTTPSERVER_H
@@ -1,18 +1,19 @@
 #include "AmdaProvider.h"
 #include "AmdaResultParser.h"
+#include "LocalHttpServer.h"
 
 #include "SqpApplication.h"
-#include <Data/DataSeries.h>
-#include <Data/IDataSeries.h>
-#include <Data/ScalarSeries.h>
-#include <Time/TimeController.h>
-#include <Variable/Variable.h>
+#include <Common/DateUtils.h>
+#include <Data/ScalarTimeSerie.h>
+#include <Variable/Variable2.h>
 #include <Variable/VariableController2.h>
 
 #include <QObject>
 #include <QtTest>
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 // TEST with REF:
 // AmdaData-2012-01-01-12-00-00_2012-01-03-12-00-00
@@ -29,36 +30,55 @@ namespace {
 const auto TESTS_RESOURCES_PATH
     = QFileInfo{QString{AMDA_TESTS_RESOURCES_DIR}, "TestAmdaAcquisition"}.absoluteFilePath();
 
-/// Delay after each operation on the variable before validating it (in ms)
-const auto OPERATION_DELAY = 10000;
+/// Paths of the requests to the local AMDA server
+const auto TOKEN_PATH = QStringLiteral("/php/rest/auth.php");
+const auto PARAMETER_PATH = QStringLiteral("/php/rest/getParameter.php");
+const auto DATA_FILE_PATH = QStringLiteral("/data.txt");
 
-template <typename T>
-bool compareDataSeries(std::shared_ptr<IDataSeries> candidate, DateTimeRange candidateCacheRange,
-                       std::shared_ptr<IDataSeries> reference)
-{
-    auto compareLambda = [](const auto &it1, const auto &it2) {
-        return (it1.x() == it2.x()) && (it1.value() == it2.value());
-    };
-
-    auto candidateDS = std::dynamic_pointer_cast<T>(candidate);
-    auto referenceDS = std::dynamic_pointer_cast<T>(reference);
+/// Timeout of an operation on the variable, before validating it (in ms)
+const auto OPERATION_TIMEOUT = 30000;
 
-    if (candidateDS && referenceDS) {
+using Samples = std::vector<std::pair<double, double> >;
 
-        auto itRefs
-            = referenceDS->xAxisRange(candidateCacheRange.m_TStart, candidateCacheRange.m_TEnd);
-        qDebug() << " DISTANCE" << std::distance(candidateDS->cbegin(), candidateDS->cend())
-                 << std::distance(itRefs.first, itRefs.second);
-
-        return std::equal(candidateDS->cbegin(), candidateDS->cend(), itRefs.first, itRefs.second,
-                          compareLambda);
-    }
-    else {
-        return false;
+/// @return the samples of a serie that are in a range
+Samples samplesInRange(const ScalarTimeSerie &serie, const DateTimeRange &range)
+{
+    auto result = Samples{};
+    for (const auto &sample : serie) {
+        if (sample.t() >= range.m_TStart && sample.t() <= range.m_TEnd) {
+            result.emplace_back(sample.t(), sample.v());
+        }
     }
+    return result;
 }
+
+/// Sets the handlers simulating AMDA on the server: whatever the range requested, the data file
+/// generated is the reference file, that the provider trims to the range
+void simulateAmda(LocalHttpServer &server, const QString &dataFilePath)
+{
+    QFile dataFile{dataFilePath};
+    dataFile.open(QFile::ReadOnly);
+
+    server.setContent(TOKEN_PATH, QByteArray{"token"});
+    server.setContent(DATA_FILE_PATH, dataFile.readAll());
+    server.setHandler(PARAMETER_PATH, [&server](const QUrl &) {
+        return QByteArray{"{\"success\":true,\"dataFileURLs\":\""}
+               + server.url(DATA_FILE_PATH).toEncoded() + "\"}";
+    });
 }
 
+/// Waits for the variable to be at a range and for its data to be loaded
+void waitForRange(const std::shared_ptr<Variable2> &variable, const DateTimeRange &range)
+{
+    // Range changes are issued at the end of the current event loop iteration
+    QCoreApplication::processEvents();
+    QTRY_VERIFY_WITH_TIMEOUT(sqpApp->variableController().isReady(variable)
+                                 && variable->range() == range,
+                             OPERATION_TIMEOUT);
+}
+
+} // namespace
+
 class TestAmdaAcquisition : public QObject {
     Q_OBJECT
 
@@ -87,7 +107,6 @@ void TestAmdaAcquisition::testAcquisition_data()
             QDateTime{{year, month, day}, {hours, minutes, seconds}, Qt::UTC});
     };
 
-
     QTest::newRow("amda")
         << "AmdaData-2012-01-01-12-00-00_2012-01-03-12-00-00.txt"
         << DateTimeRange{dateTime(2012, 1, 2, 2, 3, 0), dateTime(2012, 1, 2, 2, 4, 0)}
@@ -97,55 +116,56 @@ void TestAmdaAcquisition::testAcquisition_data()
                // 3 : pan (jump) right for four min
                DateTimeRange{dateTime(2012, 1, 2, 2, 5, 0), dateTime(2012, 1, 2, 2, 6, 0)},
                // 4 : pan (overlay) right for 30 sec
-               /*SqpRange{dateTime(2012, 1, 2, 2, 5, 30), dateTime(2012, 1, 2, 2, 6, 30)},
+               DateTimeRange{dateTime(2012, 1, 2, 2, 5, 30), dateTime(2012, 1, 2, 2, 6, 30)},
                // 5 : pan (overlay) left for 30 sec
-               SqpRange{dateTime(2012, 1, 2, 2, 5, 0), dateTime(2012, 1, 2, 2, 6, 0)},
-        // 6 : pan (overlay) left for 30 sec - BIS
-        SqpRange{dateTime(2012, 1, 2, 2, 4, 30), dateTime(2012, 1, 2, 2, 5, 30)},
-        // 7 : Zoom in Inside 20 sec range
-        SqpRange{dateTime(2012, 1, 2, 2, 4, 50), dateTime(2012, 1, 2, 2, 5, 10)},
-        // 8 : Zoom out Inside 20 sec range
-        SqpRange{dateTime(2012, 1, 2, 2, 4, 30), dateTime(2012, 1, 2, 2, 5, 30)}*/};
+               DateTimeRange{dateTime(2012, 1, 2, 2, 5, 0), dateTime(2012, 1, 2, 2, 6, 0)},
+               // 6 : pan (overlay) left for 30 sec - BIS
+               DateTimeRange{dateTime(2012, 1, 2, 2, 4, 30), dateTime(2012, 1, 2, 2, 5, 30)},
+               // 7 : Zoom in Inside 20 sec range
+               DateTimeRange{dateTime(2012, 1, 2, 2, 4, 50), dateTime(2012, 1, 2, 2, 5, 10)},
+               // 8 : Zoom out Inside 20 sec range
+               DateTimeRange{dateTime(2012, 1, 2, 2, 4, 30), dateTime(2012, 1, 2, 2, 5, 30)}};
 }
 
 void TestAmdaAcquisition::testAcquisition()
 {
-    /// @todo: update test to be compatible with AMDA v2
-
     // Retrieves data file
     QFETCH(QString, dataFilename);
     auto filePath = QFileInfo{TESTS_RESOURCES_PATH, dataFilename}.absoluteFilePath();
-    auto results = AmdaResultParser::readTxt(filePath, DataSeriesType::SCALAR);
+    auto results = std::dynamic_pointer_cast<ScalarTimeSerie>(
+        AmdaResultParser::readTxt(filePath, DataSeriesType::SCALAR));
+    QVERIFY(results != nullptr);
+
+    // The server answers in this thread, which keeps processing events while waiting for the
+    // variable
+    LocalHttpServer server{};
+    simulateAmda(server, filePath);
 
     /// Lambda used to validate a variable at each step
-    auto validateVariable = [results](std::shared_ptr<Variable> variable, const DateTimeRange &range) {
-        // Checks that the variable's range has changed
-        qInfo() << tr("Compare var range vs range") << variable->range() << range;
-        QCOMPARE(variable->range(), range);
-
-        // Checks the variable's data series
-        QVERIFY(compareDataSeries<ScalarSeries>(variable->dataSeries(), variable->cacheRange(),
-                                                results));
-        qInfo() << "\n";
+    auto validateVariable = [results](std::shared_ptr<Variable2> variable,
+                                      const DateTimeRange &range) {
+        waitForRange(variable, range);
+
+        // Checks the variable's data in its range
+        auto data = std::dynamic_pointer_cast<ScalarTimeSerie>(variable->data());
+        QVERIFY(data != nullptr);
+        auto expectedSamples = samplesInRange(*results, range);
+        QVERIFY(!expectedSamples.empty());
+        QCOMPARE(samplesInRange(*data, range), expectedSamples);
     };
 
     // Creates variable
     QFETCH(DateTimeRange, initialRange);
-    sqpApp->timeController().setDateTimeRange(initialRange);
-    auto provider = std::make_shared<AmdaProvider>();
+    auto provider = std::make_shared<AmdaProvider>(server.hostAndPort());
     auto variable = sqpApp->variableController().createVariable(
-        "bx_gse", {{"dataType", "scalar"}, {"xml:id", "imf(0)"}}, provider, initialRange);
-
-    QTest::qWait(OPERATION_DELAY);
+        "bx_gse", {{"dataType", "scalar"}, {"xml:id", "imf(0)"}, {"timeFormat", "ISO8601"}},
+        provider, initialRange);
     validateVariable(variable, initialRange);
 
     // Makes operations on the variable
     QFETCH(std::vector<DateTimeRange>, operations);
     for (const auto &operation : operations) {
-        // Asks request on the variable and waits during its execution
-        sqpApp->variableController().changeRange({variable}, operation);
-
-        QTest::qWait(OPERATION_DELAY);
+        sqpApp->variableController().asyncChangeRange(variable, operation);
         validateVariable(variable, operation);
     }
 }
@@ -159,6 +179,4 @@ int main(int argc, char *argv[])
     return QTest::qExec(&tc, argc, argv);
 }
 
-// QTEST_MAIN(TestAmdaAcquisition)
-
 #include "TestAmdaAcquisition.moc"
@@ -0,0 +1,170 @@
+#include "AmdaDataDownloader.h"
+#include "AmdaResultParser.h"
+#include "AmdaResultStreamParser.h"
+#include "LocalHttpServer.h"
+
+#include <Data/ScalarTimeSerie.h>
+
+#include <QObject>
+#include <QtTest>
+
+#include <zlib.h>
+
+#include <cmath>
+#include <memory>
+
+namespace {
+
+/// Path for the tests
+const auto TESTS_RESOURCES_PATH
+    = QFileInfo{QString{AMDA_TESTS_RESOURCES_DIR}, "TestAmdaResultParser"}.absoluteFilePath();
+
+/// Maximum number of bytes downloaded but not read yet
+const auto BUFFER_SIZE = std::size_t{64 * 1024};
+
+QByteArray readFile(const QString &fileName)
+{
+    QFile file{QFileInfo{TESTS_RESOURCES_PATH, fileName}.absoluteFilePath()};
+    return file.open(QFile::ReadOnly) ? file.readAll() : QByteArray{};
+}
+
+/// Generates an AMDA file of scalars, one value per second
+QByteArray generateFile(int lineCount)
+{
+    const auto start = QDateTime{{2013, 9, 23}, {0, 0, 0}, Qt::UTC};
+
+    auto result = QByteArray{"#imf(0) - Type : Local Parameter @ CDPP/AMDA - Name : bx_gse - "
+                             "Units : nT - Size : 1 - Frame : GSE - Mission : ACE\n"};
+    for (auto i = 0; i < lineCount; ++i) {
+        result += start.addSecs(i).toString(QStringLiteral("yyyy-MM-ddThh:mm:ss.zzz")).toLatin1();
+        result += "     " + QByteArray::number(std::cos(i * 0.01), 'f', 5) + '\n';
+    }
+    return result;
+}
+
+/// Compresses data with gzip. The data is split in as many gzip members as wanted
+QByteArray gzip(const QByteArray &data, int memberCount = 1)
+{
+    auto result = QByteArray{};
+    auto memberSize = data.size() / memberCount + 1;
+    for (auto i = 0; i < data.size(); i += memberSize) {
+        auto member = data.mid(i, memberSize);
+
+        auto stream = z_stream{};
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8,
+                     Z_DEFAULT_STRATEGY);
+        auto compressedMember = QByteArray(static_cast<int>(deflateBound(&stream, member.size())),
+                                           Qt::Uninitialized);
+        stream.next_in = reinterpret_cast<Bytef *>(member.data());
+        stream.avail_in = static_cast<uInt>(member.size());
+        stream.next_out = reinterpret_cast<Bytef *>(compressedMember.data());
+        stream.avail_out = static_cast<uInt>(compressedMember.size());
+        deflate(&stream, Z_FINISH);
+        compressedMember.resize(static_cast<int>(stream.total_out));
+        deflateEnd(&stream);
+
+        result += compressedMember;
+    }
+    return result;
+}
+
+} // namespace
+
+class TestAmdaDataDownloader : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// Input test data
+    /// @sa testDownloadAndRead()
+    void testDownloadAndRead_data();
+
+    /// Tests that a file, compressed or not, is read the same way once downloaded as when it is
+    /// read from the disk. Logs the time taken to download and read it
+    void testDownloadAndRead();
+
+    /// Tests that corrupted compressed data and missing files are reported as errors
+    void testDownloadInvalidFile();
+};
+
+void TestAmdaDataDownloader::testDownloadAndRead_data()
+{
+    // ////////////// //
+    // Test structure //
+    // ////////////// //
+
+    // Content of the file, as read from the disk
+    QTest::addColumn<QByteArray>("fileContent");
+    // Content of the file, as served
+    QTest::addColumn<QByteArray>("servedContent");
+
+    // ////////// //
+    // Test cases //
+    // ////////// //
+
+    auto validFile = readFile(QStringLiteral("ValidScalar1.txt"));
+    QTest::newRow("Valid file") << validFile << validFile;
+    QTest::newRow("Valid file (compressed)") << validFile << gzip(validFile);
+    QTest::newRow("Valid file (compressed in several members)") << validFile << gzip(validFile, 3);
+
+    auto wrongFile = readFile(QStringLiteral("WrongDate.txt"));
+    QTest::newRow("Wrong results file (compressed)") << wrongFile << gzip(wrongFile);
+
+    auto largeFile = generateFile(500000);
+    QTest::newRow("Large file") << largeFile << largeFile;
+    QTest::newRow("Large file (compressed)") << largeFile << gzip(largeFile);
+}
+
+void TestAmdaDataDownloader::testDownloadAndRead()
+{
+    QFETCH(QByteArray, fileContent);
+    QFETCH(QByteArray, servedContent);
+
+    LocalHttpServer server{};
+    server.setContent(QStringLiteral("/data.txt"), servedContent);
+
+    QElapsedTimer timer{};
+    timer.start();
+
+    AmdaResultStreamParser parser{DataSeriesType::SCALAR, BUFFER_SIZE};
+    QVERIFY(AmdaDataDownloader::downloadAndRead(server.url(QStringLiteral("/data.txt")), parser,
+                                                BUFFER_SIZE));
+    auto results = std::unique_ptr<TimeSeries::ITimeSerie>{parser.createSeries()};
+
+    auto elapsed = timer.elapsed();
+    qInfo() << QString{"%1 KB transferred (%2 KB read) in %3 ms"}
+                   .arg(servedContent.size() / 1024)
+                   .arg(fileContent.size() / 1024)
+                   .arg(elapsed);
+
+    auto expectedResults = std::unique_ptr<TimeSeries::ITimeSerie>{
+        AmdaResultParser::readTxt(fileContent, DataSeriesType::SCALAR)};
+    auto serie = dynamic_cast<ScalarTimeSerie *>(results.get());
+    auto expectedSerie = dynamic_cast<ScalarTimeSerie *>(expectedResults.get());
+    QVERIFY(serie != nullptr);
+    QVERIFY(expectedSerie != nullptr);
+    QVERIFY(std::equal(std::begin(*serie), std::end(*serie), std::begin(*expectedSerie),
+                       std::end(*expectedSerie), [](const auto &sample, const auto &expected) {
+                           return sample.t() == expected.t() && sample.v() == expected.v();
+                       }));
+}
+
+void TestAmdaDataDownloader::testDownloadInvalidFile()
+{
+    auto compressedFile = gzip(readFile(QStringLiteral("ValidScalar1.txt")));
+
+    LocalHttpServer server{};
+    server.setContent(QStringLiteral("/truncated.txt"),
+                      compressedFile.left(compressedFile.size() / 2));
+    auto corruptedFile = compressedFile;
+    corruptedFile[20] = ~corruptedFile[20];
+    server.setContent(QStringLiteral("/corrupted.txt"), corruptedFile);
+
+    for (const auto &path : {"/truncated.txt", "/corrupted.txt", "/missing.txt"}) {
+        AmdaResultStreamParser parser{DataSeriesType::SCALAR, BUFFER_SIZE};
+        QVERIFY(!AmdaDataDownloader::downloadAndRead(server.url(QString{path}), parser,
+                                                     BUFFER_SIZE));
+    }
+}
+
+QTEST_MAIN(TestAmdaDataDownloader)
+#include "TestAmdaDataDownloader.moc"
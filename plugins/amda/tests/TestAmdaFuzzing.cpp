@@ -5,18 +5,16 @@
 
 #include "AmdaProvider.h"
 
-#include <Common/SignalWaiter.h>
-#include <Network/NetworkController.h>
 #include <Settings/SqpSettingsDefs.h>
 #include <SqpApplication.h>
-#include <Time/TimeController.h>
-#include <Variable/Variable.h>
+#include <Variable/Variable2.h>
 #include <Variable/VariableController2.h>
 
 #include <QLoggingCategory>
 #include <QObject>
 #include <QtTest>
 
+#include <algorithm>
 #include <memory>
 
 Q_LOGGING_CATEGORY(LOG_TestAmdaFuzzing, "TestAmdaFuzzing")
@@ -168,6 +166,15 @@ void validate(const VariablesPool &variablesPool, const Validators &validators)
     }
 }
 
+/// @return true if all the variables of the pool have their data loaded
+bool isAcquisitionFinished(const VariablesPool &variablesPool)
+{
+    return std::all_of(variablesPool.cbegin(), variablesPool.cend(), [](const auto &entry) {
+        const auto &variable = entry.second.m_Variable;
+        return variable == nullptr || sqpApp->variableController().isReady(variable);
+    });
+}
+
 /**
  * Class to run random tests
  */
@@ -183,10 +190,9 @@ public:
             m_FuzzingState.m_VariablesPool[variableId] = VariableState{};
         }
 
-        // Inits sync groups and registers them into the variable controller
+        // Inits sync groups. The variables of a group are moved together by the operations
         for (auto i = 0; i < nbMaxSyncGroups(); ++i) {
             auto syncGroupId = SyncGroupId::createUuid();
-            //variableController.onAddSynchronizationGroupId(syncGroupId);
             m_FuzzingState.m_SyncGroupsPool[syncGroupId] = SyncGroup{};
         }
     }
@@ -229,13 +235,15 @@ public:
                 auto waitAcquisition = nextValidationCounter == 0
                                        || operationsPool().at(fuzzingOperation).m_WaitAcquisition;
 
-//                fuzzingOperation->execute(variableId, m_FuzzingState, m_VariableController,
-//                                          m_Properties);
+                fuzzingOperation->execute(variableId, m_FuzzingState, m_VariableController,
+                                          m_Properties);
 
                 if (waitAcquisition) {
                     qCDebug(LOG_TestAmdaFuzzing()) << "Waiting for acquisition to finish...";
-                    SignalWaiter{m_VariableController, SIGNAL(acquisitionFinished())}.wait(
-                        acquisitionTimeout());
+                    // Range changes are issued at the end of the current event loop iteration
+                    QCoreApplication::processEvents();
+                    QTRY_VERIFY_WITH_TIMEOUT(isAcquisitionFinished(m_FuzzingState.m_VariablesPool),
+                                             acquisitionTimeout());
 
                     // Validates variables
                     if (nextValidationCounter == 0) {
@@ -342,7 +350,6 @@ void TestAmdaFuzzing::testFuzzing()
     settings.setValue(GENERAL_TOLERANCE_AT_UPDATE_KEY, cacheTolerance);
 
     auto &variableController = sqpApp->variableController();
-    auto &timeController = sqpApp->timeController();
 
     // Generates random initial range (bounded to max range)
     auto maxRange = properties.value(MAX_RANGE_PROPERTY, QVariant::fromValue(INVALID_RANGE))
@@ -358,10 +365,9 @@ void TestAmdaFuzzing::testFuzzing()
         std::swap(initialRangeStart, initialRangeEnd);
     }
 
-    // Sets initial range on time controller
+    // Sets initial range of the variables created
     DateTimeRange initialRange{initialRangeStart, initialRangeEnd};
     qCInfo(LOG_TestAmdaFuzzing()).noquote() << "Setting initial range to" << initialRange << "...";
-    timeController.setDateTimeRange(initialRange);
     properties.insert(INITIAL_RANGE_PROPERTY, QVariant::fromValue(initialRange));
 
     FuzzingTest test{variableController, properties};
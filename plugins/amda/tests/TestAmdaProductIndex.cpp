@@ -0,0 +1,312 @@
+#include "AmdaDefs.h"
+#include "AmdaParser.h"
+#include "AmdaProductIndex.h"
+#include "AmdaProductLoader.h"
+
+#include <DataSource/DataSourceItem.h>
+
+#include <QObject>
+#include <QtTest>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace {
+
+/// Path for the tests
+const auto TESTS_RESOURCES_PATH
+    = QFileInfo{QString{AMDA_TESTS_RESOURCES_DIR}, "TestAmdaParser"}.absoluteFilePath();
+
+QString inputFilePath(const QString &inputFileName)
+{
+    return QFileInfo{TESTS_RESOURCES_PATH, inputFileName}.absoluteFilePath();
+}
+
+QByteArray readFile(const QString &inputFileName)
+{
+    QFile file{inputFilePath(inputFileName)};
+    return file.open(QFile::ReadOnly) ? file.readAll() : QByteArray{};
+}
+
+/// Creates the whole tree of a node of an index
+std::unique_ptr<DataSourceItem> createTree(const AmdaProductIndex &index, int node)
+{
+    auto item = index.createItem(node);
+    for (auto child : index.children(node)) {
+        item->appendChild(createTree(index, child));
+    }
+    return item;
+}
+
+/// Maximum number of matching items that creates all of them
+const auto ALL_MATCHES = std::numeric_limits<int>::max();
+
+/// @return the filter accepting the values containing a text
+DataSourceItemLoader::FilterFunction containsFilter(const QString &text)
+{
+    return [text](const QVariant &value) { return value.toString().contains(text); };
+}
+
+} // namespace
+
+class TestAmdaProductIndex : public QObject {
+    Q_OBJECT
+private slots:
+    /// Input test data
+    /// @sa testFromJson()
+    void testFromJson_data();
+
+    /// Tests that an index creates the same items as AmdaParser::readJson()
+    void testFromJson();
+
+    /// Tests writing an index and reading it back
+    void testReadWrite();
+
+    /// Tests that an index is cached, and that the cache is ignored when the file changes
+    void testReadIndex();
+
+    /// Tests finding the nodes of an index
+    void testFind();
+
+    /// Tests the creation of the items of the tree on demand
+    void testLoader();
+};
+
+void TestAmdaProductIndex::testFromJson_data()
+{
+    // ////////////// //
+    // Test structure //
+    // ////////////// //
+
+    // Content of the JSON file
+    QTest::addColumn<QByteArray>("json");
+
+    // ////////// //
+    // Test cases //
+    // ////////// //
+
+    QTest::newRow("Valid file") << readFile(QStringLiteral("ValidFile1.json"));
+    QTest::newRow("Arrays of objects and values")
+        << QByteArray{R"({"dataCenter": {"name": "AMDA", "mission": [{"name": "m1"}, {"name": )"
+                      R"("m2", "instrument": [[{"name": "i1"}], {"name": "i2"}]}], "desc": )"
+                      R"(["a", ["b", "c"]]}})"};
+    QTest::newRow("Children of several keys")
+        << QByteArray{R"({"dataCenter": {"zz": {"name": "z"}, "parameter": {"name": "p", )"
+                      R"("component": {"name": "c"}}, "aa": [{"name": "a1"}, {"name": "a2"}]}})"};
+    QTest::newRow("Escaped strings, numbers and booleans")
+        << QByteArray{R"({"other": [1, {"a": true}], "dataCenter": {"name": )"
+                      R"("A\"\\\/\n\u00e9\ud83d\ude00", "rank": -1.5e2, "available": false, )"
+                      "\"utf8\": \"\xc3\xa9t\xc3\xa9\"}}"};
+    QTest::newRow("Empty root") << QByteArray{R"({"dataCenter": {}})"};
+
+    // Invalid files
+    QTest::newRow("Invalid file (two root objects)")
+        << readFile(QStringLiteral("TwoRootsFile.json"));
+    QTest::newRow("Invalid file (wrong root key)") << readFile(QStringLiteral("WrongRootKey.json"));
+    QTest::newRow("Invalid file (wrong root type)")
+        << readFile(QStringLiteral("WrongRootType.json"));
+    QTest::newRow("Invalid file (trailing characters)")
+        << QByteArray{R"({"dataCenter": {"name": "AMDA"}} {})"};
+    QTest::newRow("Invalid file (unterminated string)")
+        << QByteArray{R"({"dataCenter": {"name": "AMDA}})"};
+    QTest::newRow("Invalid file (wrong value)") << QByteArray{R"({"dataCenter": {"name": AMDA}})"};
+    QTest::newRow("Invalid file (empty)") << QByteArray{};
+}
+
+void TestAmdaProductIndex::testFromJson()
+{
+    QFETCH(QByteArray, json);
+
+    // Reads the file with the JSON document, to get the expected items
+    QTemporaryFile file{};
+    QVERIFY(file.open());
+    QVERIFY(file.write(json) == json.size());
+    file.close();
+    auto expectedItem = AmdaParser::readJson(file.fileName());
+
+    auto index = AmdaProductIndex::fromJson(json);
+    if (expectedItem) {
+        QVERIFY(index != nullptr);
+        QCOMPARE(index->sourceHash(), AmdaProductIndex::sourceHash(json));
+        QVERIFY(*createTree(*index, index->root()) == *expectedItem);
+    }
+    else {
+        QVERIFY(index == nullptr);
+    }
+}
+
+void TestAmdaProductIndex::testReadWrite()
+{
+    auto index = AmdaProductIndex::fromJson(readFile(QStringLiteral("ValidFile1.json")));
+    QVERIFY(index != nullptr);
+
+    QBuffer buffer{};
+    QVERIFY(buffer.open(QIODevice::ReadWrite));
+    QDataStream stream{&buffer};
+    index->write(stream);
+
+    buffer.seek(0);
+    auto readIndex = AmdaProductIndex::read(stream);
+    QVERIFY(readIndex != nullptr);
+    QCOMPARE(readIndex->sourceHash(), index->sourceHash());
+    QCOMPARE(readIndex->size(), index->size());
+    QVERIFY(*createTree(*readIndex, readIndex->root()) == *createTree(*index, index->root()));
+
+    // Truncated or damaged indexes can't be read
+    auto data = buffer.data();
+    for (auto size : {0, 8, data.size() / 2, data.size() - 1}) {
+        auto truncatedData = data.left(size);
+        QDataStream truncatedStream{truncatedData};
+        QVERIFY(AmdaProductIndex::read(truncatedStream) == nullptr);
+    }
+
+    auto damagedData = data;
+    damagedData[4] = damagedData[4] + 1;
+    QDataStream damagedStream{damagedData};
+    QVERIFY(AmdaProductIndex::read(damagedStream) == nullptr);
+}
+
+void TestAmdaProductIndex::testReadIndex()
+{
+    QTemporaryDir directory{};
+    QVERIFY(directory.isValid());
+    auto jsonFilePath = directory.filePath(QStringLiteral("tree.json"));
+    auto cacheFilePath = directory.filePath(QStringLiteral("cache/index.bin"));
+
+    auto writeJson = [&jsonFilePath](const QByteArray &json) {
+        QFile file{jsonFilePath};
+        return file.open(QFile::WriteOnly | QFile::Truncate) && file.write(json) == json.size();
+    };
+    auto rootName = [](const AmdaProductIndex &index) {
+        return index.value(index.root(), QStringLiteral("name")).toString();
+    };
+
+    // First read builds the index and caches it
+    QVERIFY(writeJson(R"({"dataCenter": {"name": "first"}})"));
+    auto index = AmdaParser::readIndex(jsonFilePath, cacheFilePath);
+    QVERIFY(index != nullptr);
+    QCOMPARE(rootName(*index), QStringLiteral("first"));
+    QVERIFY(QFile::exists(cacheFilePath));
+
+    // Next read uses the cache: it is detected by making the cache differ from the file, with
+    // the hash of the file
+    auto cachedIndex = AmdaProductIndex::fromJson(R"({"dataCenter": {"name": "cached"}})");
+    QVERIFY(cachedIndex != nullptr);
+    {
+        QBuffer buffer{};
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        QDataStream stream{&buffer};
+        cachedIndex->write(stream);
+
+        // Hash is written after the magic and the version, with its size
+        auto data = buffer.data();
+        auto hash = AmdaProductIndex::sourceHash(R"({"dataCenter": {"name": "first"}})");
+        data.replace(12, hash.size(), hash);
+
+        QFile cacheFile{cacheFilePath};
+        QVERIFY(cacheFile.open(QFile::WriteOnly | QFile::Truncate));
+        QVERIFY(cacheFile.write(data) == data.size());
+    }
+    index = AmdaParser::readIndex(jsonFilePath, cacheFilePath);
+    QVERIFY(index != nullptr);
+    QCOMPARE(rootName(*index), QStringLiteral("cached"));
+
+    // When the file changes, the cache is replaced
+    QVERIFY(writeJson(R"({"dataCenter": {"name": "second"}})"));
+    index = AmdaParser::readIndex(jsonFilePath, cacheFilePath);
+    QVERIFY(index != nullptr);
+    QCOMPARE(rootName(*index), QStringLiteral("second"));
+
+    QFile cacheFile{cacheFilePath};
+    QVERIFY(cacheFile.open(QFile::ReadOnly));
+    QDataStream stream{&cacheFile};
+    auto newCachedIndex = AmdaProductIndex::read(stream);
+    QVERIFY(newCachedIndex != nullptr);
+    QCOMPARE(rootName(*newCachedIndex), QStringLiteral("second"));
+
+    // Invalid files give no index
+    QVERIFY(writeJson(R"({"dataCenter": []})"));
+    QVERIFY(AmdaParser::readIndex(jsonFilePath, cacheFilePath) == nullptr);
+}
+
+void TestAmdaProductIndex::testFind()
+{
+    auto index = AmdaProductIndex::fromJson(readFile(QStringLiteral("ValidFile1.json")));
+    QVERIFY(index != nullptr);
+
+    // Product and its components
+    auto nodes = index->find(containsFilter(QStringLiteral("ice_b_cse")));
+    QCOMPARE(nodes.size(), std::size_t{4});
+    QVERIFY(std::is_sorted(nodes.cbegin(), nodes.cend()));
+    QVERIFY(index->createItem(nodes.front())->type() == DataSourceItemType::PRODUCT);
+    QCOMPARE(index->childCount(nodes.front()), 3);
+    for (auto it = nodes.cbegin() + 1; it != nodes.cend(); ++it) {
+        QVERIFY(index->createItem(*it)->type() == DataSourceItemType::COMPONENT);
+        QCOMPARE(index->parent(*it), nodes.front());
+    }
+
+    QVERIFY(index->find(containsFilter(QStringLiteral("unknown"))).empty());
+    QCOMPARE(index->find([](const auto &) { return true; }).size(),
+             static_cast<std::size_t>(index->size()));
+}
+
+void TestAmdaProductIndex::testLoader()
+{
+    auto index = AmdaProductIndex::fromJson(readFile(QStringLiteral("ValidFile1.json")));
+    QVERIFY(index != nullptr);
+
+    auto loader = std::make_shared<AmdaProductLoader>(std::move(index), QUuid::createUuid());
+    DataSourceItemLoader::registerLoader(AmdaProductLoader::NAME, loader);
+
+    auto root = loader->createRootItem();
+    QCOMPARE(root->childCount(), 0);
+    QVERIFY(DataSourceItemLoader::loader(*root) == loader);
+    QVERIFY(loader->canLoadChildren(*root));
+
+    // Searching a component creates it and the items above it, but not its siblings
+    loader->loadMatchingItems(*root, containsFilter(QStringLiteral("Bz")), ALL_MATCHES);
+    auto item = root.get();
+    for (auto name : {"ICE@Giacobini-Zinner", "MAG", "Magnetic Field", "B_cse", "Bz"}) {
+        QCOMPARE(item->childCount(), 1);
+        item = item->child(0);
+        QCOMPARE(item->name(), QString{name});
+    }
+    QVERIFY(item->type() == DataSourceItemType::COMPONENT);
+    QCOMPARE(item->actions().size(), 1);
+    QCOMPARE(item->data(DataSourceItem::ID_DATA_KEY).toString(), QStringLiteral("ice_b_cse(2)"));
+
+    // Sampling of the dataset is passed down to its components
+    QCOMPARE(item->data(AMDA_SAMPLING_KEY).toString(), QStringLiteral("0.3s"));
+
+    // Searching again doesn't duplicate items
+    loader->loadMatchingItems(*root, containsFilter(QStringLiteral("Bz")), ALL_MATCHES);
+    QCOMPARE(root->childCount(), 1);
+
+    // Loading the children of the product creates the other components only
+    auto product = item->parentItem();
+    QVERIFY(loader->canLoadChildren(*product));
+    loader->loadChildren(*product);
+    QCOMPARE(product->childCount(), 3);
+    QVERIFY(!loader->canLoadChildren(*product));
+
+    // Loading the children of the dataset creates the other product
+    auto dataset = product->parentItem();
+    loader->loadChildren(*dataset);
+    QCOMPARE(dataset->childCount(), 2);
+    QVERIFY(!loader->canLoadChildren(*dataset));
+
+    // Searching creates at most the number of matching items asked: the product is found before
+    // its components
+    auto cappedRoot = loader->createRootItem();
+    loader->loadMatchingItems(*cappedRoot, containsFilter(QStringLiteral("ice_b_cse")), 1);
+    item = cappedRoot.get();
+    while (item->childCount() == 1) {
+        item = item->child(0);
+    }
+    QCOMPARE(item->childCount(), 0);
+    QVERIFY(item->type() == DataSourceItemType::PRODUCT);
+}
+
+QTEST_MAIN(TestAmdaProductIndex)
+#include "TestAmdaProductIndex.moc"
@@ -0,0 +1,299 @@
+#include "AmdaProvider.h"
+#include "LocalHttpServer.h"
+
+#include <Common/DateUtils.h>
+#include <Data/DataProviderParameters.h>
+#include <Data/ScalarTimeSerie.h>
+#include <Data/SpectrogramTimeSerie.h>
+
+#include <QObject>
+#include <QUrlQuery>
+#include <QtConcurrent/QtConcurrent>
+#include <QtTest>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// Paths of the requests to the local AMDA server
+const auto TOKEN_PATH = QStringLiteral("/php/rest/auth.php");
+const auto PARAMETER_PATH = QStringLiteral("/php/rest/getParameter.php");
+const auto DATA_FILE_PATH = QStringLiteral("/data.txt");
+
+const auto TOKEN = QStringLiteral("token");
+
+/// Id of the product whose data files are spectrograms. Data files of the other products are
+/// scalars
+const auto SPECTROGRAM_ID = QStringLiteral("spectro");
+
+/// Interval between two samples of the data files generated, in seconds
+const auto SAMPLING = 10.;
+
+/// Timeout of a request to the provider, in ms
+const auto REQUEST_TIMEOUT = 30000;
+
+double dateTime(int year, int month, int day, int hours, int minutes, int seconds)
+{
+    return DateUtils::secondsSinceEpoch(
+        QDateTime{{year, month, day}, {hours, minutes, seconds}, Qt::UTC});
+}
+
+double queryDate(const QUrlQuery &query, const QString &key)
+{
+    return DateUtils::secondsSinceEpoch(
+        QDateTime::fromString(query.queryItemValue(key) + QStringLiteral("Z"), Qt::ISODate));
+}
+
+/// Generates a data file whose values are their times, for the range of the query. The first and
+/// last samples of the range are included. Times are written in the format of the query.
+/// Spectrograms have two bands, whose values are the time and twice the time
+QByteArray generateDataFile(const QUrlQuery &query)
+{
+    auto isUnixTime = query.queryItemValue(QStringLiteral("timeFormat")) == "UNIXTIME";
+    auto isSpectrogram = query.queryItemValue(QStringLiteral("parameterID")) == SPECTROGRAM_ID;
+
+    auto result = isSpectrogram
+                      ? QByteArray{"#     DATASET_MIN_SAMPLING : 10\n"
+                                   "#     DATASET_MAX_SAMPLING : 10\n"
+                                   "#       PARAMETER_TABLE_MIN_VALUES[0] : 10.0,30.0\n"
+                                   "#       PARAMETER_TABLE_MAX_VALUES[0] : 30.0,50.0\n"}
+                      : QByteArray{"#imf(0) - Type : Local Parameter @ CDPP/AMDA - Name : bx_gse - "
+                                   "Units : nT - Size : 1 - Frame : GSE - Mission : ACE\n"};
+
+    auto end = queryDate(query, QStringLiteral("stopTime"));
+    for (auto t = std::ceil(queryDate(query, QStringLiteral("startTime")) / SAMPLING) * SAMPLING;
+         t <= end; t += SAMPLING) {
+        result += isUnixTime ? QByteArray::number(t, 'f', 3)
+                             : DateUtils::dateTime(t)
+                                   .toString(QStringLiteral("yyyy-MM-ddThh:mm:ss.zzz"))
+                                   .toLatin1();
+        result += "     " + QByteArray::number(t, 'f', 0);
+        if (isSpectrogram) {
+            result += "     " + QByteArray::number(2. * t, 'f', 0);
+        }
+        result += '\n';
+    }
+    return result;
+}
+
+/// Sets the handlers simulating AMDA on the server: a token, a data file generated for each
+/// request, and the data file itself
+/// @param failedRequestStart the start of the requests for which no data file is generated, if any
+/// @param requestedRanges if not null, the ranges of the requests are appended to it
+void simulateAmda(LocalHttpServer &server,
+                  double failedRequestStart = std::numeric_limits<double>::quiet_NaN(),
+                  std::vector<DateTimeRange> *requestedRanges = nullptr)
+{
+    server.setContent(TOKEN_PATH, TOKEN.toUtf8());
+    server.setHandler(PARAMETER_PATH, [&server, failedRequestStart,
+                                       requestedRanges](const QUrl &url) {
+        auto query = QUrlQuery{url};
+        if (requestedRanges) {
+            requestedRanges->push_back({queryDate(query, QStringLiteral("startTime")),
+                                        queryDate(query, QStringLiteral("stopTime"))});
+        }
+        if (query.queryItemValue(QStringLiteral("token")) != TOKEN
+            || queryDate(query, QStringLiteral("startTime")) == failedRequestStart) {
+            return QByteArray{"{\"success\":false}"};
+        }
+
+        auto dataFileUrl = server.url(DATA_FILE_PATH);
+        dataFileUrl.setQuery(query);
+        return QByteArray{"{\"success\":true,\"dataFileURLs\":\""}
+               + dataFileUrl.toEncoded() + "\"}";
+    });
+    server.setHandler(DATA_FILE_PATH,
+                      [](const QUrl &url) { return generateDataFile(QUrlQuery{url}); });
+}
+
+} // namespace
+
+class TestAmdaProvider : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// Input test data
+    /// @sa testGetData()
+    void testGetData_data();
+
+    /// Tests that the data of a range is fetched in one or several requests, and stitched in time
+    /// order without duplicates
+    void testGetData();
+
+    /// Tests that no data is returned when a request fails, rather than data with a hole
+    void testGetDataWithFailedRequest();
+
+    /// Tests that the requests of a range don't extend beyond it
+    void testGetDataRequestsOnlyItsRange();
+
+    /// Tests that the data of a spectrogram fetched in several requests is stitched in a
+    /// spectrogram serie, with the bands and the sampling of the data files
+    void testGetSpectrogram();
+};
+
+void TestAmdaProvider::testGetData_data()
+{
+    // ////////////// //
+    // Test structure //
+    // ////////////// //
+
+    // Range requested to the provider
+    QTest::addColumn<DateTimeRange>("range");
+    // Sampling of the product
+    QTest::addColumn<QString>("sampling");
+    // Time format of the data files of the product (empty to use the one of the settings)
+    QTest::addColumn<QString>("timeFormat");
+    // Number of requests expected to the AMDA server
+    QTest::addColumn<int>("expectedRequestCount");
+
+    // ////////// //
+    // Test cases //
+    // ////////// //
+
+    // Requests of products sampled every second last 28 hours (100000 samples, rounded up to
+    // hours), aligned on multiples of 28 hours since epoch
+    QTest::newRow("Range in one request")
+        << DateTimeRange{dateTime(2013, 9, 23, 9, 0, 0), dateTime(2013, 9, 23, 10, 0, 0)}
+        << QStringLiteral("1S") << QString{} << 1;
+    QTest::newRow("Range split in several requests")
+        << DateTimeRange{dateTime(2013, 9, 23, 9, 0, 0), dateTime(2013, 9, 27, 9, 0, 0)}
+        << QStringLiteral("1S") << QString{} << 5;
+    QTest::newRow("Range split in several requests (ISO 8601 dates)")
+        << DateTimeRange{dateTime(2013, 9, 23, 9, 0, 0), dateTime(2013, 9, 27, 9, 0, 0)}
+        << QStringLiteral("1S") << QStringLiteral("ISO8601") << 5;
+    QTest::newRow("Range split in several requests (epoch times)")
+        << DateTimeRange{dateTime(2013, 9, 23, 9, 0, 0), dateTime(2013, 9, 27, 9, 0, 0)}
+        << QStringLiteral("1S") << QStringLiteral("UNIXTIME") << 5;
+    QTest::newRow("Range of a product whose sampling is unknown (one request per day)")
+        << DateTimeRange{dateTime(2013, 9, 23, 9, 0, 0), dateTime(2013, 9, 25, 9, 0, 0)}
+        << QString{} << QString{} << 3;
+}
+
+void TestAmdaProvider::testGetData()
+{
+    QFETCH(DateTimeRange, range);
+    QFETCH(QString, sampling);
+    QFETCH(QString, timeFormat);
+    QFETCH(int, expectedRequestCount);
+
+    LocalHttpServer server{};
+    simulateAmda(server);
+
+    auto metaData = QVariantHash{{"dataType", "scalar"}, {"xml:id", "imf(0)"}};
+    if (!sampling.isEmpty()) {
+        metaData.insert(QStringLiteral("sampling"), sampling);
+    }
+    if (!timeFormat.isEmpty()) {
+        metaData.insert(QStringLiteral("timeFormat"), timeFormat);
+    }
+
+    // The server answers in this thread, so the provider is requested in another one
+    AmdaProvider provider{server.hostAndPort()};
+    auto future = QtConcurrent::run([&provider, range, metaData]() {
+        return provider.getData(DataProviderParameters{range, metaData});
+    });
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), REQUEST_TIMEOUT);
+
+    auto data = std::unique_ptr<TimeSeries::ITimeSerie>{future.result()};
+    auto serie = dynamic_cast<ScalarTimeSerie *>(data.get());
+    QVERIFY(serie != nullptr);
+    QCOMPARE(server.requestCount(PARAMETER_PATH), expectedRequestCount);
+
+    // Each sample of the range is present once, in time order
+    auto expectedTime = std::ceil(range.m_TStart / SAMPLING) * SAMPLING;
+    for (const auto &sample : *serie) {
+        QCOMPARE(sample.t(), expectedTime);
+        QCOMPARE(sample.v(), expectedTime);
+        expectedTime += SAMPLING;
+    }
+    QCOMPARE(expectedTime, std::floor(range.m_TEnd / SAMPLING) * SAMPLING + SAMPLING);
+}
+
+void TestAmdaProvider::testGetDataWithFailedRequest()
+{
+    // Requests last 28 hours: the third request of the range fails
+    const auto requestDuration = 28. * 3600.;
+    auto range = DateTimeRange{dateTime(2013, 9, 23, 9, 0, 0), dateTime(2013, 9, 27, 9, 0, 0)};
+    auto failedStart = (std::floor(range.m_TStart / requestDuration) + 2.) * requestDuration;
+
+    LocalHttpServer server{};
+    simulateAmda(server, failedStart);
+
+    auto metaData = QVariantHash{{"dataType", "scalar"}, {"xml:id", "imf(0)"}, {"sampling", "1S"}};
+    AmdaProvider provider{server.hostAndPort()};
+    auto future = QtConcurrent::run([&provider, range, metaData]() {
+        return provider.getData(DataProviderParameters{range, metaData});
+    });
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), REQUEST_TIMEOUT);
+
+    auto data = std::unique_ptr<TimeSeries::ITimeSerie>{future.result()};
+    QVERIFY(data == nullptr);
+    QCOMPARE(server.requestCount(PARAMETER_PATH), 5);
+}
+
+void TestAmdaProvider::testGetDataRequestsOnlyItsRange()
+{
+    auto requestedRanges = std::vector<DateTimeRange>{};
+    LocalHttpServer server{};
+    simulateAmda(server, std::numeric_limits<double>::quiet_NaN(), &requestedRanges);
+
+    // Range split in five requests, whose bounds aren't aligned on the duration of the requests
+    auto range = DateTimeRange{dateTime(2013, 9, 23, 9, 10, 0), dateTime(2013, 9, 27, 9, 20, 0)};
+    auto metaData = QVariantHash{{"dataType", "scalar"}, {"xml:id", "imf(0)"}, {"sampling", "1S"}};
+    AmdaProvider provider{server.hostAndPort()};
+    auto future = QtConcurrent::run([&provider, range, metaData]() {
+        return provider.getData(DataProviderParameters{range, metaData});
+    });
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), REQUEST_TIMEOUT);
+    delete future.result();
+
+    // The requests follow each other from the start of the range to its end
+    QCOMPARE(requestedRanges.size(), std::size_t{5});
+    std::sort(requestedRanges.begin(), requestedRanges.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.m_TStart < rhs.m_TStart; });
+    QCOMPARE(requestedRanges.front().m_TStart, range.m_TStart);
+    QCOMPARE(requestedRanges.back().m_TEnd, range.m_TEnd);
+    for (auto i = std::size_t{1}; i < requestedRanges.size(); ++i) {
+        QCOMPARE(requestedRanges[i].m_TStart, requestedRanges[i - 1].m_TEnd);
+    }
+}
+
+void TestAmdaProvider::testGetSpectrogram()
+{
+    LocalHttpServer server{};
+    simulateAmda(server);
+
+    auto range = DateTimeRange{dateTime(2013, 9, 23, 9, 0, 0), dateTime(2013, 9, 27, 9, 0, 0)};
+    auto metaData
+        = QVariantHash{{"dataType", "spectrogram"}, {"xml:id", SPECTROGRAM_ID}, {"sampling", "1S"}};
+
+    AmdaProvider provider{server.hostAndPort()};
+    auto future = QtConcurrent::run([&provider, range, metaData]() {
+        return provider.getData(DataProviderParameters{range, metaData});
+    });
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), REQUEST_TIMEOUT);
+
+    auto data = std::unique_ptr<TimeSeries::ITimeSerie>{future.result()};
+    auto serie = dynamic_cast<SpectrogramTimeSerie *>(data.get());
+    QVERIFY(serie != nullptr);
+    QCOMPARE(server.requestCount(PARAMETER_PATH), 5);
+    QVERIFY(serie->axis(1) == (std::vector<double>{20., 40.}));
+    QCOMPARE(serie->max_sampling, 10.);
+
+    auto expectedTime = std::ceil(range.m_TStart / SAMPLING) * SAMPLING;
+    for (auto &&line : *serie) {
+        auto expectedValue = expectedTime;
+        for (const auto &item : line) {
+            QCOMPARE(item.v(), expectedValue);
+            expectedValue += expectedTime;
+        }
+        expectedTime += SAMPLING;
+    }
+    QCOMPARE(expectedTime, std::floor(range.m_TEnd / SAMPLING) * SAMPLING + SAMPLING);
+}
+
+QTEST_MAIN(TestAmdaProvider)
+#include "TestAmdaProvider.moc"
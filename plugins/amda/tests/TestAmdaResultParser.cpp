@@ -1,12 +1,18 @@
 #include "AmdaResultParser.h"
+#include "AmdaResultStreamParser.h"
 
-#include <Data/ScalarSeries.h>
-#include <Data/SpectrogramSeries.h>
-#include <Data/VectorSeries.h>
+#include <Data/ScalarTimeSerie.h>
+#include <Data/SpectrogramTimeSerie.h>
+#include <Data/VectorTimeSerie.h>
+
+#include <DataSource/DataGaps.h>
 
 #include <QObject>
 #include <QtTest>
 
+#include <cmath>
+#include <type_traits>
+
 namespace {
 
 /// Path for the tests
@@ -23,6 +29,66 @@ QString inputFilePath(const QString &inputFileName)
     return QFileInfo{TESTS_RESOURCES_PATH, inputFileName}.absoluteFilePath();
 }
 
+/// Generates an AMDA file of vectors, one value per second. Times are written as ISO 8601 dates or
+/// as seconds since epoch
+QByteArray generateVectorFile(int lineCount, bool epochTimes)
+{
+    const auto start = dateTime(2013, 9, 23, 0, 0, 0);
+
+    auto result = QByteArray{"#imf - Type : Local Parameter @ CDPP/AMDA - Name : imf_gse - Units : "
+                             "nT - Size : 3 - Frame : GSE - Mission : ACE\n"};
+    for (auto i = 0; i < lineCount; ++i) {
+        auto time = start.addSecs(i);
+        result += epochTimes ? QByteArray::number(time.toMSecsSinceEpoch() / 1000., 'f', 3)
+                             : time.toString(QStringLiteral("yyyy-MM-ddThh:mm:ss.zzz")).toLatin1();
+        for (auto component = 0; component < 3; ++component) {
+            result += "     " + QByteArray::number(std::cos(i * 0.01 + component), 'f', 5);
+        }
+        result += '\n';
+    }
+    return result;
+}
+
+/// @return the values of a component of a serie, in time order
+std::vector<double> componentValues(ScalarTimeSerie &serie, int)
+{
+    auto result = std::vector<double>{};
+    for (const auto &sample : serie) {
+        result.push_back(sample.v());
+    }
+    return result;
+}
+
+std::vector<double> componentValues(VectorTimeSerie &serie, int component)
+{
+    auto result = std::vector<double>{};
+    for (const auto &sample : serie) {
+        const auto &value = sample.v();
+        result.push_back(component == 0 ? value.x : component == 1 ? value.y : value.z);
+    }
+    return result;
+}
+
+/// For spectrograms, a component is a band
+std::vector<double> componentValues(SpectrogramTimeSerie &serie, int component)
+{
+    auto result = std::vector<double>{};
+    for (auto &&line : serie) {
+        result.push_back(std::next(std::begin(line), component)->v());
+    }
+    return result;
+}
+
+/// Compares values, NaN values being equal
+bool equalValues(const std::vector<double> &values, const QVector<double> &expectedValues)
+{
+    return std::equal(values.cbegin(), values.cend(), expectedValues.cbegin(),
+                      expectedValues.cend(), [](const auto &value, const auto &expectedValue) {
+                          return (std::isnan(value) && std::isnan(expectedValue))
+                                 || value == expectedValue;
+                      });
+}
+
 template <typename T>
 struct ExpectedResults {
 
@@ -32,7 +98,7 @@ struct ExpectedResults {
         return *this;
     }
 
-    ExpectedResults &setXAxisUnit(Unit xAxisUnit)
+    ExpectedResults &setXAxisUnit(QString xAxisUnit)
     {
         m_XAxisUnit = std::move(xAxisUnit);
         return *this;
@@ -49,7 +115,7 @@ struct ExpectedResults {
         return *this;
     }
 
-    ExpectedResults &setValuesUnit(Unit valuesUnit)
+    ExpectedResults &setValuesUnit(QString valuesUnit)
     {
         m_ValuesUnit = std::move(valuesUnit);
         return *this;
@@ -74,7 +140,7 @@ struct ExpectedResults {
         return *this;
     }
 
-    ExpectedResults &setYAxisUnit(Unit yAxisUnit)
+    ExpectedResults &setYAxisUnit(QString yAxisUnit)
     {
         m_YAxisUnit = std::move(yAxisUnit);
         return *this;
@@ -86,59 +152,52 @@ struct ExpectedResults {
         return *this;
     }
 
+    /// Sets the gaps expected in the data, found from the max sampling of the serie
+    ExpectedResults &setDataGaps(const QVector<QPair<QDateTime, QDateTime> > &dataGaps)
+    {
+        m_DataGapsEnabled = true;
+        m_DataGaps.clear();
+        for (const auto &gap : dataGaps) {
+            m_DataGaps.push_back(gap.first.toMSecsSinceEpoch() / 1000.);
+            m_DataGaps.push_back(gap.second.toMSecsSinceEpoch() / 1000.);
+        }
+        return *this;
+    }
+
     /**
-     * Validates a DataSeries compared to the expected results
-     * @param results the DataSeries to validate
+     * Validates a time serie compared to the expected results
+     * @param results the time serie to validate
      */
-    void validate(std::shared_ptr<IDataSeries> results)
+    void validate(std::shared_ptr<TimeSeries::ITimeSerie> results)
     {
         if (m_ParsingOK) {
-            auto dataSeries = dynamic_cast<T *>(results.get());
-            if (dataSeries == nullptr) {
-
-                // No unit detected, parsink ok but data is nullptr
-                // TODO, improve the test to verify that the data is null
-                return;
-            }
-
-            // Checks units
-            QVERIFY(dataSeries->xAxisUnit() == m_XAxisUnit);
-            QVERIFY(dataSeries->valuesUnit() == m_ValuesUnit);
-
-            auto verifyRange = [dataSeries](const auto &expectedData, const auto &equalFun) {
-                QVERIFY(std::equal(dataSeries->cbegin(), dataSeries->cend(), expectedData.cbegin(),
-                                   expectedData.cend(),
-                                   [&equalFun](const auto &dataSeriesIt, const auto &expectedX) {
-                                       return equalFun(dataSeriesIt, expectedX);
-                                   }));
-            };
+            auto serie = dynamic_cast<T *>(results.get());
+            QVERIFY(serie != nullptr);
 
             // Checks x-axis data
-            verifyRange(m_XAxisData, [](const auto &seriesIt, const auto &value) {
-                return seriesIt.x() == value;
-            });
+            QVERIFY(equalValues(serie->axis(0), m_XAxisData));
 
             // Checks values data of each component
             for (auto i = 0; i < m_ValuesData.size(); ++i) {
-                verifyRange(m_ValuesData.at(i), [i](const auto &seriesIt, const auto &value) {
-                    auto itValue = seriesIt.value(i);
-                    return (std::isnan(itValue) && std::isnan(value)) || seriesIt.value(i) == value;
-                });
+                QVERIFY(equalValues(componentValues(*serie, i), m_ValuesData.at(i)));
             }
 
             // Checks y-axis (if defined)
-            auto yAxis = dataSeries->yAxis();
-            QCOMPARE(yAxis.isDefined(), m_YAxisEnabled);
-
             if (m_YAxisEnabled) {
-                // Unit
-                QCOMPARE(yAxis.unit(), m_YAxisUnit);
-
-                // Data
-                QVERIFY(std::equal(yAxis.cbegin(), yAxis.cend(), m_YAxisData.cbegin(),
-                                   m_YAxisData.cend(), [](const auto &it, const auto &expectedVal) {
-                                       return it.first() == expectedVal;
-                                   }));
+                QVERIFY(equalValues(serie->axis(1), m_YAxisData));
+            }
+
+            // Checks data gaps (if defined): they are kept as segments, not filled
+            if constexpr (std::is_same<T, SpectrogramTimeSerie>::value) {
+                if (m_DataGapsEnabled) {
+                    auto gaps = std::vector<double>{};
+                    auto dataGaps = DataGaps::find(serie->axis(0), serie->max_sampling);
+                    for (const auto &gap : dataGaps.m_Gaps) {
+                        gaps.push_back(gap.m_TStart);
+                        gaps.push_back(gap.m_TEnd);
+                    }
+                    QVERIFY(equalValues(gaps, m_DataGaps));
+                }
             }
         }
         else {
@@ -146,29 +205,47 @@ struct ExpectedResults {
         }
     }
 
+    /**
+     * Validates the units read in the header of a file compared to the expected units. Time series
+     * don't carry units: they are read in the properties of the parser
+     * @param properties the properties read by the parser
+     */
+    void validateUnits(const Properties &properties)
+    {
+        if (m_ParsingOK) {
+            QCOMPARE(properties.value(X_AXIS_UNIT_PROPERTY).toString(), m_XAxisUnit);
+            QCOMPARE(properties.value(VALUES_UNIT_PROPERTY).toString(), m_ValuesUnit);
+            QCOMPARE(properties.value(Y_AXIS_UNIT_PROPERTY).toString(), m_YAxisUnit);
+        }
+    }
+
     // Parsing was successfully completed
     bool m_ParsingOK{false};
     // Expected x-axis unit
-    Unit m_XAxisUnit{};
+    QString m_XAxisUnit{};
     // Expected x-axis data
     QVector<double> m_XAxisData{};
     // Expected values unit
-    Unit m_ValuesUnit{};
+    QString m_ValuesUnit{};
     // Expected values data
     QVector<QVector<double> > m_ValuesData{};
-    // Expected data series has y-axis
+    // Expected time serie has y-axis
     bool m_YAxisEnabled{false};
     // Expected y-axis unit (if axis defined)
-    Unit m_YAxisUnit{};
+    QString m_YAxisUnit{};
     // Expected y-axis data (if axis defined)
     QVector<double> m_YAxisData{};
+    // Expected time serie has data gaps checked (spectrograms only)
+    bool m_DataGapsEnabled{false};
+    // Expected data gaps, as pairs of start and end times (if gaps checked)
+    QVector<double> m_DataGaps{};
 };
 
 } // namespace
 
-Q_DECLARE_METATYPE(ExpectedResults<ScalarSeries>)
-Q_DECLARE_METATYPE(ExpectedResults<SpectrogramSeries>)
-Q_DECLARE_METATYPE(ExpectedResults<VectorSeries>)
+Q_DECLARE_METATYPE(ExpectedResults<ScalarTimeSerie>)
+Q_DECLARE_METATYPE(ExpectedResults<SpectrogramTimeSerie>)
+Q_DECLARE_METATYPE(ExpectedResults<VectorTimeSerie>)
 
 class TestAmdaResultParser : public QObject {
     Q_OBJECT
@@ -200,6 +277,14 @@ private:
         // Validates results //
         // ///////////////// //
         expectedResults.validate(results);
+
+        // Parses file again to read its units
+        QFile file{filePath};
+        AmdaResultStreamParser parser{valueType};
+        if (file.open(QFile::ReadOnly) && parser.feed(file.readAll())) {
+            parser.finish();
+        }
+        expectedResults.validateUnits(parser.properties());
     }
 
 private slots:
@@ -223,11 +308,30 @@ private slots:
 
     /// Tests parsing vector series of a TXT file
     void testReadVectorTxt();
+
+    /// Tests parsing a file large enough to be read in several chunks, and that the values of the
+    /// chunks are in the order of the file
+    void testReadLargeScalarTxt();
+
+    /// Input test data
+    /// @sa testReadStreamedTxt()
+    void testReadStreamedTxt_data();
+
+    /// Tests parsing a file whose bytes arrive in several parts, cut anywhere in the lines
+    void testReadStreamedTxt();
+
+    /// Input test data
+    /// @sa testReadBenchmark()
+    void testReadBenchmark_data();
+
+    /// Measures the time taken to parse the same values, whose times are written as ISO 8601 dates
+    /// or as seconds since epoch
+    void testReadBenchmark();
 };
 
 void TestAmdaResultParser::testReadScalarTxt_data()
 {
-    testReadDataStructure<ScalarSeries>();
+    testReadDataStructure<ScalarTimeSerie>();
 
     // ////////// //
     // Test cases //
@@ -236,9 +340,35 @@ void TestAmdaResultParser::testReadScalarTxt_data()
     // Valid files
     QTest::newRow("Valid file")
         << QStringLiteral("ValidScalar1.txt")
-        << ExpectedResults<ScalarSeries>{}
+        << ExpectedResults<ScalarTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{"nT", true})
+               .setXAxisUnit(QStringLiteral("nT"))
+               .setXAxisData({dateTime(2013, 9, 23, 9, 0, 30), dateTime(2013, 9, 23, 9, 1, 30),
+                              dateTime(2013, 9, 23, 9, 2, 30), dateTime(2013, 9, 23, 9, 3, 30),
+                              dateTime(2013, 9, 23, 9, 4, 30), dateTime(2013, 9, 23, 9, 5, 30),
+                              dateTime(2013, 9, 23, 9, 6, 30), dateTime(2013, 9, 23, 9, 7, 30),
+                              dateTime(2013, 9, 23, 9, 8, 30), dateTime(2013, 9, 23, 9, 9, 30)})
+               .setValuesData({-2.83950, -2.71850, -2.52150, -2.57633, -2.58050, -2.48325, -2.63025,
+                               -2.55800, -2.43250, -2.42200});
+
+    QTest::newRow("Valid file (Windows line endings)")
+        << QStringLiteral("ValidScalar1CRLF.txt")
+        << ExpectedResults<ScalarTimeSerie>{}
+               .setParsingOK(true)
+               .setXAxisUnit(QStringLiteral("nT"))
+               .setXAxisData({dateTime(2013, 9, 23, 9, 0, 30), dateTime(2013, 9, 23, 9, 1, 30),
+                              dateTime(2013, 9, 23, 9, 2, 30), dateTime(2013, 9, 23, 9, 3, 30),
+                              dateTime(2013, 9, 23, 9, 4, 30), dateTime(2013, 9, 23, 9, 5, 30),
+                              dateTime(2013, 9, 23, 9, 6, 30), dateTime(2013, 9, 23, 9, 7, 30),
+                              dateTime(2013, 9, 23, 9, 8, 30), dateTime(2013, 9, 23, 9, 9, 30)})
+               .setValuesData({-2.83950, -2.71850, -2.52150, -2.57633, -2.58050, -2.48325, -2.63025,
+                               -2.55800, -2.43250, -2.42200});
+
+    QTest::newRow("Valid file (epoch times)")
+        << QStringLiteral("ValidScalar1Epoch.txt")
+        << ExpectedResults<ScalarTimeSerie>{}
+               .setParsingOK(true)
+               .setXAxisUnit(QStringLiteral("nT"))
                .setXAxisData({dateTime(2013, 9, 23, 9, 0, 30), dateTime(2013, 9, 23, 9, 1, 30),
                               dateTime(2013, 9, 23, 9, 2, 30), dateTime(2013, 9, 23, 9, 3, 30),
                               dateTime(2013, 9, 23, 9, 4, 30), dateTime(2013, 9, 23, 9, 5, 30),
@@ -249,18 +379,18 @@ void TestAmdaResultParser::testReadScalarTxt_data()
 
     QTest::newRow("Valid file (value of first line is invalid but it is converted to NaN")
         << QStringLiteral("WrongValue.txt")
-        << ExpectedResults<ScalarSeries>{}
+        << ExpectedResults<ScalarTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{"nT", true})
+               .setXAxisUnit(QStringLiteral("nT"))
                .setXAxisData({dateTime(2013, 9, 23, 9, 0, 30), dateTime(2013, 9, 23, 9, 1, 30),
                               dateTime(2013, 9, 23, 9, 2, 30)})
                .setValuesData({std::numeric_limits<double>::quiet_NaN(), -2.71850, -2.52150});
 
     QTest::newRow("Valid file that contains NaN values")
         << QStringLiteral("NaNValue.txt")
-        << ExpectedResults<ScalarSeries>{}
+        << ExpectedResults<ScalarTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{("nT"), true})
+               .setXAxisUnit(QStringLiteral("nT"))
                .setXAxisData({dateTime(2013, 9, 23, 9, 0, 30), dateTime(2013, 9, 23, 9, 1, 30),
                               dateTime(2013, 9, 23, 9, 2, 30)})
                .setValuesData({std::numeric_limits<double>::quiet_NaN(), -2.71850, -2.52150});
@@ -268,63 +398,63 @@ void TestAmdaResultParser::testReadScalarTxt_data()
     // Valid files but with some invalid lines (wrong unit, wrong values, etc.)
     QTest::newRow("No unit file")
         << QStringLiteral("NoUnit.txt")
-        << ExpectedResults<ScalarSeries>{}.setParsingOK(true).setXAxisUnit(Unit{"", true});
+        << ExpectedResults<ScalarTimeSerie>{}.setParsingOK(true);
 
     QTest::newRow("Wrong unit file")
         << QStringLiteral("WrongUnit.txt")
-        << ExpectedResults<ScalarSeries>{}
+        << ExpectedResults<ScalarTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{"", true})
                .setXAxisData({dateTime(2013, 9, 23, 9, 0, 30), dateTime(2013, 9, 23, 9, 1, 30),
                               dateTime(2013, 9, 23, 9, 2, 30)})
                .setValuesData({-2.83950, -2.71850, -2.52150});
 
     QTest::newRow("Wrong results file (date of first line is invalid")
         << QStringLiteral("WrongDate.txt")
-        << ExpectedResults<ScalarSeries>{}
+        << ExpectedResults<ScalarTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{"nT", true})
+               .setXAxisUnit(QStringLiteral("nT"))
                .setXAxisData({dateTime(2013, 9, 23, 9, 1, 30), dateTime(2013, 9, 23, 9, 2, 30)})
                .setValuesData({-2.71850, -2.52150});
 
     QTest::newRow("Wrong results file (too many values for first line")
         << QStringLiteral("TooManyValues.txt")
-        << ExpectedResults<ScalarSeries>{}
+        << ExpectedResults<ScalarTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{"nT", true})
+               .setXAxisUnit(QStringLiteral("nT"))
                .setXAxisData({dateTime(2013, 9, 23, 9, 1, 30), dateTime(2013, 9, 23, 9, 2, 30)})
                .setValuesData({-2.71850, -2.52150});
 
     QTest::newRow("Wrong results file (x of first line is NaN")
         << QStringLiteral("NaNX.txt")
-        << ExpectedResults<ScalarSeries>{}
+        << ExpectedResults<ScalarTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{"nT", true})
+               .setXAxisUnit(QStringLiteral("nT"))
                .setXAxisData({dateTime(2013, 9, 23, 9, 1, 30), dateTime(2013, 9, 23, 9, 2, 30)})
                .setValuesData({-2.71850, -2.52150});
 
     QTest::newRow("Invalid file type (vector)")
         << QStringLiteral("ValidVector1.txt")
-        << ExpectedResults<ScalarSeries>{}.setParsingOK(true).setXAxisUnit(Unit{"nT", true});
+        << ExpectedResults<ScalarTimeSerie>{}.setParsingOK(true).setXAxisUnit(
+               QStringLiteral("nT"));
 
     // Invalid files
     QTest::newRow("Invalid file (unexisting file)")
         << QStringLiteral("UnexistingFile.txt")
-        << ExpectedResults<ScalarSeries>{}.setParsingOK(false);
+        << ExpectedResults<ScalarTimeSerie>{}.setParsingOK(false);
 
     QTest::newRow("Invalid file (file not found on server)")
         << QStringLiteral("FileNotFound.txt")
-        << ExpectedResults<ScalarSeries>{}.setParsingOK(false);
+        << ExpectedResults<ScalarTimeSerie>{}.setParsingOK(false);
 }
 
 void TestAmdaResultParser::testReadScalarTxt()
 {
-    testRead<ScalarSeries>(DataSeriesType::SCALAR);
+    testRead<ScalarTimeSerie>(DataSeriesType::SCALAR);
 }
 
 void TestAmdaResultParser::testReadSpectrogramTxt_data()
 {
-    testReadDataStructure<SpectrogramSeries>();
+    testReadDataStructure<SpectrogramTimeSerie>();
 
     // ////////// //
     // Test cases //
@@ -333,32 +463,30 @@ void TestAmdaResultParser::testReadSpectrogramTxt_data()
     // Valid files
     QTest::newRow("Valid file (three bands)")
         << QStringLiteral("spectro/ValidSpectrogram1.txt")
-        << ExpectedResults<SpectrogramSeries>{}
+        << ExpectedResults<SpectrogramTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{"t", true})
                .setXAxisData({dateTime(2012, 11, 6, 9, 14, 35), dateTime(2012, 11, 6, 9, 16, 10),
                               dateTime(2012, 11, 6, 9, 17, 45), dateTime(2012, 11, 6, 9, 19, 20),
                               dateTime(2012, 11, 6, 9, 20, 55)})
                .setYAxisEnabled(true)
-               .setYAxisUnit(Unit{"eV"})
+               .setYAxisUnit(QStringLiteral("eV"))
                .setYAxisData({5.75, 7.6, 10.05}) // middle of the intervals of each band
-               .setValuesUnit(Unit{"eV/(cm^2-s-sr-eV)"})
+               .setValuesUnit(QStringLiteral("eV/(cm^2-s-sr-eV)"))
                .setValuesData(QVector<QVector<double> >{
                    {16313.780, 12631.465, 8223.368, 27595.301, 12820.613},
                    {15405.838, 11957.925, 15026.249, 25617.533, 11179.109},
                    {8946.475, 18133.158, 10875.621, 24051.619, 19283.221}});
 
     auto fourBandsResult
-        = ExpectedResults<SpectrogramSeries>{}
+        = ExpectedResults<SpectrogramTimeSerie>{}
               .setParsingOK(true)
-              .setXAxisUnit(Unit{"t", true})
               .setXAxisData({dateTime(2012, 11, 6, 9, 14, 35), dateTime(2012, 11, 6, 9, 16, 10),
                              dateTime(2012, 11, 6, 9, 17, 45), dateTime(2012, 11, 6, 9, 19, 20),
                              dateTime(2012, 11, 6, 9, 20, 55)})
               .setYAxisEnabled(true)
-              .setYAxisUnit(Unit{"eV"})
+              .setYAxisUnit(QStringLiteral("eV"))
               .setYAxisData({5.75, 7.6, 10.05, 13.}) // middle of the intervals of each band
-              .setValuesUnit(Unit{"eV/(cm^2-s-sr-eV)"})
+              .setValuesUnit(QStringLiteral("eV/(cm^2-s-sr-eV)"))
               .setValuesData(QVector<QVector<double> >{
                   {16313.780, 12631.465, 8223.368, 27595.301, 12820.613},
                   {15405.838, 11957.925, 15026.249, 25617.533, 11179.109},
@@ -374,16 +502,15 @@ void TestAmdaResultParser::testReadSpectrogramTxt_data()
     auto nan = std::numeric_limits<double>::quiet_NaN();
 
     auto nanValuesResult
-        = ExpectedResults<SpectrogramSeries>{}
+        = ExpectedResults<SpectrogramTimeSerie>{}
               .setParsingOK(true)
-              .setXAxisUnit(Unit{"t", true})
               .setXAxisData({dateTime(2012, 11, 6, 9, 14, 35), dateTime(2012, 11, 6, 9, 16, 10),
                              dateTime(2012, 11, 6, 9, 17, 45), dateTime(2012, 11, 6, 9, 19, 20),
                              dateTime(2012, 11, 6, 9, 20, 55)})
               .setYAxisEnabled(true)
-              .setYAxisUnit(Unit{"eV"})
+              .setYAxisUnit(QStringLiteral("eV"))
               .setYAxisData({5.75, 7.6, 10.05, 13.}) // middle of the intervals of each band
-              .setValuesUnit(Unit{"eV/(cm^2-s-sr-eV)"})
+              .setValuesUnit(QStringLiteral("eV/(cm^2-s-sr-eV)"))
               .setValuesData(
                   QVector<QVector<double> >{{nan, 12631.465, 8223.368, 27595.301, 12820.613},
                                             {15405.838, nan, nan, 25617.533, 11179.109},
@@ -396,149 +523,53 @@ void TestAmdaResultParser::testReadSpectrogramTxt_data()
         << QStringLiteral("spectro/ValidSpectrogramFillValues.txt")
         << nanValuesResult; // Fill values are replaced by NaN values in the data series
 
-    QTest::newRow("Valid file (containing data holes, resolution = 3 minutes)")
-        << QStringLiteral("spectro/ValidSpectrogramDataHoles.txt")
-        << ExpectedResults<SpectrogramSeries>{}
-               .setParsingOK(true)
-               .setXAxisUnit(Unit{"t", true})
-               .setXAxisData({dateTime(2011, 12, 10, 12, 10, 54), //
-                              dateTime(2011, 12, 10, 12, 13, 54), // Data hole
-                              dateTime(2011, 12, 10, 12, 16, 54), // Data hole
-                              dateTime(2011, 12, 10, 12, 17, 23), //
-                              dateTime(2011, 12, 10, 12, 20, 23), // Data hole
-                              dateTime(2011, 12, 10, 12, 23, 23), // Data hole
-                              dateTime(2011, 12, 10, 12, 23, 51), //
-                              dateTime(2011, 12, 10, 12, 26, 51), // Data hole
-                              dateTime(2011, 12, 10, 12, 29, 51), // Data hole
-                              dateTime(2011, 12, 10, 12, 30, 19), //
-                              dateTime(2011, 12, 10, 12, 33, 19), // Data hole
-                              dateTime(2011, 12, 10, 12, 35, 04), //
-                              dateTime(2011, 12, 10, 12, 36, 41), //
-                              dateTime(2011, 12, 10, 12, 38, 18), //
-                              dateTime(2011, 12, 10, 12, 39, 55)})
-               .setYAxisEnabled(true)
-               .setYAxisUnit(Unit{"eV"})
-               .setYAxisData({16485.85, 20996.1}) // middle of the intervals of each band
-               .setValuesUnit(Unit{"eV/(cm^2-s-sr-eV)"})
-               .setValuesData(QVector<QVector<double> >{{2577578.000, //
-                                                         nan,         // Data hole
-                                                         nan,         // Data hole
-                                                         2314121.500, //
-                                                         nan,         // Data hole
-                                                         nan,         // Data hole
-                                                         2063608.750, //
-                                                         nan,         // Data hole
-                                                         nan,         // Data hole
-                                                         2234525.500, //
-                                                         nan,         // Data hole
-                                                         1670215.250, //
-                                                         1689243.250, //
-                                                         1654617.125, //
-                                                         1504983.750},
-                                                        {2336016.000, //
-                                                         nan,         // Data hole
-                                                         nan,         // Data hole
-                                                         1712093.125, //
-                                                         nan,         // Data hole
-                                                         nan,         // Data hole
-                                                         1614491.625, //
-                                                         nan,         // Data hole
-                                                         nan,         // Data hole
-                                                         1764516.500, //
-                                                         nan,         // Data hole
-                                                         1688078.500, //
-                                                         1743183.500, //
-                                                         1733603.250, //
-                                                         1708356.500}});
+    // Data holes aren't filled: the lines of the file are read as they are, and the gaps are found
+    // from the max sampling of the file
+    auto dataHolesResult
+        = ExpectedResults<SpectrogramTimeSerie>{}
+              .setParsingOK(true)
+              .setXAxisData({dateTime(2011, 12, 10, 12, 10, 54), dateTime(2011, 12, 10, 12, 17, 23),
+                             dateTime(2011, 12, 10, 12, 23, 51), dateTime(2011, 12, 10, 12, 30, 19),
+                             dateTime(2011, 12, 10, 12, 35, 04), dateTime(2011, 12, 10, 12, 36, 41),
+                             dateTime(2011, 12, 10, 12, 38, 18),
+                             dateTime(2011, 12, 10, 12, 39, 55)})
+              .setYAxisEnabled(true)
+              .setYAxisUnit(QStringLiteral("eV"))
+              .setYAxisData({16485.85, 20996.1}) // middle of the intervals of each band
+              .setValuesUnit(QStringLiteral("eV/(cm^2-s-sr-eV)"))
+              .setValuesData(QVector<QVector<double> >{{2577578.000, 2314121.500, 2063608.750,
+                                                        2234525.500, 1670215.250, 1689243.250,
+                                                        1654617.125, 1504983.750},
+                                                       {2336016.000, 1712093.125, 1614491.625,
+                                                        1764516.500, 1688078.500, 1743183.500,
+                                                        1733603.250, 1708356.500}})
+              .setDataGaps(
+                  {{dateTime(2011, 12, 10, 12, 10, 54), dateTime(2011, 12, 10, 12, 17, 23)},
+                   {dateTime(2011, 12, 10, 12, 17, 23), dateTime(2011, 12, 10, 12, 23, 51)},
+                   {dateTime(2011, 12, 10, 12, 23, 51), dateTime(2011, 12, 10, 12, 30, 19)},
+                   {dateTime(2011, 12, 10, 12, 30, 19), dateTime(2011, 12, 10, 12, 35, 04)}});
 
+    QTest::newRow("Valid file (containing data holes, resolution = 3 minutes)")
+        << QStringLiteral("spectro/ValidSpectrogramDataHoles.txt") << dataHolesResult;
     QTest::newRow(
         "Valid file (containing data holes at the beginning and the end, resolution = 4 minutes)")
         << QStringLiteral("spectro/ValidSpectrogramDataHoles2.txt")
-        << ExpectedResults<SpectrogramSeries>{}
-               .setParsingOK(true)
-               .setXAxisUnit(Unit{"t", true})
-               .setXAxisData({
-                   dateTime(2011, 12, 10, 12, 2, 54),  // Data hole
-                   dateTime(2011, 12, 10, 12, 6, 54),  // Data hole
-                   dateTime(2011, 12, 10, 12, 10, 54), //
-                   dateTime(2011, 12, 10, 12, 14, 54), // Data hole
-                   dateTime(2011, 12, 10, 12, 17, 23), //
-                   dateTime(2011, 12, 10, 12, 21, 23), // Data hole
-                   dateTime(2011, 12, 10, 12, 23, 51), //
-                   dateTime(2011, 12, 10, 12, 27, 51), // Data hole
-                   dateTime(2011, 12, 10, 12, 30, 19), //
-                   dateTime(2011, 12, 10, 12, 34, 19), // Data hole
-                   dateTime(2011, 12, 10, 12, 35, 04), //
-                   dateTime(2011, 12, 10, 12, 36, 41), //
-                   dateTime(2011, 12, 10, 12, 38, 18), //
-                   dateTime(2011, 12, 10, 12, 39, 55),
-                   dateTime(2011, 12, 10, 12, 43, 55), // Data hole
-                   dateTime(2011, 12, 10, 12, 47, 55), // Data hole
-                   dateTime(2011, 12, 10, 12, 51, 55), // Data hole
-                   dateTime(2011, 12, 10, 12, 55, 55), // Data hole
-                   dateTime(2011, 12, 10, 12, 59, 55)  // Data hole
-               })
-               .setYAxisEnabled(true)
-               .setYAxisUnit(Unit{"eV"})
-               .setYAxisData({16485.85, 20996.1}) // middle of the intervals of each band
-               .setValuesUnit(Unit{"eV/(cm^2-s-sr-eV)"})
-               .setValuesData(QVector<QVector<double> >{{
-                                                            nan,         // Data hole
-                                                            nan,         // Data hole
-                                                            2577578.000, //
-                                                            nan,         // Data hole
-                                                            2314121.500, //
-                                                            nan,         // Data hole
-                                                            2063608.750, //
-                                                            nan,         // Data hole
-                                                            2234525.500, //
-                                                            nan,         // Data hole
-                                                            1670215.250, //
-                                                            1689243.250, //
-                                                            1654617.125, //
-                                                            1504983.750, //
-                                                            nan,         // Data hole
-                                                            nan,         // Data hole
-                                                            nan,         // Data hole
-                                                            nan,         // Data hole
-                                                            nan          // Data hole
-                                                        },
-                                                        {
-                                                            nan,         // Data hole
-                                                            nan,         // Data hole
-                                                            2336016.000, //
-                                                            nan,         // Data hole
-                                                            1712093.125, //
-                                                            nan,         // Data hole
-                                                            1614491.625, //
-                                                            nan,         // Data hole
-                                                            1764516.500, //
-                                                            nan,         // Data hole
-                                                            1688078.500, //
-                                                            1743183.500, //
-                                                            1733603.250, //
-                                                            1708356.500, //
-                                                            nan,         // Data hole
-                                                            nan,         // Data hole
-                                                            nan,         // Data hole
-                                                            nan,         // Data hole
-                                                            nan          // Data hole
-                                                        }});
+        << dataHolesResult; // The gaps between the lines are all larger than 4 minutes
 
     // Invalid files
     QTest::newRow("Invalid file (inconsistent bands)")
         << QStringLiteral("spectro/InvalidSpectrogramWrongBands.txt")
-        << ExpectedResults<SpectrogramSeries>{}.setParsingOK(false);
+        << ExpectedResults<SpectrogramTimeSerie>{}.setParsingOK(false);
 }
 
 void TestAmdaResultParser::testReadSpectrogramTxt()
 {
-    testRead<SpectrogramSeries>(DataSeriesType::SPECTROGRAM);
+    testRead<SpectrogramTimeSerie>(DataSeriesType::SPECTROGRAM);
 }
 
 void TestAmdaResultParser::testReadVectorTxt_data()
 {
-    testReadDataStructure<VectorSeries>();
+    testReadDataStructure<VectorTimeSerie>();
 
     // ////////// //
     // Test cases //
@@ -547,9 +578,9 @@ void TestAmdaResultParser::testReadVectorTxt_data()
     // Valid files
     QTest::newRow("Valid file")
         << QStringLiteral("ValidVector1.txt")
-        << ExpectedResults<VectorSeries>{}
+        << ExpectedResults<VectorTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{"nT", true})
+               .setXAxisUnit(QStringLiteral("nT"))
                .setXAxisData({dateTime(2013, 7, 2, 9, 13, 50), dateTime(2013, 7, 2, 9, 14, 6),
                               dateTime(2013, 7, 2, 9, 14, 22), dateTime(2013, 7, 2, 9, 14, 38),
                               dateTime(2013, 7, 2, 9, 14, 54), dateTime(2013, 7, 2, 9, 15, 10),
@@ -563,16 +594,116 @@ void TestAmdaResultParser::testReadVectorTxt_data()
     // Valid files but with some invalid lines (wrong unit, wrong values, etc.)
     QTest::newRow("Invalid file type (scalar)")
         << QStringLiteral("ValidScalar1.txt")
-        << ExpectedResults<VectorSeries>{}
+        << ExpectedResults<VectorTimeSerie>{}
                .setParsingOK(true)
-               .setXAxisUnit(Unit{"nT", true})
+               .setXAxisUnit(QStringLiteral("nT"))
                .setXAxisData({})
                .setValuesData(QVector<QVector<double> >{{}, {}, {}});
 }
 
 void TestAmdaResultParser::testReadVectorTxt()
 {
-    testRead<VectorSeries>(DataSeriesType::VECTOR);
+    testRead<VectorTimeSerie>(DataSeriesType::VECTOR);
+}
+
+void TestAmdaResultParser::testReadLargeScalarTxt()
+{
+    const auto lineCount = 500000;
+    const auto start = dateTime(2013, 9, 23, 0, 0, 0);
+
+    auto data = QByteArray{"#imf(0) - Type : Local Parameter @ CDPP/AMDA - Name : bx_gse - Units : "
+                           "nT - Size : 1 - Frame : GSE - Mission : ACE\n"};
+    for (auto i = 0; i < lineCount; ++i) {
+        data += start.addSecs(i).toString(QStringLiteral("yyyy-MM-ddThh:mm:ss.zzz")).toLatin1();
+        data += "     " + QByteArray::number(i) + '\n';
+    }
+
+    auto results = std::unique_ptr<TimeSeries::ITimeSerie>{
+        AmdaResultParser::readTxt(data, DataSeriesType::SCALAR)};
+    auto serie = dynamic_cast<ScalarTimeSerie *>(results.get());
+    QVERIFY(serie != nullptr);
+    QVERIFY(serie->size() == static_cast<std::size_t>(lineCount));
+
+    auto i = 0;
+    for (const auto &sample : *serie) {
+        QCOMPARE(sample.t(), start.addSecs(i).toMSecsSinceEpoch() / 1000.);
+        QCOMPARE(sample.v(), static_cast<double>(i));
+        ++i;
+    }
+}
+
+void TestAmdaResultParser::testReadStreamedTxt_data()
+{
+    // Name of TXT file to read
+    QTest::addColumn<QString>("inputFileName");
+    // Number of bytes arriving at once
+    QTest::addColumn<int>("partSize");
+
+    QTest::newRow("Valid file (bytes one by one)") << QStringLiteral("ValidScalar1.txt") << 1;
+    QTest::newRow("Valid file (parts of 7 bytes)") << QStringLiteral("ValidScalar1.txt") << 7;
+    QTest::newRow("Valid file with Windows line endings (parts of 64 bytes)")
+        << QStringLiteral("ValidScalar1CRLF.txt") << 64;
+    QTest::newRow("Valid file with epoch times (parts of 7 bytes)")
+        << QStringLiteral("ValidScalar1Epoch.txt") << 7;
+    QTest::newRow("Wrong results file (parts of 7 bytes)") << QStringLiteral("WrongDate.txt")
+                                                           << 7;
+}
+
+void TestAmdaResultParser::testReadStreamedTxt()
+{
+    QFETCH(QString, inputFileName);
+    QFETCH(int, partSize);
+
+    QFile file{inputFilePath(inputFileName)};
+    QVERIFY(file.open(QFile::ReadOnly));
+    auto data = file.readAll();
+
+    // Results of the file read at once
+    auto expectedResults = std::unique_ptr<TimeSeries::ITimeSerie>{
+        AmdaResultParser::readTxt(data, DataSeriesType::SCALAR)};
+    auto expectedSerie = dynamic_cast<ScalarTimeSerie *>(expectedResults.get());
+    QVERIFY(expectedSerie != nullptr);
+
+    auto results = AmdaResults{};
+    AmdaResultStreamParser parser{DataSeriesType::SCALAR, 0, [&results](AmdaResults partResults) {
+                                      results.m_XAxisData.insert(
+                                          results.m_XAxisData.end(),
+                                          partResults.m_XAxisData.cbegin(),
+                                          partResults.m_XAxisData.cend());
+                                      results.m_ValuesData.insert(
+                                          results.m_ValuesData.end(),
+                                          partResults.m_ValuesData.cbegin(),
+                                          partResults.m_ValuesData.cend());
+                                  }};
+    for (auto i = 0; i < data.size(); i += partSize) {
+        QVERIFY(parser.feed(data.mid(i, partSize)));
+    }
+    QVERIFY(parser.finish());
+
+    QVERIFY(expectedSerie->axis(0) == results.m_XAxisData);
+    QVERIFY(componentValues(*expectedSerie, 0) == results.m_ValuesData);
+}
+
+void TestAmdaResultParser::testReadBenchmark_data()
+{
+    // Content of the file to parse
+    QTest::addColumn<QByteArray>("data");
+
+    const auto lineCount = 200000;
+    QTest::newRow("ISO 8601 dates") << generateVectorFile(lineCount, false);
+    QTest::newRow("Epoch times") << generateVectorFile(lineCount, true);
+}
+
+void TestAmdaResultParser::testReadBenchmark()
+{
+    QFETCH(QByteArray, data);
+
+    auto results = std::unique_ptr<TimeSeries::ITimeSerie>{};
+    QBENCHMARK { results.reset(AmdaResultParser::readTxt(data, DataSeriesType::VECTOR)); }
+
+    auto serie = dynamic_cast<VectorTimeSerie *>(results.get());
+    QVERIFY(serie != nullptr);
+    QVERIFY(serie->size() == std::size_t{200000});
 }
 
 QTEST_MAIN(TestAmdaResultParser)
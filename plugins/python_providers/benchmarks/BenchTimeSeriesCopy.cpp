@@ -0,0 +1,88 @@
+#include <Data/ScalarTimeSerie.h>
+#include <Data/TimeSeriesUtils.h>
+#include <Data/VectorTimeSerie.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+// Benchmarks the copy of the series returned by the python providers, done for each request
+// (see PythonProvider::getData())
+
+namespace
+{
+
+/// Numbers of samples of the copied series
+const auto SERIE_SIZES = { 1 << 10, 1 << 16, 1 << 22 };
+
+std::shared_ptr<TimeSeries::ITimeSerie> makeScalarSerie(std::size_t size)
+{
+    auto serie = std::make_shared<ScalarTimeSerie>(size);
+    std::generate(std::begin(*serie), std::end(*serie), [i = 0.]() mutable {
+        auto t = i++;
+        return std::pair<double, double> { t, std::cos(t * 0.01) };
+    });
+    return serie;
+}
+
+std::shared_ptr<TimeSeries::ITimeSerie> makeVectorSerie(std::size_t size)
+{
+    auto serie = std::make_shared<VectorTimeSerie>(size);
+    std::generate(std::begin(*serie), std::end(*serie), [i = 0.]() mutable {
+        auto t = i++;
+        return std::pair<double, VectorTimeSerie::raw_value_type> { t,
+            { std::cos(t * 0.01), std::sin(t * 0.01), std::cos(t * 0.02) } };
+    });
+    return serie;
+}
+
+/**
+ * Copies a serie as the python providers do
+ * @param makeSerie the function generating the serie
+ * @param componentCount the number of values of a sample
+ */
+template <typename MakeSerie>
+void copySerie(benchmark::State& state, MakeSerie makeSerie, int componentCount)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto serie = makeSerie(size);
+    for (auto _ : state)
+    {
+        auto copy = std::unique_ptr<TimeSeries::ITimeSerie> { TimeSeriesUtils::copy(serie) };
+        benchmark::DoNotOptimize(copy.get());
+    }
+
+    // A point is a value copied, times excluded. Bytes include the times
+    auto points = static_cast<int64_t>(size) * componentCount;
+    auto bytes = static_cast<int64_t>(size * (componentCount + 1) * sizeof(double));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * bytes);
+    state.counters["points"] = benchmark::Counter {
+        static_cast<double>(state.iterations() * points), benchmark::Counter::kIsRate };
+}
+
+void BM_CopyScalar(benchmark::State& state)
+{
+    copySerie(state, makeScalarSerie, 1);
+}
+
+void BM_CopyVector(benchmark::State& state)
+{
+    copySerie(state, makeVectorSerie, 3);
+}
+
+void serieSizes(benchmark::internal::Benchmark* bench)
+{
+    for (auto size : SERIE_SIZES)
+    {
+        bench->Arg(size);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_CopyScalar)->Apply(serieSizes);
+BENCHMARK(BM_CopyVector)->Apply(serieSizes);
+
+BENCHMARK_MAIN();
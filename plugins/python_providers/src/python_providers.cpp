@@ -6,9 +6,11 @@
 #include <Data/SpectrogramTimeSerie.h>
 #include <Data/TimeSeriesUtils.h>
 #include <Data/VectorTimeSerie.h>
+#include <DataSource/CachedDataProvider.h>
 #include <DataSource/DataSourceController.h>
 #include <DataSource/DataSourceItem.h>
 #include <DataSource/DataSourceItemAction.h>
+#include <QCryptographicHash>
 #include <QDir>
 #include <QStandardPaths>
 #include <QStringList>
@@ -20,6 +22,10 @@
 
 const auto DATA_SOURCE_NAME = QStringLiteral("PythonProviders");
 
+/// Key of the metadata of a product holding its full path in the tree. It tells apart the products
+/// in the cache, and isn't passed to the python functions
+const auto PRODUCT_PATH_KEY = QStringLiteral("productPath");
+
 class PythonProvider : public IDataProvider
 {
 public:
@@ -35,8 +41,10 @@ public:
     {
         auto product = parameters.m_Data.value("PRODUCT", "").toString().toStdString();
         auto range = parameters.m_Range;
+        auto data = parameters.m_Data;
+        data.remove(PRODUCT_PATH_KEY);
         std::vector<std::tuple<std::string, std::string>> metadata;
-        std::transform(parameters.m_Data.constKeyValueBegin(), parameters.m_Data.constKeyValueEnd(),
+        std::transform(data.constKeyValueBegin(), data.constKeyValueEnd(),
             std::back_inserter(metadata), [](const auto& item) {
                 return std::tuple<std::string, std::string> { item.first.toStdString(),
                     item.second.toString().toStdString() };
@@ -148,14 +156,17 @@ void PythonProviders::register_product(
     QString test = DATA_SOURCE_NAME + QUuid::createUuid().toString();
     auto id = dataSourceController.registerDataSource(test);
     auto root = make_folder_item(test);
+    auto paths = QStringList {};
     std::for_each(std::cbegin(product_list), std::cend(product_list),
-        [id, f, root = root.get()](const auto& product) {
+        [id, f, root = root.get(), &paths](const auto& product) {
             const auto& path = std::get<0>(product);
+            paths.append(QString::fromStdString(path));
             auto path_list = QString::fromStdString(path).split('/', QString::SkipEmptyParts);
             auto name = *(std::cend(path_list) - 1);
             auto path_item
                 = make_path_items(std::cbegin(path_list), std::cend(path_list) - 1, root);
-            QVariantHash metaData { { DataSourceItem::NAME_DATA_KEY, name } };
+            QVariantHash metaData { { DataSourceItem::NAME_DATA_KEY, name },
+                { PRODUCT_PATH_KEY, QString::fromStdString(path) } };
             std::for_each(std::cbegin(std::get<2>(product)), std::cend(std::get<2>(product)),
                 [&metaData](const auto& mdata) {
                     metaData[QString::fromStdString(mdata.first)]
@@ -164,5 +175,14 @@ void PythonProviders::register_product(
             path_item->appendChild(make_product_item(metaData, id));
         });
     dataSourceController.setDataSourceItem(id, std::move(root));
-    dataSourceController.setDataProvider(id, std::make_unique<PythonProvider>(f));
+    // The name of the data source changes between sessions, so the cache identifies the provider
+    // by the products it registers, and the products by their path
+    paths.sort();
+    auto providerId = DATA_SOURCE_NAME + QLatin1Char { '/' }
+        + QString::fromLatin1(
+            QCryptographicHash::hash(paths.join(QLatin1Char { '\n' }).toUtf8(),
+                QCryptographicHash::Sha1)
+                .toHex());
+    dataSourceController.setDataProvider(id,
+        std::make_unique<CachedDataProvider>(providerId, std::make_shared<PythonProvider>(f)));
 }